@@ -11,7 +11,9 @@ import (
 	"github.com/go-errors/errors"
 	"github.com/integrii/flaggy"
 	"github.com/jesseduffield/lazydocker/pkg/app"
+	"github.com/jesseduffield/lazydocker/pkg/bench"
 	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/jesseduffield/lazydocker/pkg/profiling"
 	"github.com/jesseduffield/yaml"
 )
 
@@ -24,6 +26,10 @@ var (
 	configFlag    = false
 	debuggingFlag = false
 	composeFiles  []string
+
+	profilingOptions profiling.Options
+
+	benchOptions = bench.DefaultOptions()
 )
 
 func main() {
@@ -44,10 +50,39 @@ func main() {
 	flaggy.Bool(&configFlag, "c", "config", "Print the current default config")
 	flaggy.Bool(&debuggingFlag, "d", "debug", "a boolean")
 	flaggy.StringSlice(&composeFiles, "f", "file", "Specify alternate compose files")
+	flaggy.String(&profilingOptions.PprofAddr, "", "pprof-addr", "Serve pprof on a loopback address like localhost:6060, or a unix socket like unix:/tmp/lazydocker.sock")
+	flaggy.String(&profilingOptions.CPUProfile, "", "cpuprofile", "Write a CPU profile of the whole run to this file")
+	flaggy.String(&profilingOptions.MemProfile, "", "memprofile", "Write a heap profile to this file on exit")
+	flaggy.String(&profilingOptions.Trace, "", "trace", "Write an execution trace of the whole run to this file")
+	flaggy.String(&profilingOptions.Spans, "", "spans", "Write spans of what each refresh and render spends its time on to this file, in Chrome's trace event format")
 	flaggy.SetVersion(info)
 
+	benchCommand := flaggy.NewSubcommand("bench")
+	benchCommand.Description = "Drive lazydocker against a simulated daemon and report how responsive it was"
+	benchCommand.Int(&benchOptions.Simulator.Containers, "", "containers", "Number of simulated containers")
+	benchCommand.Int(&benchOptions.Simulator.Images, "", "images", "Number of simulated images")
+	benchCommand.Int(&benchOptions.Simulator.Volumes, "", "volumes", "Number of simulated volumes")
+	benchCommand.Duration(&benchOptions.Simulator.ChurnInterval, "", "churn", "How often a simulated container is replaced by a new one")
+	benchCommand.Int(&benchOptions.Simulator.LogLinesPerSecond, "", "log-rate", "Log lines per second from each simulated container")
+	benchCommand.Duration(&benchOptions.Simulator.Latency, "", "latency", "Delay before the simulated daemon answers each request")
+	benchCommand.Int64(&benchOptions.Simulator.Seed, "", "seed", "Seed for the simulated daemon's random numbers")
+	benchCommand.String(&benchOptions.DockerHost, "", "docker-host", "Run against this daemon rather than a simulated one")
+	benchCommand.String(&benchOptions.Script, "s", "script", "Script of keypresses and waits to run instead of the default one")
+	benchCommand.Int(&benchOptions.Width, "", "width", "Width of the terminal to run lazydocker in")
+	benchCommand.Int(&benchOptions.Height, "", "height", "Height of the terminal to run lazydocker in")
+	benchCommand.Duration(&benchOptions.KeyInterval, "", "key-interval", "How long to wait after each keypress's frame before the next")
+	benchCommand.Bool(&benchOptions.JSON, "", "json", "Report the results as JSON")
+	flaggy.AttachSubcommand(benchCommand, 1)
+
 	flaggy.Parse()
 
+	if benchCommand.Used {
+		if err := bench.Run(benchOptions, os.Stdout); err != nil {
+			log.Fatal(err.Error())
+		}
+		os.Exit(0)
+	}
+
 	if configFlag {
 		var buf bytes.Buffer
 		encoder := yaml.NewEncoder(&buf)
@@ -59,6 +94,12 @@ func main() {
 		os.Exit(0)
 	}
 
+	profiler, err := profiling.Start(profilingOptions)
+	if err != nil {
+		_ = profiler.Stop()
+		log.Fatal(err.Error())
+	}
+
 	projectDir, err := os.Getwd()
 	if err != nil {
 		log.Fatal(err.Error())
@@ -69,11 +110,15 @@ func main() {
 		log.Fatal(err.Error())
 	}
 
-	app, err := app.NewApp(appConfig)
+	app, err := app.NewApp(appConfig, profiler.Tracer)
 	if err == nil {
 		err = app.Run()
 	}
 
+	if profilerErr := profiler.Stop(); profilerErr != nil {
+		log.Println(profilerErr.Error())
+	}
+
 	if err != nil {
 		if errMessage, known := app.KnownError(err); known {
 			log.Println(errMessage)
@@ -9,6 +9,8 @@ import (
 	"github.com/jesseduffield/lazydocker/pkg/gui"
 	"github.com/jesseduffield/lazydocker/pkg/i18n"
 	"github.com/jesseduffield/lazydocker/pkg/log"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
 	"github.com/sirupsen/logrus"
 )
 
@@ -25,8 +27,9 @@ type App struct {
 	ErrorChan     chan error
 }
 
-// NewApp bootstrap a new application
-func NewApp(config *config.AppConfig) (*App, error) {
+// NewApp bootstrap a new application. tracer records spans of what we spend
+// our time on, and can be nil
+func NewApp(config *config.AppConfig, tracer *tracing.Tracer) (*App, error) {
 	app := &App{
 		closers:   []io.Closer{},
 		Config:    config,
@@ -36,6 +39,11 @@ func NewApp(config *config.AppConfig) (*App, error) {
 	app.Log = log.NewLogger(config, "23432119147a4367abf7c0de2aa99a2d")
 	app.Tr = i18n.NewTranslationSet(app.Log)
 	app.OSCommand = commands.NewOSCommand(app.Log, config)
+	// we only measure ourselves for the internals tab if it's switched on
+	if config.UserConfig.Gui.ShowInternals {
+		app.OSCommand.Metrics = metrics.New()
+	}
+	app.OSCommand.Tracer = tracer
 
 	// here is the place to make use of the docker-compose.yml file in the current directory
 
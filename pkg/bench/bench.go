@@ -0,0 +1,477 @@
+// Package bench drives a real lazydocker through a pseudo-terminal, against
+// the docker simulator or a daemon of your choosing, and reports how
+// responsive it was: how long each keypress took to show up on screen, how
+// long refreshes took, and what it cost in allocations, goroutines and memory.
+package bench
+
+import (
+	"encoding/json"
+	"fmt"
+	"io"
+	"io/ioutil"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"sort"
+	"sync"
+	"time"
+
+	"github.com/jesseduffield/lazydocker/pkg/dockersim"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+const (
+	// startupTimeout is how long we give lazydocker to draw its first frame
+	startupTimeout = 10 * time.Second
+
+	// settleTime is how long the screen has to stay still before we consider
+	// lazydocker to have finished starting up
+	settleTime = 500 * time.Millisecond
+
+	// frameTimeout is how long we wait for a keypress to change the screen.
+	// Some don't (e.g. pressing up at the top of a list)
+	frameTimeout = time.Second
+
+	// frameGap is how long the terminal has to go quiet for us to consider a
+	// frame finished. A frame is written in one go, but can arrive in a few
+	// reads
+	frameGap = 15 * time.Millisecond
+
+	// exitTimeout is how long we give lazydocker to quit at the end
+	exitTimeout = 10 * time.Second
+
+	// memorySampleInterval is how often we check lazydocker's resident memory
+	memorySampleInterval = 100 * time.Millisecond
+)
+
+// Options describe a benchmark run
+type Options struct {
+	// Simulator describes the fleet to simulate, unless DockerHost is set
+	Simulator dockersim.Options
+
+	// DockerHost is a daemon to run against instead of the simulator
+	DockerHost string
+
+	// Script is the path of the script to run, or empty for the default one
+	Script string
+
+	// Width and Height are the size of the terminal lazydocker runs in
+	Width  int
+	Height int
+
+	// KeyInterval is how long we wait after each frame before pressing the
+	// next key
+	KeyInterval time.Duration
+
+	// JSON reports the results as JSON rather than a table
+	JSON bool
+}
+
+// DefaultOptions returns a run against the simulator's default fleet in a
+// fairly large terminal
+func DefaultOptions() Options {
+	return Options{
+		Simulator:   dockersim.DefaultOptions(),
+		Width:       200,
+		Height:      50,
+		KeyInterval: 100 * time.Millisecond,
+	}
+}
+
+// Result is what we found out from a run
+type Result struct {
+	Startup    time.Duration
+	Duration   time.Duration
+	Keypresses int
+	// Latencies holds, for each keypress that changed the screen, how long it
+	// took from pressing the key until the new frame was on screen
+	Latencies       []time.Duration
+	PeakMemory      int64
+	FinalMemory     int64
+	Frames          int64
+	Mallocs         uint64
+	AllocatedBytes  uint64
+	GoroutinePeak   int64
+	RefreshDuration map[string][]time.Duration
+}
+
+// Run runs lazydocker through the script and writes out the results
+func Run(options Options, out io.Writer) error {
+	steps, err := loadScript(options.Script)
+	if err != nil {
+		return err
+	}
+
+	dir, err := ioutil.TempDir("", "lazydocker-bench")
+	if err != nil {
+		return err
+	}
+	defer os.RemoveAll(dir)
+
+	host := options.DockerHost
+	if host == "" {
+		sim := dockersim.New(options.Simulator)
+		if err := sim.Start(filepath.Join(dir, "docker.sock")); err != nil {
+			return err
+		}
+		defer sim.Close()
+		host = sim.Host()
+	}
+
+	result, err := run(options, steps, dir, host)
+	if err != nil {
+		return err
+	}
+
+	if options.JSON {
+		encoder := json.NewEncoder(out)
+		encoder.SetIndent("", "  ")
+		return encoder.Encode(result)
+	}
+	return writeResult(out, options, result)
+}
+
+// run starts lazydocker in a terminal of its own, in an empty directory so
+// that it doesn't pick up a compose project, and puts it through the steps
+func run(options Options, steps []step, dir string, host string) (*Result, error) {
+	master, slave, err := openTerminal(options.Width, options.Height)
+	if err != nil {
+		return nil, err
+	}
+	defer master.Close()
+
+	executable, err := os.Executable()
+	if err != nil {
+		slave.Close()
+		return nil, err
+	}
+
+	reportPath := filepath.Join(dir, "report.json")
+	cmd := exec.Command(executable)
+	cmd.Dir = dir
+	cmd.Env = append(os.Environ(), "DOCKER_HOST="+host, ReportEnvKey+"="+reportPath, "TERM=xterm-256color")
+	cmd.Stdin = slave
+	cmd.Stdout = slave
+	cmd.Stderr = slave
+	cmd.SysProcAttr = inNewSession()
+
+	start := time.Now()
+	err = cmd.Start()
+	slave.Close()
+	if err != nil {
+		return nil, err
+	}
+
+	exited := make(chan error, 1)
+	go func() {
+		exited <- cmd.Wait()
+	}()
+	memory := watchMemory(cmd.Process.Pid)
+	screen := watchScreen(master)
+
+	result := &Result{}
+	if err := screen.waitForStartup(); err != nil {
+		_ = cmd.Process.Kill()
+		return nil, err
+	}
+	result.Startup = screen.firstOutput.Sub(start)
+
+	for _, s := range steps {
+		if s.key == "" {
+			time.Sleep(s.wait)
+			continue
+		}
+		for i := 0; i < s.times; i++ {
+			latency, redrew, err := screen.press(s.key)
+			if err != nil {
+				_ = cmd.Process.Kill()
+				return nil, err
+			}
+			result.Keypresses++
+			if redrew {
+				result.Latencies = append(result.Latencies, latency)
+			}
+			time.Sleep(options.KeyInterval)
+		}
+	}
+
+	result.FinalMemory, result.PeakMemory = memory.current()
+	if _, err := master.Write([]byte("q")); err != nil {
+		return nil, err
+	}
+	select {
+	case <-exited:
+	case <-time.After(exitTimeout):
+		_ = cmd.Process.Kill()
+		return nil, fmt.Errorf("lazydocker didn't quit within %s", exitTimeout)
+	}
+	result.Duration = time.Since(start)
+
+	data, err := ioutil.ReadFile(reportPath)
+	if err != nil {
+		return nil, fmt.Errorf("lazydocker didn't write its report: %s", err)
+	}
+	report := processReport{}
+	if err := json.Unmarshal(data, &report); err != nil {
+		return nil, err
+	}
+	result.Frames = report.Frames
+	result.Mallocs = report.Mallocs
+	result.AllocatedBytes = report.AllocatedBytes
+	result.GoroutinePeak = report.GoroutinePeak
+	result.RefreshDuration = report.Refreshes
+
+	return result, nil
+}
+
+// screen is the other end of lazydocker's terminal. We don't parse what it
+// draws, we only note when it draws something
+type screen struct {
+	terminal    *os.File
+	output      chan time.Time
+	firstOutput time.Time
+
+	// tail is the end of what lazydocker wrote, so that if it quits on us we
+	// can show why
+	mutex sync.Mutex
+	tail  []byte
+}
+
+// tailSize is how much of lazydocker's output we hold on to
+const tailSize = 2048
+
+func watchScreen(terminal *os.File) *screen {
+	s := &screen{terminal: terminal, output: make(chan time.Time, 4096)}
+	go func() {
+		buffer := make([]byte, 32*1024)
+		for {
+			n, err := terminal.Read(buffer)
+			if n > 0 {
+				s.mutex.Lock()
+				s.tail = append(s.tail, buffer[:n]...)
+				if len(s.tail) > tailSize {
+					s.tail = s.tail[len(s.tail)-tailSize:]
+				}
+				s.mutex.Unlock()
+
+				select {
+				case s.output <- time.Now():
+				default:
+					// nobody's waiting on a frame, so nobody will miss this
+				}
+			}
+			// reading fails once lazydocker has quit
+			if err != nil {
+				close(s.output)
+				return
+			}
+		}
+	}()
+	return s
+}
+
+// quitError explains that lazydocker quit when we weren't expecting it to,
+// with the last thing it wrote
+func (s *screen) quitError() error {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	return fmt.Errorf("lazydocker quit unexpectedly:\n%s", utils.Decolorise(string(s.tail)))
+}
+
+// waitForStartup waits for the first frame, then for the screen to settle
+// while lazydocker fetches everything for the first time
+func (s *screen) waitForStartup() error {
+	select {
+	case at, ok := <-s.output:
+		if !ok {
+			return s.quitError()
+		}
+		s.firstOutput = at
+	case <-time.After(startupTimeout):
+		return fmt.Errorf("lazydocker didn't draw anything within %s", startupTimeout)
+	}
+
+	deadline := time.After(startupTimeout)
+	for {
+		select {
+		case _, ok := <-s.output:
+			if !ok {
+				return s.quitError()
+			}
+		case <-time.After(settleTime):
+			return nil
+		case <-deadline:
+			// it's never going to be still, e.g. because of churn
+			return nil
+		}
+	}
+}
+
+// press presses a key and waits for the frame it causes, returning how long
+// the frame took to arrive in full, and whether there was one at all
+func (s *screen) press(key string) (time.Duration, bool, error) {
+	// anything already on its way was drawn before we pressed the key
+	for drained := false; !drained; {
+		select {
+		case _, ok := <-s.output:
+			if !ok {
+				return 0, false, s.quitError()
+			}
+		default:
+			drained = true
+		}
+	}
+
+	pressed := time.Now()
+	if _, err := s.terminal.Write([]byte(key)); err != nil {
+		return 0, false, err
+	}
+
+	var last time.Time
+	select {
+	case at, ok := <-s.output:
+		if !ok {
+			return 0, false, s.quitError()
+		}
+		last = at
+	case <-time.After(frameTimeout):
+		return 0, false, nil
+	}
+
+	// if something else keeps the screen busy (e.g. following logs), we may
+	// never see a gap, so we give up on the frame ending at some point
+	deadline := time.After(frameTimeout)
+	for {
+		select {
+		case <-deadline:
+			return last.Sub(pressed), true, nil
+		case at, ok := <-s.output:
+			if !ok {
+				return last.Sub(pressed), true, nil
+			}
+			last = at
+		case <-time.After(frameGap):
+			return last.Sub(pressed), true, nil
+		}
+	}
+}
+
+// memoryWatcher samples a process's resident memory until it exits
+type memoryWatcher struct {
+	mutex  sync.Mutex
+	latest int64
+	peak   int64
+}
+
+func watchMemory(pid int) *memoryWatcher {
+	w := &memoryWatcher{}
+	go func() {
+		ticker := time.NewTicker(memorySampleInterval)
+		defer ticker.Stop()
+		for range ticker.C {
+			bytes, err := residentMemory(pid)
+			if err != nil {
+				// the process has gone
+				return
+			}
+			w.mutex.Lock()
+			w.latest = bytes
+			if bytes > w.peak {
+				w.peak = bytes
+			}
+			w.mutex.Unlock()
+		}
+	}()
+	return w
+}
+
+// current returns the latest and peak resident memory
+func (w *memoryWatcher) current() (int64, int64) {
+	w.mutex.Lock()
+	defer w.mutex.Unlock()
+	return w.latest, w.peak
+}
+
+// percentiles returns the given percentiles of the durations, by nearest rank
+func percentiles(durations []time.Duration, ps ...float64) []time.Duration {
+	sorted := append([]time.Duration{}, durations...)
+	sort.Slice(sorted, func(i, j int) bool { return sorted[i] < sorted[j] })
+
+	result := make([]time.Duration, len(ps))
+	if len(sorted) == 0 {
+		return result
+	}
+	for i, p := range ps {
+		rank := int(p/100*float64(len(sorted))+0.5) - 1
+		if rank < 0 {
+			rank = 0
+		}
+		if rank >= len(sorted) {
+			rank = len(sorted) - 1
+		}
+		result[i] = sorted[rank]
+	}
+	return result
+}
+
+// latencyRow returns a table row with the count and percentiles of durations
+func latencyRow(name string, durations []time.Duration) []string {
+	row := []string{name, fmt.Sprint(len(durations))}
+	for _, p := range percentiles(durations, 50, 90, 99, 100) {
+		row = append(row, utils.FormatMilliseconds(p))
+	}
+	return row
+}
+
+func writeResult(out io.Writer, options Options, result *Result) error {
+	target := options.DockerHost
+	if target == "" {
+		sim := options.Simulator
+		target = fmt.Sprintf("%d simulated containers, churn every %s, %s latency", sim.Containers, sim.ChurnInterval, sim.Latency)
+	}
+	fmt.Fprintf(out, "%s: %d keypresses in %s\n\n", target, result.Keypresses, result.Duration.Round(time.Millisecond))
+
+	latencies := [][]string{
+		{"", "count", "p50", "p90", "p99", "max"},
+		latencyRow("keypress to frame", result.Latencies),
+	}
+	names := []string{}
+	for name := range result.RefreshDuration {
+		names = append(names, name)
+	}
+	sort.Strings(names)
+	for _, name := range names {
+		latencies = append(latencies, latencyRow(name, result.RefreshDuration[name]))
+	}
+	table, err := utils.RenderTable(latencies)
+	if err != nil {
+		return err
+	}
+	fmt.Fprintln(out, table)
+	fmt.Fprintln(out)
+
+	perFrame := func(n uint64) uint64 {
+		if result.Frames == 0 {
+			return 0
+		}
+		return n / uint64(result.Frames)
+	}
+	frameRate := float64(result.Frames) / result.Duration.Seconds()
+	totals, err := utils.RenderTable([][]string{
+		{"first frame after", utils.FormatMilliseconds(result.Startup)},
+		{"frames", fmt.Sprintf("%d (%.1f/s)", result.Frames, frameRate)},
+		{"allocations per frame", fmt.Sprintf("%d (%s)", perFrame(result.Mallocs), utils.FormatBinaryBytes(int(perFrame(result.AllocatedBytes))))},
+		{"peak goroutines", fmt.Sprint(result.GoroutinePeak)},
+		{"resident memory", fmt.Sprintf("%s at the end, %s at peak", utils.FormatBinaryBytes(int(result.FinalMemory)), utils.FormatBinaryBytes(int(result.PeakMemory)))},
+	})
+	if err != nil {
+		return err
+	}
+	fmt.Fprintln(out, totals)
+
+	if len(result.Latencies) < result.Keypresses {
+		fmt.Fprintf(out, "\n%d keypresses didn't change the screen within %s, so they aren't in the latencies\n", result.Keypresses-len(result.Latencies), frameTimeout)
+	}
+	return nil
+}
@@ -0,0 +1,89 @@
+package bench
+
+import (
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestParseScript is a function.
+func TestParseScript(t *testing.T) {
+	type scenario struct {
+		script               string
+		expected             []step
+		expectedErrorMessage string
+	}
+
+	scenarios := []scenario{
+		{
+			"",
+			[]step{},
+			"",
+		},
+		{
+			"# just looking\n\nkey down 3\nkey ]\nwait 2s\n",
+			[]step{
+				{key: "\x1bOB", times: 3},
+				{key: "]", times: 1},
+				{wait: 2 * time.Second},
+			},
+			"",
+		},
+		{
+			"key down\nkey up 0\n",
+			nil,
+			`line 2: can't press a key "0" times`,
+		},
+		{
+			"wait\n",
+			nil,
+			"line 1: expected 'wait <duration>'",
+		},
+		{
+			"press enter\n",
+			nil,
+			`line 1: unknown step "press"`,
+		},
+	}
+
+	for _, s := range scenarios {
+		steps, err := parseScript(s.script)
+		if s.expectedErrorMessage != "" {
+			assert.EqualError(t, err, s.expectedErrorMessage)
+			continue
+		}
+		assert.NoError(t, err)
+		assert.EqualValues(t, s.expected, steps)
+	}
+
+	_, err := parseScript(defaultScript)
+	assert.NoError(t, err)
+}
+
+// TestPercentiles is a function.
+func TestPercentiles(t *testing.T) {
+	type scenario struct {
+		durations []time.Duration
+		expected  []time.Duration
+	}
+
+	scenarios := []scenario{
+		{
+			[]time.Duration{},
+			[]time.Duration{0, 0, 0},
+		},
+		{
+			[]time.Duration{5},
+			[]time.Duration{5, 5, 5},
+		},
+		{
+			[]time.Duration{10, 2, 8, 4, 6, 1, 3, 5, 7, 9},
+			[]time.Duration{5, 9, 10},
+		},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, percentiles(s.durations, 50, 90, 100))
+	}
+}
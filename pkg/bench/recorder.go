@@ -0,0 +1,135 @@
+package bench
+
+import (
+	"encoding/json"
+	"io/ioutil"
+	"os"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// ReportEnvKey is how `lazydocker bench` tells the lazydocker it drives where
+// to write its report. It's not set outside of a benchmark run
+const ReportEnvKey = "LAZYDOCKER_BENCH_REPORT"
+
+// goroutineSampleInterval is how often we count goroutines to find the peak
+const goroutineSampleInterval = 50 * time.Millisecond
+
+// processReport is what lazydocker writes about itself at the end of a
+// benchmark run. These are the things the driving process can't see from the
+// outside
+type processReport struct {
+	Duration       time.Duration
+	Frames         int64
+	Mallocs        uint64
+	AllocatedBytes uint64
+	GoroutinePeak  int64
+	Refreshes      map[string][]time.Duration
+}
+
+// Recorder collects numbers about lazydocker while a benchmark drives it. A nil
+// Recorder records nothing, so callers don't need to check whether we're
+// being benchmarked
+type Recorder struct {
+	path         string
+	start        time.Time
+	startMallocs uint64
+	startBytes   uint64
+	stop         chan struct{}
+
+	frames        int64
+	goroutinePeak int64
+
+	mutex     sync.Mutex
+	refreshes map[string][]time.Duration
+}
+
+// RecorderFromEnv returns a recorder if we're being benchmarked, and nil
+// otherwise
+func RecorderFromEnv() *Recorder {
+	path := os.Getenv(ReportEnvKey)
+	if path == "" {
+		return nil
+	}
+
+	memStats := runtime.MemStats{}
+	runtime.ReadMemStats(&memStats)
+
+	r := &Recorder{
+		path:         path,
+		start:        time.Now(),
+		startMallocs: memStats.Mallocs,
+		startBytes:   memStats.TotalAlloc,
+		stop:         make(chan struct{}),
+		refreshes:    map[string][]time.Duration{},
+	}
+	go r.sampleGoroutines()
+	return r
+}
+
+func (r *Recorder) sampleGoroutines() {
+	ticker := time.NewTicker(goroutineSampleInterval)
+	defer ticker.Stop()
+
+	for {
+		count := int64(runtime.NumGoroutine())
+		if count > atomic.LoadInt64(&r.goroutinePeak) {
+			atomic.StoreInt64(&r.goroutinePeak, count)
+		}
+
+		select {
+		case <-r.stop:
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+// Frame records that we've drawn a frame
+func (r *Recorder) Frame() {
+	if r == nil {
+		return
+	}
+	atomic.AddInt64(&r.frames, 1)
+}
+
+// Refresh records how long one of our periodic refreshes took
+func (r *Recorder) Refresh(name string, took time.Duration) {
+	if r == nil {
+		return
+	}
+	r.mutex.Lock()
+	defer r.mutex.Unlock()
+
+	r.refreshes[name] = append(r.refreshes[name], took)
+}
+
+// Write writes out what we've recorded for the benchmark to pick up
+func (r *Recorder) Write() error {
+	if r == nil {
+		return nil
+	}
+	close(r.stop)
+
+	memStats := runtime.MemStats{}
+	runtime.ReadMemStats(&memStats)
+
+	r.mutex.Lock()
+	report := processReport{
+		Duration:       time.Since(r.start),
+		Frames:         atomic.LoadInt64(&r.frames),
+		Mallocs:        memStats.Mallocs - r.startMallocs,
+		AllocatedBytes: memStats.TotalAlloc - r.startBytes,
+		GoroutinePeak:  atomic.LoadInt64(&r.goroutinePeak),
+		Refreshes:      r.refreshes,
+	}
+	data, err := json.Marshal(report)
+	r.mutex.Unlock()
+	if err != nil {
+		return err
+	}
+
+	return ioutil.WriteFile(r.path, data, 0644)
+}
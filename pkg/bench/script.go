@@ -0,0 +1,127 @@
+package bench
+
+import (
+	"fmt"
+	"io/ioutil"
+	"strconv"
+	"strings"
+	"time"
+)
+
+// A script is what we do to lazydocker during a benchmark, one step per line:
+//
+//	key <name> [times]   press a key, e.g. 'key down 20' or 'key ]'
+//	wait <duration>      leave lazydocker to it, e.g. to follow some logs
+//
+// Lines starting with '#' are comments
+type step struct {
+	key   string
+	times int
+	wait  time.Duration
+}
+
+// keys are the escape sequences an xterm sends for the named keys. The arrow
+// keys are in the application mode termbox switches the terminal to. Any other
+// key name is sent as is, so 'key ]' presses ']'
+var keys = map[string]string{
+	"up":     "\x1bOA",
+	"down":   "\x1bOB",
+	"right":  "\x1bOC",
+	"left":   "\x1bOD",
+	"pgup":   "\x1b[5~",
+	"pgdown": "\x1b[6~",
+	"enter":  "\r",
+	"esc":    "\x1b",
+	"tab":    "\t",
+	"space":  " ",
+}
+
+// defaultScript looks around the way someone might when they first open
+// lazydocker on a busy host
+const defaultScript = `
+# walk down the containers list and back up, rendering each one's logs
+key right
+key down 20
+key up 20
+
+# flick through the selected container's tabs and back to its logs
+key ] 4
+key [ 4
+
+# follow its logs for a while
+wait 3s
+
+# look through the images and volumes
+key right
+key down 10
+key right
+key down 10
+key left 2
+
+# and the project panel's tabs
+key left
+key ] 4
+key [ 4
+`
+
+// loadScript reads the script at path, or returns the default script if path
+// is empty
+func loadScript(path string) ([]step, error) {
+	if path == "" {
+		return parseScript(defaultScript)
+	}
+	data, err := ioutil.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	return parseScript(string(data))
+}
+
+func parseScript(script string) ([]step, error) {
+	steps := []step{}
+	for i, line := range strings.Split(script, "\n") {
+		fields := strings.Fields(line)
+		if len(fields) == 0 || strings.HasPrefix(fields[0], "#") {
+			continue
+		}
+
+		s, err := parseStep(fields)
+		if err != nil {
+			return nil, fmt.Errorf("line %d: %s", i+1, err)
+		}
+		steps = append(steps, s)
+	}
+	return steps, nil
+}
+
+func parseStep(fields []string) (step, error) {
+	switch fields[0] {
+	case "key":
+		if len(fields) < 2 || len(fields) > 3 {
+			return step{}, fmt.Errorf("expected 'key <name> [times]'")
+		}
+		s := step{key: fields[1], times: 1}
+		if sequence, ok := keys[fields[1]]; ok {
+			s.key = sequence
+		}
+		if len(fields) == 3 {
+			times, err := strconv.Atoi(fields[2])
+			if err != nil || times < 1 {
+				return step{}, fmt.Errorf("can't press a key %q times", fields[2])
+			}
+			s.times = times
+		}
+		return s, nil
+	case "wait":
+		if len(fields) != 2 {
+			return step{}, fmt.Errorf("expected 'wait <duration>'")
+		}
+		wait, err := time.ParseDuration(fields[1])
+		if err != nil {
+			return step{}, err
+		}
+		return step{wait: wait}, nil
+	default:
+		return step{}, fmt.Errorf("unknown step %q", fields[0])
+	}
+}
@@ -0,0 +1,24 @@
+//go:build !linux
+// +build !linux
+
+package bench
+
+import (
+	"errors"
+	"os"
+	"syscall"
+)
+
+var errUnsupported = errors.New("lazydocker bench needs the pseudo-terminals and /proc of linux")
+
+func openTerminal(width int, height int) (*os.File, *os.File, error) {
+	return nil, nil, errUnsupported
+}
+
+func inNewSession() *syscall.SysProcAttr {
+	return nil
+}
+
+func residentMemory(pid int) (int64, error) {
+	return 0, errUnsupported
+}
@@ -1,7 +1,6 @@
 package commands
 
 import (
-	"context"
 	"fmt"
 	"os/exec"
 	"strconv"
@@ -34,6 +33,7 @@ type Container struct {
 	ID              string
 	Container       types.Container
 	DisplayString   string
+	Endpoint        *Endpoint
 	Client          *client.Client
 	OSCommand       *OSCommand
 	Config          *config.AppConfig
@@ -251,7 +251,25 @@ type ContainerCliStat struct {
 func (c *Container) GetDisplayStrings(isFocused bool) []string {
 	image := strings.TrimPrefix(c.Container.Image, "sha256:")
 
-	return []string{c.GetDisplayStatus(), c.GetDisplaySubstatus(), c.Name, c.GetDisplayCPUPerc(), utils.ColoredString(image, color.FgMagenta)}
+	return []string{c.GetDisplayStatus(), c.GetDisplaySubstatus(), c.Endpoint.Qualify(c.Name), c.GetDisplayCPUPerc(), utils.ColoredString(image, color.FgMagenta)}
+}
+
+// QualifiedID is the container's ID with its endpoint's prefix, which tells it
+// apart from a container with the same ID on another daemon
+func (c *Container) QualifiedID() string {
+	return c.Endpoint.Qualify(c.ID)
+}
+
+// SearchKey identifies the container and what SearchRow is built from, which
+// is all fixed when the container's created apart from its name
+func (c *Container) SearchKey() string {
+	return c.QualifiedID() + " " + c.Name
+}
+
+// SearchRow returns what we match against when the containers panel is
+// filtered: the container's name, image, service and labels
+func (c *Container) SearchRow() utils.SearchRow {
+	return utils.NewSearchRow([]string{c.Endpoint.Qualify(c.Name), c.Container.Image, c.ServiceName}, c.Container.Labels)
 }
 
 // GetDisplayStatus returns the colored status of the container
@@ -291,13 +309,8 @@ func (c *Container) getHealthStatus() string {
 func (c *Container) GetDisplayCPUPerc() string {
 	stats := c.CLIStats
 
-	if stats.CPUPerc == "" {
-		return ""
-	}
-
-	percentage, err := strconv.ParseFloat(strings.TrimSuffix(stats.CPUPerc, "%"), 32)
-	if err != nil {
-		// probably complaining about not being able to convert '--'
+	percentage, ok := c.CPUPercentage()
+	if !ok {
 		return ""
 	}
 
@@ -313,6 +326,31 @@ func (c *Container) GetDisplayCPUPerc() string {
 	return utils.ColoredString(stats.CPUPerc, clr)
 }
 
+// CPUPercentage returns the container's CPU usage as of the last time we got
+// its stats, or false if we don't have any
+func (c *Container) CPUPercentage() (float64, bool) {
+	return parsePercentage(c.CLIStats.CPUPerc)
+}
+
+// MemoryPercentage returns the container's memory usage as of the last time we
+// got its stats, or false if we don't have any
+func (c *Container) MemoryPercentage() (float64, bool) {
+	return parsePercentage(c.CLIStats.MemPerc)
+}
+
+func parsePercentage(value string) (float64, bool) {
+	if value == "" {
+		return 0, false
+	}
+
+	percentage, err := strconv.ParseFloat(strings.TrimSuffix(value, "%"), 64)
+	if err != nil {
+		// probably complaining about not being able to convert '--'
+		return 0, false
+	}
+	return percentage, true
+}
+
 // ProducingLogs tells us whether we should bother checking a container's logs
 func (c *Container) ProducingLogs() bool {
 	return c.Container.State == "running" && !(c.Details.HostConfig.LogConfig.Type == "none")
@@ -346,7 +384,7 @@ func (c *Container) GetColor() color.Attribute {
 // Remove removes the container
 func (c *Container) Remove(options types.ContainerRemoveOptions) error {
 	c.Log.Warn(fmt.Sprintf("removing container %s", c.Name))
-	if err := c.Client.ContainerRemove(context.Background(), c.ID, options); err != nil {
+	if err := c.Client.ContainerRemove(c.Endpoint.Context(), c.ID, options); err != nil {
 		if strings.Contains(err.Error(), "Stop the container before attempting removal or force remove") {
 			return ComplexError{
 				Code:    MustStopContainer,
@@ -363,45 +401,38 @@ func (c *Container) Remove(options types.ContainerRemoveOptions) error {
 // Stop stops the container
 func (c *Container) Stop() error {
 	c.Log.Warn(fmt.Sprintf("stopping container %s", c.Name))
-	return c.Client.ContainerStop(context.Background(), c.ID, nil)
+	return c.Client.ContainerStop(c.Endpoint.Context(), c.ID, nil)
 }
 
 // Restart restarts the container
 func (c *Container) Restart() error {
 	c.Log.Warn(fmt.Sprintf("restarting container %s", c.Name))
-	return c.Client.ContainerRestart(context.Background(), c.ID, nil)
+	return c.Client.ContainerRestart(c.Endpoint.Context(), c.ID, nil)
 }
 
-// Attach attaches the container
-func (c *Container) Attach() (*exec.Cmd, error) {
-	c.Log.Warn(fmt.Sprintf("attaching to container %s", c.Name))
-
-	// verify that we can in fact attach to this container
+// checkAttachable verifies that we can in fact attach to this container
+func (c *Container) checkAttachable() error {
 	if !c.Details.Config.OpenStdin {
-		return nil, errors.New(c.Tr.UnattachableContainerError)
+		return errors.New(c.Tr.UnattachableContainerError)
 	}
 
 	if c.Container.State == "exited" {
-		return nil, errors.New(c.Tr.CannotAttachStoppedContainerError)
+		return errors.New(c.Tr.CannotAttachStoppedContainerError)
 	}
 
-	cmd := c.OSCommand.PrepareSubProcess("docker", "attach", "--sig-proxy=false", c.ID)
-	return cmd, nil
+	return nil
 }
 
 // Top returns process information
 func (c *Container) Top() (container.ContainerTopOKBody, error) {
-	detail, err := c.Inspect()
-	if err != nil {
-		return container.ContainerTopOKBody{}, err
-	}
-
-	// check container status
-	if !detail.State.Running {
+	// we go by the state from our last refresh rather than inspecting the
+	// container first, which would double the round trips. If it's stopped
+	// since then, the daemon tells us so anyway
+	if c.Container.State != "running" {
 		return container.ContainerTopOKBody{}, errors.New("container is not running")
 	}
 
-	return c.Client.ContainerTop(context.Background(), c.ID, []string{})
+	return c.Client.ContainerTop(c.Endpoint.Context(), c.ID, []string{})
 }
 
 // EraseOldHistory removes any history before the user-specified max duration
@@ -426,21 +457,23 @@ func (c *Container) ViewLogs() (*exec.Cmd, error) {
 		c.DockerCommand.NewCommandObject(CommandObject{Container: c}),
 	)
 
-	cmd := c.OSCommand.ExecutableFromString(command)
+	cmd := c.Endpoint.Prepare(c.OSCommand.ExecutableFromString(command))
 	c.OSCommand.PrepareForChildren(cmd)
 
 	return cmd, nil
 }
 
-// PruneContainers prunes containers
+// PruneContainers prunes containers on every endpoint
 func (c *DockerCommand) PruneContainers() error {
-	_, err := c.Client.ContainersPrune(context.Background(), filters.Args{})
-	return err
+	return onEveryEndpoint(c.Endpoints, func(endpoint *Endpoint) error {
+		_, err := endpoint.Client.ContainersPrune(endpoint.Context(), filters.Args{})
+		return err
+	})
 }
 
 // Inspect returns details about the container
 func (c *Container) Inspect() (types.ContainerJSON, error) {
-	return c.Client.ContainerInspect(context.Background(), c.ID)
+	return c.Client.ContainerInspect(c.Endpoint.Context(), c.ID)
 }
 
 // RenderTop returns details about the container
@@ -0,0 +1,150 @@
+package commands
+
+import (
+	"sort"
+	"time"
+)
+
+// Ways of sorting containers. By default we keep the order the daemon gives us
+const (
+	ContainerSortDefault  = ""
+	ContainerSortName     = "name"
+	ContainerSortCPU      = "cpu"
+	ContainerSortMemory   = "memory"
+	ContainerSortNetwork  = "network"
+	ContainerSortUptime   = "uptime"
+	ContainerSortRestarts = "restarts"
+)
+
+// incrementalSortLimit is how many containers can be out of place before we
+// give up on moving them one at a time and sort the whole list again
+const incrementalSortLimit = 32
+
+type sortedContainer struct {
+	container *Container
+	// value is what we're sorting by, biggest first. It's -1 if we don't know
+	// it, e.g. because we don't have any stats for the container yet
+	value float64
+}
+
+// SortContainers returns the containers sorted by sortBy, with the name sorted
+// alphabetically and everything else biggest first. previous is the order we
+// last sorted the containers into: we start from that, so that containers
+// whose stats haven't moved them stay where they were and ties keep their
+// order. Usually only a few containers are out of place after a stats update,
+// so we move just those ones rather than sorting the whole list again
+func SortContainers(containers []*Container, previous []*Container, sortBy string) []*Container {
+	if sortBy == ContainerSortDefault {
+		return containers
+	}
+
+	present := make(map[string]*Container, len(containers))
+	for _, container := range containers {
+		present[container.ID] = container
+	}
+
+	// previous may hold stale copies of containers, so we take each container
+	// from the current list, in the previous order, followed by any new ones
+	entries := make([]sortedContainer, 0, len(containers))
+	for _, container := range previous {
+		if current, ok := present[container.ID]; ok {
+			entries = append(entries, sortedContainer{container: current, value: containerSortValue(current, sortBy)})
+			delete(present, container.ID)
+		}
+	}
+	for _, container := range containers {
+		if _, ok := present[container.ID]; ok {
+			entries = append(entries, sortedContainer{container: container, value: containerSortValue(container, sortBy)})
+		}
+	}
+
+	less := func(a, b sortedContainer) bool {
+		if sortBy == ContainerSortName {
+			return a.container.Name < b.container.Name
+		}
+		return a.value > b.value
+	}
+
+	outOfPlace := 0
+	for i := 1; i < len(entries); i++ {
+		if less(entries[i], entries[i-1]) {
+			outOfPlace++
+		}
+	}
+
+	if outOfPlace > incrementalSortLimit {
+		sort.SliceStable(entries, func(a, b int) bool { return less(entries[a], entries[b]) })
+	} else if outOfPlace > 0 {
+		// an insertion sort only has to move the containers that are out of place
+		for i := 1; i < len(entries); i++ {
+			entry := entries[i]
+			j := i
+			for ; j > 0 && less(entry, entries[j-1]); j-- {
+				entries[j] = entries[j-1]
+			}
+			entries[j] = entry
+		}
+	}
+
+	sorted := make([]*Container, len(entries))
+	for i, entry := range entries {
+		sorted[i] = entry.container
+	}
+	return sorted
+}
+
+func containerSortValue(container *Container, sortBy string) float64 {
+	var value float64
+	var ok bool
+
+	switch sortBy {
+	case ContainerSortCPU:
+		value, ok = container.CPUPercentage()
+	case ContainerSortMemory:
+		value, ok = container.MemoryPercentage()
+	case ContainerSortNetwork:
+		value, ok = container.NetworkRate()
+	case ContainerSortUptime:
+		value, ok = container.Uptime()
+	case ContainerSortRestarts:
+		value, ok = float64(container.Details.RestartCount), true
+	}
+
+	if !ok {
+		return -1
+	}
+	return value
+}
+
+// NetworkRate returns how many bytes per second the container sent and
+// received between its last two stats readings, or false if we don't have two
+// readings yet. The counters start again from zero when the container
+// restarts, so if they've gone down we don't have a reading either
+func (c *Container) NetworkRate() (float64, bool) {
+	history := c.StatHistory
+	if len(history) < 2 {
+		return 0, false
+	}
+
+	last, previous := history[len(history)-1], history[len(history)-2]
+	seconds := last.RecordedAt.Sub(previous.RecordedAt).Seconds()
+	if seconds <= 0 {
+		return 0, false
+	}
+
+	lastBytes := last.ClientStats.Networks.Eth0.RxBytes + last.ClientStats.Networks.Eth0.TxBytes
+	previousBytes := previous.ClientStats.Networks.Eth0.RxBytes + previous.ClientStats.Networks.Eth0.TxBytes
+	if lastBytes < previousBytes {
+		return 0, false
+	}
+	return float64(lastBytes-previousBytes) / seconds, true
+}
+
+// Uptime returns how many seconds the container has been running for, or
+// false if it isn't running
+func (c *Container) Uptime() (float64, bool) {
+	if c.Container.State != "running" || c.Details.State.StartedAt.IsZero() {
+		return 0, false
+	}
+	return time.Since(c.Details.State.StartedAt).Seconds(), true
+}
@@ -0,0 +1,101 @@
+package commands
+
+import (
+	"fmt"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func newSortableContainer(id string, cpu string) *Container {
+	return &Container{ID: id, Name: "container-" + id, CLIStats: ContainerCliStat{CPUPerc: cpu}}
+}
+
+// newNetworkContainer returns a container whose last two stats readings, a
+// second apart, had sent and received the given numbers of bytes
+func newNetworkContainer(id string, previousBytes int, lastBytes int) *Container {
+	container := newSortableContainer(id, "")
+	at := time.Now()
+	for i, bytes := range []int{previousBytes, lastBytes} {
+		stats := RecordedStats{RecordedAt: at.Add(time.Duration(i) * time.Second)}
+		stats.ClientStats.Networks.Eth0.RxBytes = bytes
+		container.StatHistory = append(container.StatHistory, stats)
+	}
+	return container
+}
+
+func containerIDs(containers []*Container) []string {
+	ids := make([]string, len(containers))
+	for i, container := range containers {
+		ids[i] = container.ID
+	}
+	return ids
+}
+
+// TestSortContainers is a function.
+func TestSortContainers(t *testing.T) {
+	type scenario struct {
+		description string
+		containers  []*Container
+		previous    []*Container
+		sortBy      string
+		expected    []string
+	}
+
+	scenarios := []scenario{
+		{
+			"the default keeps the daemon's order",
+			[]*Container{newSortableContainer("a", "1%"), newSortableContainer("b", "9%")},
+			nil,
+			ContainerSortDefault,
+			[]string{"a", "b"},
+		},
+		{
+			"busiest first, with containers we have no stats for at the end",
+			[]*Container{newSortableContainer("a", "--"), newSortableContainer("b", "9%"), newSortableContainer("c", "30%")},
+			nil,
+			ContainerSortCPU,
+			[]string{"c", "b", "a"},
+		},
+		{
+			"ties keep their previous order, and new containers slot in",
+			[]*Container{newSortableContainer("a", "5%"), newSortableContainer("b", "5%"), newSortableContainer("c", "7%"), newSortableContainer("d", "6%")},
+			[]*Container{newSortableContainer("c", "0%"), newSortableContainer("gone", "0%"), newSortableContainer("b", "0%"), newSortableContainer("a", "0%")},
+			ContainerSortCPU,
+			[]string{"c", "d", "b", "a"},
+		},
+		{
+			"a container whose counters reset on restart sorts with those we have no stats for",
+			[]*Container{newNetworkContainer("restarted", 5000, 10), newSortableContainer("new", ""), newNetworkContainer("quiet", 100, 100), newNetworkContainer("busy", 100, 900)},
+			nil,
+			ContainerSortNetwork,
+			[]string{"busy", "quiet", "restarted", "new"},
+		},
+		{
+			"names sort alphabetically",
+			[]*Container{newSortableContainer("b", ""), newSortableContainer("a", "")},
+			nil,
+			ContainerSortName,
+			[]string{"a", "b"},
+		},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, containerIDs(SortContainers(s.containers, s.previous, s.sortBy)), s.description)
+	}
+}
+
+// TestSortContainersManyOutOfPlace is a function.
+func TestSortContainersManyOutOfPlace(t *testing.T) {
+	// every container is out of place, which is past our limit for moving
+	// them one at a time
+	containers := []*Container{}
+	expected := []string{}
+	for i := 0; i < incrementalSortLimit*3; i++ {
+		containers = append(containers, newSortableContainer(fmt.Sprintf("%03d", i), fmt.Sprintf("%d%%", i)))
+		expected = append([]string{fmt.Sprintf("%03d", i)}, expected...)
+	}
+
+	assert.EqualValues(t, expected, containerIDs(SortContainers(containers, containers, ContainerSortCPU)))
+}
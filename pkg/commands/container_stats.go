@@ -144,6 +144,22 @@ type ContainerStats struct {
 	} `json:"networks"`
 }
 
+// recordStats decodes a frame from a container's stats stream and works out
+// our derived stats from it
+func recordStats(data []byte) RecordedStats {
+	var stats ContainerStats
+	json.Unmarshal(data, &stats)
+
+	return RecordedStats{
+		ClientStats: stats,
+		DerivedStats: DerivedStats{
+			CPUPercentage:    stats.CalculateContainerCPUPercentage(),
+			MemoryPercentage: stats.CalculateContainerMemoryUsage(),
+		},
+		RecordedAt: time.Now(),
+	}
+}
+
 // CalculateContainerCPUPercentage calculates the cpu usage of the container as a percent of total CPU usage
 // to calculate CPU usage, we take the increase in CPU time from the container since the last poll, divide that by the total increase in CPU time since the last poll, times by the number of cores, and times by 100 to get a percentage
 // I'm not entirely sure why we need to multiply by the number of cores, but the numbers work
@@ -0,0 +1,72 @@
+package commands
+
+import (
+	"bytes"
+	"fmt"
+	"io/ioutil"
+	"testing"
+	"time"
+
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/stretchr/testify/assert"
+)
+
+// recordedFrames returns the frames of a stats stream we recorded from a
+// running container
+func recordedFrames(t testing.TB) [][]byte {
+	data, err := ioutil.ReadFile("testdata/stats.jsonl")
+	if err != nil {
+		t.Fatal(err)
+	}
+	return bytes.Split(bytes.TrimSpace(data), []byte("\n"))
+}
+
+// TestRecordStats is a function.
+func TestRecordStats(t *testing.T) {
+	stats := recordStats(recordedFrames(t)[0])
+
+	assert.EqualValues(t, 12, stats.ClientStats.PidsStats.Current)
+	assert.EqualValues(t, 115348, stats.ClientStats.Networks.Eth0.RxBytes)
+	assert.InDelta(t, 0.5437, stats.DerivedStats.CPUPercentage, 0.0001)
+	assert.InDelta(t, 1.0621, stats.DerivedStats.MemoryPercentage, 0.0001)
+}
+
+// BenchmarkRecordStats decodes the frames we get once a second from every
+// running container's stats stream
+func BenchmarkRecordStats(b *testing.B) {
+	frames := recordedFrames(b)
+	b.SetBytes(int64(len(frames[0])))
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		recordStats(frames[i%len(frames)])
+	}
+}
+
+// BenchmarkPlotGraph plots each of the default graphs from a full history,
+// which is what we do every time we render a container's stats
+func BenchmarkPlotGraph(b *testing.B) {
+	userConfig := config.GetDefaultConfig()
+	container := &Container{Config: &config.AppConfig{UserConfig: &userConfig}}
+	frames := recordedFrames(b)
+
+	// one frame a second for as long as we keep them
+	maxDuration := container.Config.UserConfig.Stats.MaxDuration
+	start := time.Now().Add(-maxDuration)
+	for i := 0; i < int(maxDuration/time.Second); i++ {
+		stats := recordStats(frames[i%len(frames)])
+		stats.RecordedAt = start.Add(time.Duration(i) * time.Second)
+		container.StatHistory = append(container.StatHistory, stats)
+	}
+
+	for _, spec := range container.Config.UserConfig.Stats.Graphs {
+		b.Run(fmt.Sprintf("%s/%d frames", spec.StatPath, len(container.StatHistory)), func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := container.PlotGraph(spec, 120); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,165 @@
+package commands
+
+import (
+	"fmt"
+	"sort"
+	"strings"
+
+	"github.com/fatih/color"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// ContainerTreeRow is a row of the containers panel when it's grouped by
+// compose project and then by service. A row is either a group (a project or
+// a service), in which case Container is nil and the row totals up the
+// containers inside it, or a container
+type ContainerTreeRow struct {
+	// Key identifies the row across refreshes, so that we know which groups
+	// the user has collapsed
+	Key       string
+	Depth     int
+	Name      string
+	Container *Container
+	Collapsed bool
+
+	Running int
+	Total   int
+	// CPU and Memory are the summed percentages of the containers in the group
+	// that we have stats for
+	CPU    float64
+	Memory float64
+}
+
+// IsGroup tells us whether the row is a project or service rather than a
+// container
+func (r *ContainerTreeRow) IsGroup() bool {
+	return r.Container == nil
+}
+
+// GetDisplayStrings returns the display strings of the row, lining up with
+// those of a container so that the tree renders as one table
+func (r *ContainerTreeRow) GetDisplayStrings(isFocused bool) []string {
+	indent := strings.Repeat("  ", r.Depth)
+
+	if !r.IsGroup() {
+		displayStrings := r.Container.GetDisplayStrings(isFocused)
+		displayStrings[2] = indent + displayStrings[2]
+		return displayStrings
+	}
+
+	statusColor := color.FgGreen
+	if r.Running == 0 {
+		statusColor = color.FgRed
+	} else if r.Running < r.Total {
+		statusColor = color.FgYellow
+	}
+
+	marker := "- "
+	if r.Collapsed {
+		marker = "+ "
+	}
+
+	return []string{
+		utils.ColoredString(fmt.Sprintf("%d/%d", r.Running, r.Total), statusColor),
+		"",
+		indent + marker + utils.ColoredString(r.Name, color.Bold),
+		fmt.Sprintf("%.2f%%", r.CPU),
+		utils.ColoredString(fmt.Sprintf("mem %.2f%%", r.Memory), color.FgMagenta),
+	}
+}
+
+func (r *ContainerTreeRow) add(container *Container) {
+	r.Total++
+	if container.Container.State == "running" {
+		r.Running++
+	}
+	if cpu, ok := container.CPUPercentage(); ok {
+		r.CPU += cpu
+	}
+	if memory, ok := container.MemoryPercentage(); ok {
+		r.Memory += memory
+	}
+}
+
+// GroupContainers arranges the containers into a tree of compose projects,
+// each holding its services, each holding their containers, flattened into
+// rows. Projects and services are sorted by name, while containers keep the
+// order they're given in. Containers that aren't part of a compose project
+// come last, outside of any group. The children of any group whose key is in
+// collapsed are left out. Projects are told apart by endpoint, so that two
+// daemons running a project of the same name get a group each
+func GroupContainers(containers []*Container, collapsed map[string]bool) []*ContainerTreeRow {
+	projects := map[string]*ContainerTreeRow{}
+	services := map[string]*ContainerTreeRow{}
+	projectServices := map[string][]string{}
+	members := map[string][]*Container{}
+	projectNames := []string{}
+	standalone := []*Container{}
+
+	for _, container := range containers {
+		if container.ProjectName == "" {
+			standalone = append(standalone, container)
+			continue
+		}
+
+		projectName := container.Endpoint.Qualify(container.ProjectName)
+		projectKey := "project:" + projectName
+		project, ok := projects[projectKey]
+		if !ok {
+			project = &ContainerTreeRow{Key: projectKey, Name: projectName, Collapsed: collapsed[projectKey]}
+			projects[projectKey] = project
+			projectNames = append(projectNames, projectName)
+		}
+		project.add(container)
+
+		// containers without a service sit directly beneath their project
+		groupKey := projectKey
+		if container.ServiceName != "" {
+			groupKey = "service:" + projectName + "/" + container.ServiceName
+			service, ok := services[groupKey]
+			if !ok {
+				service = &ContainerTreeRow{Key: groupKey, Depth: 1, Name: container.ServiceName, Collapsed: collapsed[groupKey]}
+				services[groupKey] = service
+				projectServices[projectKey] = append(projectServices[projectKey], groupKey)
+			}
+			service.add(container)
+		}
+		members[groupKey] = append(members[groupKey], container)
+	}
+
+	sort.Strings(projectNames)
+
+	rows := make([]*ContainerTreeRow, 0, len(containers)+len(projects)+len(services))
+	addContainers := func(groupKey string, depth int) {
+		for _, container := range members[groupKey] {
+			rows = append(rows, &ContainerTreeRow{Key: container.QualifiedID(), Depth: depth, Name: container.Name, Container: container})
+		}
+	}
+
+	for _, projectName := range projectNames {
+		project := projects["project:"+projectName]
+		rows = append(rows, project)
+		if project.Collapsed {
+			continue
+		}
+
+		serviceKeys := projectServices[project.Key]
+		sort.Slice(serviceKeys, func(i, j int) bool {
+			return services[serviceKeys[i]].Name < services[serviceKeys[j]].Name
+		})
+		for _, serviceKey := range serviceKeys {
+			service := services[serviceKey]
+			rows = append(rows, service)
+			if !service.Collapsed {
+				addContainers(serviceKey, 2)
+			}
+		}
+		addContainers(project.Key, 1)
+	}
+
+	for _, container := range standalone {
+		rows = append(rows, &ContainerTreeRow{Key: container.QualifiedID(), Name: container.Name, Container: container})
+	}
+
+	return rows
+}
@@ -0,0 +1,117 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/stretchr/testify/assert"
+)
+
+func newTreeContainer(id string, project string, service string, state string, cpu string) *Container {
+	return &Container{
+		ID:          id,
+		Name:        id,
+		ProjectName: project,
+		ServiceName: service,
+		Container:   types.Container{State: state},
+		CLIStats:    ContainerCliStat{CPUPerc: cpu, MemPerc: "1.00%"},
+	}
+}
+
+type treeRowSummary struct {
+	Key     string
+	Depth   int
+	Running int
+	Total   int
+	CPU     float64
+}
+
+func summariseTree(rows []*ContainerTreeRow) []treeRowSummary {
+	summaries := make([]treeRowSummary, len(rows))
+	for i, row := range rows {
+		summaries[i] = treeRowSummary{row.Key, row.Depth, row.Running, row.Total, row.CPU}
+	}
+	return summaries
+}
+
+// TestGroupContainers is a function.
+func TestGroupContainers(t *testing.T) {
+	type scenario struct {
+		description string
+		collapsed   map[string]bool
+		expected    []treeRowSummary
+	}
+
+	containers := []*Container{
+		newTreeContainer("standalone", "", "", "running", "1%"),
+		newTreeContainer("web-2", "shop", "web", "exited", "--"),
+		newTreeContainer("db-1", "shop", "db", "running", "4%"),
+		newTreeContainer("web-1", "shop", "web", "running", "2%"),
+		newTreeContainer("job", "shop", "", "exited", ""),
+		newTreeContainer("api-1", "blog", "api", "running", "8%"),
+	}
+
+	scenarios := []scenario{
+		{
+			"everything expanded",
+			nil,
+			[]treeRowSummary{
+				{"project:blog", 0, 1, 1, 8},
+				{"service:blog/api", 1, 1, 1, 8},
+				{"api-1", 2, 0, 0, 0},
+				{"project:shop", 0, 2, 4, 6},
+				{"service:shop/db", 1, 1, 1, 4},
+				{"db-1", 2, 0, 0, 0},
+				{"service:shop/web", 1, 1, 2, 2},
+				{"web-2", 2, 0, 0, 0},
+				{"web-1", 2, 0, 0, 0},
+				{"job", 1, 0, 0, 0},
+				{"standalone", 0, 0, 0, 0},
+			},
+		},
+		{
+			"collapsed groups leave out their children but keep their totals",
+			map[string]bool{"project:blog": true, "service:shop/web": true},
+			[]treeRowSummary{
+				{"project:blog", 0, 1, 1, 8},
+				{"project:shop", 0, 2, 4, 6},
+				{"service:shop/db", 1, 1, 1, 4},
+				{"db-1", 2, 0, 0, 0},
+				{"service:shop/web", 1, 1, 2, 2},
+				{"job", 1, 0, 0, 0},
+				{"standalone", 0, 0, 0, 0},
+			},
+		},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, summariseTree(GroupContainers(containers, s.collapsed)), s.description)
+	}
+}
+
+// TestGroupContainersAcrossEndpoints is a function.
+func TestGroupContainersAcrossEndpoints(t *testing.T) {
+	rootless := &Endpoint{Name: "rootless", Prefix: "rootless:"}
+	rootful := &Endpoint{Name: "rootful", Prefix: "rootful:"}
+
+	containers := []*Container{
+		newTreeContainer("web-1", "myapp", "web", "running", "2%"),
+		newTreeContainer("web-2", "myapp", "web", "exited", "--"),
+		newTreeContainer("web-3", "myapp", "web", "running", "4%"),
+	}
+	containers[0].Endpoint = rootless
+	containers[1].Endpoint = rootful
+	containers[2].Endpoint = rootful
+
+	// the same project on each daemon gets its own group, totals and collapsed
+	// state
+	collapsed := map[string]bool{"project:rootful:myapp": true}
+	rows := GroupContainers(containers, collapsed)
+	assert.EqualValues(t, []treeRowSummary{
+		{"project:rootful:myapp", 0, 1, 2, 4},
+		{"project:rootless:myapp", 0, 1, 1, 2},
+		{"service:rootless:myapp/web", 1, 1, 1, 2},
+		{"rootless:web-1", 2, 0, 0, 0},
+	}, summariseTree(rows))
+	assert.EqualValues(t, "rootful:myapp", rows[0].Name)
+}
@@ -0,0 +1,304 @@
+package commands
+
+import (
+	"context"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/events"
+	"github.com/docker/docker/client"
+	"github.com/sirupsen/logrus"
+)
+
+// diskUsageRefreshDelay is how long we wait after an event before working out
+// the disk usage again. Events come in bursts (e.g. a prune removes a heap of
+// images at once) so we let things settle first
+const diskUsageRefreshDelay = time.Second
+
+// ImageUsage is the space taken up by an image. SharedSize is the size of the
+// layers it has in common with other images, so UniqueSize is what we'd
+// actually get back by removing it
+type ImageUsage struct {
+	ID         string
+	Name       string
+	Size       int64
+	SharedSize int64
+	UniqueSize int64
+	Containers int64
+	Dangling   bool
+}
+
+// ContainerUsage is the space taken up by a container's writable layer
+type ContainerUsage struct {
+	ID     string
+	Name   string
+	Image  string
+	State  string
+	SizeRw int64
+}
+
+// VolumeUsage is the space taken up by a volume. Size is -1 if the volume's
+// driver can't tell us
+type VolumeUsage struct {
+	Name     string
+	Size     int64
+	RefCount int64
+}
+
+// DiskUsage breaks down the space docker is using on the host
+type DiskUsage struct {
+	LayersSize     int64
+	BuildCacheSize int64
+	Images         []ImageUsage
+	Containers     []ContainerUsage
+	Volumes        []VolumeUsage
+	ComputedAt     time.Time
+
+	volumeSizes map[string]int64
+}
+
+// NewDiskUsage breaks down what the daemon tells us into per-image,
+// per-container and per-volume usage, each sorted biggest first
+func NewDiskUsage(du types.DiskUsage) *DiskUsage {
+	usage := &DiskUsage{
+		LayersSize: du.LayersSize,
+		ComputedAt: time.Now(),
+	}
+
+	for _, image := range du.Images {
+		imageUsage := ImageUsage{
+			ID:         image.ID,
+			Name:       "<none>",
+			Size:       image.Size,
+			SharedSize: image.SharedSize,
+			UniqueSize: image.Size,
+			Containers: image.Containers,
+			Dangling:   true,
+		}
+		// the daemon sets SharedSize to -1 if it didn't work it out
+		if image.SharedSize > 0 {
+			imageUsage.UniqueSize -= image.SharedSize
+		}
+		for _, tag := range image.RepoTags {
+			if tag != "<none>:<none>" {
+				imageUsage.Name = tag
+				imageUsage.Dangling = false
+				break
+			}
+		}
+		usage.Images = append(usage.Images, imageUsage)
+	}
+
+	for _, container := range du.Containers {
+		name := container.ID
+		if len(container.Names) > 0 {
+			name = strings.TrimPrefix(container.Names[0], "/")
+		}
+		usage.Containers = append(usage.Containers, ContainerUsage{
+			ID:     container.ID,
+			Name:   name,
+			Image:  container.Image,
+			State:  container.State,
+			SizeRw: container.SizeRw,
+		})
+	}
+
+	usage.volumeSizes = make(map[string]int64, len(du.Volumes))
+	for _, volume := range du.Volumes {
+		volumeUsage := VolumeUsage{Name: volume.Name, Size: -1, RefCount: -1}
+		if volume.UsageData != nil {
+			volumeUsage.Size = volume.UsageData.Size
+			volumeUsage.RefCount = volume.UsageData.RefCount
+		}
+		usage.Volumes = append(usage.Volumes, volumeUsage)
+		usage.volumeSizes[volume.Name] = volumeUsage.Size
+	}
+
+	for _, cache := range du.BuildCache {
+		usage.BuildCacheSize += cache.Size
+	}
+
+	sort.SliceStable(usage.Images, func(i, j int) bool {
+		return usage.Images[i].Size > usage.Images[j].Size
+	})
+	sort.SliceStable(usage.Containers, func(i, j int) bool {
+		return usage.Containers[i].SizeRw > usage.Containers[j].SizeRw
+	})
+	sort.SliceStable(usage.Volumes, func(i, j int) bool {
+		return usage.Volumes[i].Size > usage.Volumes[j].Size
+	})
+
+	return usage
+}
+
+// ReclaimableImageBytes is roughly how much space pruning images would free up.
+// A prune only removes dangling images that no container is using, and we only
+// count the layers those images don't share with anything else
+func (d *DiskUsage) ReclaimableImageBytes() int64 {
+	var total int64
+	for _, image := range d.Images {
+		if image.Dangling && image.Containers == 0 {
+			total += image.UniqueSize
+		}
+	}
+	return total
+}
+
+// ReclaimableVolumeBytes is how much space pruning volumes would free up, i.e.
+// the size of every volume that no container is using
+func (d *DiskUsage) ReclaimableVolumeBytes() int64 {
+	var total int64
+	for _, volume := range d.Volumes {
+		if volume.RefCount == 0 && volume.Size > 0 {
+			total += volume.Size
+		}
+	}
+	return total
+}
+
+// VolumeSize returns the size of the given volume, or -1 if we don't know it
+func (d *DiskUsage) VolumeSize(name string) int64 {
+	if size, ok := d.volumeSizes[name]; ok {
+		return size
+	}
+	return -1
+}
+
+// ContainersSize is the combined size of every container's writable layer
+func (d *DiskUsage) ContainersSize() int64 {
+	var total int64
+	for _, container := range d.Containers {
+		total += container.SizeRw
+	}
+	return total
+}
+
+// VolumesSize is the combined size of every volume we know the size of
+func (d *DiskUsage) VolumesSize() int64 {
+	var total int64
+	for _, volume := range d.Volumes {
+		if volume.Size > 0 {
+			total += volume.Size
+		}
+	}
+	return total
+}
+
+// DiskUsageMonitor holds on to the last disk usage we got from the daemon.
+// Working it out is slow (the daemon has to walk every volume) so we do it in
+// the background, and only do it again once an event tells us that an image,
+// volume, container or the build cache has changed
+type DiskUsageMonitor struct {
+	Log       *logrus.Entry
+	Client    *client.Client
+	mutex     sync.Mutex
+	usage     *DiskUsage
+	err       error
+	computing bool
+	stale     bool
+	version   int
+	timer     *time.Timer
+}
+
+// NewDiskUsageMonitor returns a new DiskUsageMonitor which refreshes itself
+// whenever the event monitor tells it something relevant has happened
+func NewDiskUsageMonitor(log *logrus.Entry, client *client.Client, eventMonitor *EventMonitor) *DiskUsageMonitor {
+	m := &DiskUsageMonitor{
+		Log:    log,
+		Client: client,
+	}
+	eventMonitor.Subscribe(m.handleEvent)
+	return m
+}
+
+// Get returns the latest disk usage we have, which is nil if we haven't
+// finished working it out yet, along with the error from our last attempt
+func (m *DiskUsageMonitor) Get() (*DiskUsage, error) {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	return m.usage, m.err
+}
+
+// Version is bumped every time we've had another go at working out the disk
+// usage, so that callers can tell whether they need to re-render it
+func (m *DiskUsageMonitor) Version() int {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	return m.version
+}
+
+// Refresh works out the disk usage again in the background. If we're already
+// in the middle of doing that, we go again once we're done, given that
+// whatever prompted this may have happened after the daemon started counting
+func (m *DiskUsageMonitor) Refresh() {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	if m.computing {
+		m.stale = true
+		return
+	}
+	m.computing = true
+	go m.compute()
+}
+
+func (m *DiskUsageMonitor) compute() {
+	for {
+		du, err := m.Client.DiskUsage(context.Background())
+
+		m.mutex.Lock()
+		if err != nil {
+			m.Log.Warn(err)
+			m.err = err
+		} else {
+			m.usage = NewDiskUsage(du)
+			m.err = nil
+		}
+		m.version++
+
+		if !m.stale {
+			m.computing = false
+			m.mutex.Unlock()
+			return
+		}
+		m.stale = false
+		m.mutex.Unlock()
+	}
+}
+
+func (m *DiskUsageMonitor) handleEvent(message events.Message) {
+	if !affectsDiskUsage(message) {
+		return
+	}
+
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	if m.timer != nil {
+		m.timer.Stop()
+	}
+	m.timer = time.AfterFunc(diskUsageRefreshDelay, m.Refresh)
+}
+
+// affectsDiskUsage tells us whether an event could have changed how much space
+// docker is using. A running container's writable layer can grow at any time
+// but we only pick that up once it stops
+func affectsDiskUsage(message events.Message) bool {
+	switch message.Type {
+	case events.ImageEventType, builderEventType:
+		return true
+	case events.VolumeEventType:
+		return message.Action != "mount" && message.Action != "unmount"
+	case events.ContainerEventType:
+		switch message.Action {
+		case "create", "destroy", "die", "commit":
+			return true
+		}
+	}
+	return false
+}
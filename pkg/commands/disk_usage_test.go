@@ -0,0 +1,73 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/events"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestNewDiskUsage is a function.
+func TestNewDiskUsage(t *testing.T) {
+	usage := NewDiskUsage(types.DiskUsage{
+		LayersSize: 600,
+		Images: []*types.ImageSummary{
+			{ID: "a", RepoTags: []string{"alpine:latest"}, Size: 100, SharedSize: 40, Containers: 1},
+			{ID: "b", RepoTags: []string{"<none>:<none>"}, Size: 300, SharedSize: 40},
+			{ID: "c", Size: 200, SharedSize: -1, Containers: 2},
+		},
+		Containers: []*types.Container{
+			{ID: "abc", Names: []string{"/web"}, Image: "alpine:latest", SizeRw: 10},
+			{ID: "def", Names: []string{"/db"}, Image: "postgres", SizeRw: 20},
+		},
+		Volumes: []*types.Volume{
+			{Name: "used", UsageData: &types.VolumeUsageData{Size: 50, RefCount: 1}},
+			{Name: "unused", UsageData: &types.VolumeUsageData{Size: 70, RefCount: 0}},
+			{Name: "remote", UsageData: &types.VolumeUsageData{Size: -1, RefCount: 0}},
+		},
+		BuildCache: []*types.BuildCache{{Size: 5}, {Size: 7}},
+	})
+
+	assert.EqualValues(t, []ImageUsage{
+		{ID: "b", Name: "<none>", Size: 300, SharedSize: 40, UniqueSize: 260, Dangling: true},
+		{ID: "c", Name: "<none>", Size: 200, SharedSize: -1, UniqueSize: 200, Containers: 2, Dangling: true},
+		{ID: "a", Name: "alpine:latest", Size: 100, SharedSize: 40, UniqueSize: 60, Containers: 1},
+	}, usage.Images)
+	assert.EqualValues(t, "db", usage.Containers[0].Name)
+	assert.EqualValues(t, []string{"unused", "used", "remote"}, []string{usage.Volumes[0].Name, usage.Volumes[1].Name, usage.Volumes[2].Name})
+
+	// only the dangling image that no container is using would be pruned
+	assert.EqualValues(t, 260, usage.ReclaimableImageBytes())
+	assert.EqualValues(t, 70, usage.ReclaimableVolumeBytes())
+	assert.EqualValues(t, 30, usage.ContainersSize())
+	assert.EqualValues(t, 120, usage.VolumesSize())
+	assert.EqualValues(t, 12, usage.BuildCacheSize)
+	assert.EqualValues(t, 50, usage.VolumeSize("used"))
+	assert.EqualValues(t, -1, usage.VolumeSize("remote"))
+	assert.EqualValues(t, -1, usage.VolumeSize("missing"))
+}
+
+// TestAffectsDiskUsage is a function.
+func TestAffectsDiskUsage(t *testing.T) {
+	type scenario struct {
+		eventType string
+		action    string
+		expected  bool
+	}
+
+	scenarios := []scenario{
+		{events.ImageEventType, "pull", true},
+		{events.ImageEventType, "delete", true},
+		{builderEventType, "prune", true},
+		{events.VolumeEventType, "create", true},
+		{events.VolumeEventType, "mount", false},
+		{events.ContainerEventType, "destroy", true},
+		{events.ContainerEventType, "exec_start", false},
+		{events.NetworkEventType, "connect", false},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, affectsDiskUsage(events.Message{Type: s.eventType, Action: s.action}), s.eventType+" "+s.action)
+	}
+}
@@ -2,7 +2,6 @@ package commands
 
 import (
 	"bufio"
-	"context"
 	"encoding/json"
 	"fmt"
 	"os/exec"
@@ -34,6 +33,7 @@ type DockerCommand struct {
 	Client                 *client.Client
 	InDockerComposeProject bool
 	ShowExited             bool
+	RemoteMode             bool
 	ErrorChan              chan error
 	ContainerMutex         sync.Mutex
 	ServiceMutex           sync.Mutex
@@ -43,6 +43,35 @@ type DockerCommand struct {
 	DisplayContainers []*Container
 	Images            []*Image
 	Volumes           []*Volume
+	// Endpoints are the daemons we list containers, images and volumes from.
+	// Client is the first endpoint's client, and anything daemon-wide rather
+	// than about a particular container, image or volume (events, disk usage,
+	// pruning) goes through that one
+	Endpoints []*Endpoint
+	// Pulls keeps track of images being pulled through the docker API
+	Pulls *PullManager
+	// Events streams events from the first endpoint's daemon to anything that
+	// wants to know when something has changed there. Each endpoint has its own
+	Events *EventMonitor
+	// DiskUsage holds on to how much space docker is using on the host
+	DiskUsage *DiskUsageMonitor
+	// Layers tells us which layers each image shares with the others
+	Layers *LayerGraph
+	// ImageHistories caches the rendered history of each image we've viewed
+	ImageHistories *ImageHistoryCache
+	// UsageIndex tells us which containers use each image and volume
+	UsageIndex *UsageIndex
+
+	monitorStatsOnce  sync.Once
+	monitorEventsOnce sync.Once
+	allServices       []*Service
+
+	// listMutex guards lastImages and lastVolumes, which are every image and
+	// volume we listed last time. The gui filters Images and Volumes down, so
+	// we can't go by those
+	listMutex   sync.Mutex
+	lastImages  []*Image
+	lastVolumes []*Volume
 }
 
 // LimitedDockerCommand is a stripped-down DockerCommand with just the methods the container/service/image might need
@@ -59,6 +88,20 @@ type CommandObject struct {
 	Volume        *Volume
 }
 
+// Endpoint returns the endpoint of whichever container, image or volume the
+// command object is for, so that we can run the command against its daemon
+func (o CommandObject) Endpoint() *Endpoint {
+	switch {
+	case o.Container != nil:
+		return o.Container.Endpoint
+	case o.Image != nil:
+		return o.Image.Endpoint
+	case o.Volume != nil:
+		return o.Volume.Endpoint
+	}
+	return nil
+}
+
 // NewCommandObject takes a command object and returns a default command object with the passed command object merged in
 func (c *DockerCommand) NewCommandObject(obj CommandObject) CommandObject {
 	defaultObj := CommandObject{DockerCompose: c.Config.UserConfig.CommandTemplates.DockerCompose}
@@ -68,10 +111,17 @@ func (c *DockerCommand) NewCommandObject(obj CommandObject) CommandObject {
 
 // NewDockerCommand it runs docker commands
 func NewDockerCommand(log *logrus.Entry, osCommand *OSCommand, tr *i18n.TranslationSet, config *config.AppConfig, errorChan chan error) (*DockerCommand, error) {
-	cli, err := client.NewClientWithOpts(client.FromEnv, client.WithVersion(APIVersion))
+	endpoints, err := NewEndpoints(config.UserConfig.Endpoints)
 	if err != nil {
 		return nil, err
 	}
+	for _, endpoint := range endpoints {
+		endpoint.Observe(osCommand.Metrics, osCommand.Tracer)
+		endpoint.Events = NewEventMonitor(log, endpoint.StreamClient)
+	}
+	cli := endpoints[0].Client
+
+	isRemote := remoteMode(config.UserConfig.Update.RemoteMode, endpoints)
 
 	dockerCommand := &DockerCommand{
 		Log:                    log,
@@ -79,10 +129,20 @@ func NewDockerCommand(log *logrus.Entry, osCommand *OSCommand, tr *i18n.Translat
 		Tr:                     tr,
 		Config:                 config,
 		Client:                 cli,
+		Endpoints:              endpoints,
+		RemoteMode:             isRemote,
 		ErrorChan:              errorChan,
 		ShowExited:             true,
 		InDockerComposeProject: true,
+		Pulls:                  NewPullManager(log, endpoints[0].StreamClient),
+		Events:                 endpoints[0].Events,
+		Layers:                 NewLayerGraph(log, cli),
+		UsageIndex:             NewUsageIndex(),
 	}
+	dockerCommand.DiskUsage = NewDiskUsageMonitor(log, cli, dockerCommand.Events)
+	dockerCommand.ImageHistories = NewImageHistoryCache(func(imageID string) (string, error) {
+		return renderImageHistory(cli, imageID)
+	})
 
 	command := utils.ApplyTemplate(
 		config.UserConfig.CommandTemplates.CheckDockerComposeConfig,
@@ -91,11 +151,9 @@ func NewDockerCommand(log *logrus.Entry, osCommand *OSCommand, tr *i18n.Translat
 
 	log.Warn(command)
 
-	err = osCommand.RunCommand(
-		utils.ApplyTemplate(
-			config.UserConfig.CommandTemplates.CheckDockerComposeConfig,
-			dockerCommand.NewCommandObject(CommandObject{}),
-		),
+	err = osCommand.RunTemplate(
+		config.UserConfig.CommandTemplates.CheckDockerComposeConfig,
+		dockerCommand.NewCommandObject(CommandObject{}),
 	)
 	if err != nil {
 		dockerCommand.InDockerComposeProject = false
@@ -105,17 +163,51 @@ func NewDockerCommand(log *logrus.Entry, osCommand *OSCommand, tr *i18n.Translat
 	return dockerCommand, nil
 }
 
-// MonitorContainerStats is a function
+// MonitorContainerStats starts the stats monitors. The gui calls this every
+// time it starts up, including when it comes back from a subprocess, but the
+// monitors keep running in the meantime so we only ever start them once
 func (c *DockerCommand) MonitorContainerStats() {
-	// TODO: pass in a stop channel to these so we don't restart every time we come back from a subprocess
-	go c.MonitorCLIContainerStats()
-	go c.MonitorClientContainerStats()
+	c.monitorStatsOnce.Do(func() {
+		go c.MonitorCLIContainerStats()
+		go c.MonitorClientContainerStats()
+	})
+}
+
+// MonitorEvents starts streaming events from every endpoint and works out the
+// disk usage for the first time. Like MonitorContainerStats, this only happens
+// once
+func (c *DockerCommand) MonitorEvents() {
+	c.monitorEventsOnce.Do(func() {
+		for _, endpoint := range c.Endpoints {
+			endpoint.Events.Start()
+		}
+		c.DiskUsage.Refresh()
+	})
 }
 
-// MonitorCLIContainerStats monitors a stream of container stats and updates the containers as each new stats object is received
+// EventVersion returns how many events of the given type (e.g. 'volume') we've
+// seen across all the endpoints, so that callers can poll it cheaply to see
+// whether they need to refresh anything of that type
+func (c *DockerCommand) EventVersion(eventType string) int {
+	version := 0
+	for _, endpoint := range c.Endpoints {
+		version += endpoint.Events.Version(eventType)
+	}
+	return version
+}
+
+// MonitorCLIContainerStats monitors a stream of container stats from each
+// endpoint and updates the containers as each new stats object is received
 func (c *DockerCommand) MonitorCLIContainerStats() {
+	for _, endpoint := range c.Endpoints[1:] {
+		go c.monitorCLIContainerStats(endpoint)
+	}
+	c.monitorCLIContainerStats(c.Endpoints[0])
+}
+
+func (c *DockerCommand) monitorCLIContainerStats(endpoint *Endpoint) {
 	command := `docker stats --all --no-trunc --format '{{json .}}'`
-	cmd := c.OSCommand.RunCustomCommand(command)
+	cmd := endpoint.Prepare(c.OSCommand.RunCustomCommand(command))
 
 	r, err := cmd.StdoutPipe()
 	if err != nil {
@@ -137,7 +229,7 @@ func (c *DockerCommand) MonitorCLIContainerStats() {
 		}
 		c.ContainerMutex.Lock()
 		for _, container := range c.Containers {
-			if container.ID == stats.ID {
+			if container.ID == stats.ID && container.Endpoint == endpoint {
 				container.CLIStats = stats
 			}
 		}
@@ -164,28 +256,24 @@ func (c *DockerCommand) MonitorClientContainerStats() {
 
 func (c *DockerCommand) createClientStatMonitor(container *Container) {
 	container.MonitoringStats = true
-	stream, err := c.Client.ContainerStats(context.Background(), container.ID, true)
+	// stats streams stay open for as long as the container runs, so they go
+	// through the stream client rather than holding up short requests
+	streamClient := container.Client
+	if container.Endpoint != nil {
+		streamClient = container.Endpoint.StreamClient
+	}
+	stream, err := streamClient.ContainerStats(container.Endpoint.StreamContext(), container.ID, true)
 	if err != nil {
 		c.ErrorChan <- err
 		return
 	}
 
 	defer stream.Body.Close()
+	defer c.OSCommand.Metrics.StartStatsStream()()
 
 	scanner := bufio.NewScanner(stream.Body)
 	for scanner.Scan() {
-		data := scanner.Bytes()
-		var stats ContainerStats
-		json.Unmarshal(data, &stats)
-
-		recordedStats := RecordedStats{
-			ClientStats: stats,
-			DerivedStats: DerivedStats{
-				CPUPercentage:    stats.CalculateContainerCPUPercentage(),
-				MemoryPercentage: stats.CalculateContainerMemoryUsage(),
-			},
-			RecordedAt: time.Now(),
-		}
+		recordedStats := recordStats(scanner.Bytes())
 
 		c.ContainerMutex.Lock()
 		container.StatHistory = append(container.StatHistory, recordedStats)
@@ -198,26 +286,27 @@ func (c *DockerCommand) createClientStatMonitor(container *Container) {
 
 // RefreshContainersAndServices returns a slice of docker containers
 func (c *DockerCommand) RefreshContainersAndServices() error {
-	c.ServiceMutex.Lock()
-	defer c.ServiceMutex.Unlock()
-
-	currentServices := c.Services
-
+	// if another refresh is already waiting on the daemon, this shares its
+	// request rather than queueing up behind it to make another
 	containers, err := c.GetContainers()
 	if err != nil {
 		return err
 	}
 
-	var services []*Service
-	// we only need to get these services once because they won't change in the runtime of the program
-	if currentServices != nil {
-		services = currentServices
-	} else {
-		services, err = c.GetServices()
+	lockSpan := c.OSCommand.Tracer.Start("lock", "wait for service lock")
+	c.ServiceMutex.Lock()
+	lockSpan.End()
+	defer c.ServiceMutex.Unlock()
+
+	// we only need to get these services once because they won't change in the runtime of the program.
+	// We don't reuse c.Services because the gui may have filtered it down
+	if c.allServices == nil {
+		c.allServices, err = c.GetServices()
 		if err != nil {
 			return err
 		}
 	}
+	services := c.allServices
 
 	c.assignContainersToServices(containers, services)
 
@@ -242,6 +331,7 @@ func (c *DockerCommand) RefreshContainersAndServices() error {
 	c.Containers = containers
 	c.Services = services
 	c.DisplayContainers = c.filterOutExited(displayContainers)
+	c.UsageIndex.Update(containers)
 
 	return nil
 }
@@ -250,7 +340,7 @@ func (c *DockerCommand) assignContainersToServices(containers []*Container, serv
 L:
 	for _, service := range services {
 		for _, container := range containers {
-			if !container.OneOff && container.ServiceName == service.Name {
+			if !container.OneOff && container.ServiceName == service.Name && c.OnFirstEndpoint(container.Endpoint) {
 				service.Container = container
 				continue L
 			}
@@ -259,6 +349,13 @@ L:
 	}
 }
 
+// OnFirstEndpoint tells us whether something came from the first of our
+// endpoints. That's the one we expect docker-compose to be talking to, and the
+// only one we work out disk usage and shared layers for
+func (c *DockerCommand) OnFirstEndpoint(endpoint *Endpoint) bool {
+	return endpoint == nil || endpoint == c.Endpoints[0]
+}
+
 // filterOutExited filters out the exited containers if c.ShowExited is false
 func (c *DockerCommand) filterOutExited(containers []*Container) []*Container {
 	if c.ShowExited {
@@ -279,7 +376,7 @@ func (c *DockerCommand) obtainStandaloneContainers(containers []*Container, serv
 L:
 	for _, container := range containers {
 		for _, service := range services {
-			if !container.OneOff && container.ServiceName != "" && container.ServiceName == service.Name {
+			if !container.OneOff && container.ServiceName != "" && container.ServiceName == service.Name && c.OnFirstEndpoint(container.Endpoint) {
 				continue L
 			}
 		}
@@ -291,58 +388,92 @@ L:
 
 // GetContainers gets the docker containers
 func (c *DockerCommand) GetContainers() ([]*Container, error) {
-	c.ContainerMutex.Lock()
-	defer c.ContainerMutex.Unlock()
-
-	existingContainers := c.Containers
-
-	containers, err := c.Client.ContainerList(context.Background(), types.ContainerListOptions{All: true})
+	// we ask every endpoint for its containers at once, so a slow daemon only
+	// holds us up for as long as it takes to answer. We don't hold the lock
+	// while we wait so that stats keep coming in for the containers we've got
+	containerLists := make([][]types.Container, len(c.Endpoints))
+	failed, err := forEachEndpoint(c.Endpoints, func(i int, endpoint *Endpoint) error {
+		containers, err := endpoint.listContainers()
+		containerLists[i] = containers
+		return err
+	})
 	if err != nil {
 		return nil, err
 	}
 
-	ownContainers := make([]*Container, len(containers))
+	lockSpan := c.OSCommand.Tracer.Start("lock", "wait for container lock")
+	c.ContainerMutex.Lock()
+	lockSpan.End()
+	defer c.ContainerMutex.Unlock()
 
-	for i, container := range containers {
-		var newContainer *Container
+	matchSpan := c.OSCommand.Tracer.Start("list", "match containers")
+	defer matchSpan.End()
+	return c.matchContainers(c.Containers, containerLists, failed), nil
+}
 
-		// check if we already data stored against the container
-		for _, existingContainer := range existingContainers {
-			if existingContainer.ID == container.ID {
-				newContainer = existingContainer
-				break
+// matchContainers pairs up the containers the endpoints listed with the ones we
+// already have, so that we hold on to their stats and details. For any
+// endpoint that failed to answer we keep the containers we had as they were,
+// rather than dropping them and starting their stats over when it's back
+func (c *DockerCommand) matchContainers(existingContainers []*Container, containerLists [][]types.Container, failed []bool) []*Container {
+	ownContainers := []*Container{}
+
+	for endpointIndex, containers := range containerLists {
+		endpoint := c.Endpoints[endpointIndex]
+		if failed[endpointIndex] {
+			for _, container := range existingContainers {
+				if container.Endpoint == endpoint {
+					ownContainers = append(ownContainers, container)
+				}
 			}
+			continue
+		}
+		for _, container := range containers {
+			ownContainers = append(ownContainers, c.newOrExistingContainer(existingContainers, endpoint, container))
 		}
+	}
 
-		// initialise the container if it's completely new
-		if newContainer == nil {
-			newContainer = &Container{
-				ID:            container.ID,
-				Client:        c.Client,
-				OSCommand:     c.OSCommand,
-				Log:           c.Log,
-				Config:        c.Config,
-				DockerCommand: c,
-				Tr:            c.Tr,
-			}
+	return ownContainers
+}
+
+func (c *DockerCommand) newOrExistingContainer(existingContainers []*Container, endpoint *Endpoint, container types.Container) *Container {
+	var newContainer *Container
+
+	// check if we already data stored against the container
+	for _, existingContainer := range existingContainers {
+		if existingContainer.ID == container.ID && existingContainer.Endpoint == endpoint {
+			newContainer = existingContainer
+			break
 		}
+	}
 
-		newContainer.Container = container
-		// if the container is made with a name label we will use that
-		if name, ok := container.Labels["name"]; ok {
-			newContainer.Name = name
-		} else {
-			newContainer.Name = strings.TrimLeft(container.Names[0], "/")
+	// initialise the container if it's completely new
+	if newContainer == nil {
+		newContainer = &Container{
+			ID:            container.ID,
+			Endpoint:      endpoint,
+			Client:        endpoint.Client,
+			OSCommand:     c.OSCommand,
+			Log:           c.Log,
+			Config:        c.Config,
+			DockerCommand: c,
+			Tr:            c.Tr,
 		}
-		newContainer.ServiceName = container.Labels["com.docker.compose.service"]
-		newContainer.ProjectName = container.Labels["com.docker.compose.project"]
-		newContainer.ContainerNumber = container.Labels["com.docker.compose.container"]
-		newContainer.OneOff = container.Labels["com.docker.compose.oneoff"] == "True"
+	}
 
-		ownContainers[i] = newContainer
+	newContainer.Container = container
+	// if the container is made with a name label we will use that
+	if name, ok := container.Labels["name"]; ok {
+		newContainer.Name = name
+	} else {
+		newContainer.Name = strings.TrimLeft(container.Names[0], "/")
 	}
+	newContainer.ServiceName = container.Labels["com.docker.compose.service"]
+	newContainer.ProjectName = container.Labels["com.docker.compose.project"]
+	newContainer.ContainerNumber = container.Labels["com.docker.compose.container"]
+	newContainer.OneOff = container.Labels["com.docker.compose.oneoff"] == "True"
 
-	return ownContainers, nil
+	return newContainer
 }
 
 // GetServices gets services
@@ -351,6 +482,9 @@ func (c *DockerCommand) GetServices() ([]*Service, error) {
 		return nil, nil
 	}
 
+	span := c.OSCommand.Tracer.Start("compose", "get services")
+	defer span.End()
+
 	composeCommand := c.Config.UserConfig.CommandTemplates.DockerCompose
 	output, err := c.OSCommand.RunCommandWithOutput(fmt.Sprintf("%s config --hash=*", composeCommand))
 	if err != nil {
@@ -381,26 +515,62 @@ func (c *DockerCommand) GetServices() ([]*Service, error) {
 // this contains a bit more info than what you get from the go-docker client
 func (c *DockerCommand) UpdateContainerDetails() error {
 	c.ContainerMutex.Lock()
-	defer c.ContainerMutex.Unlock()
-
 	containers := c.Containers
+	c.ContainerMutex.Unlock()
+
+	if len(c.Endpoints) == 1 {
+		return c.updateContainerDetails(c.Endpoints[0], containers)
+	}
+
+	containersByEndpoint := make([][]*Container, len(c.Endpoints))
+	for _, container := range containers {
+		for i, endpoint := range c.Endpoints {
+			if container.Endpoint == endpoint {
+				containersByEndpoint[i] = append(containersByEndpoint[i], container)
+			}
+		}
+	}
+
+	return utils.ForEachConcurrently(len(c.Endpoints), len(c.Endpoints), func(i int) error {
+		if len(containersByEndpoint[i]) == 0 {
+			return nil
+		}
+		return c.updateContainerDetails(c.Endpoints[i], containersByEndpoint[i])
+	})
+}
+
+func (c *DockerCommand) updateContainerDetails(endpoint *Endpoint, containers []*Container) error {
+	span := c.OSCommand.Tracer.Start("inspect", "container details")
+	defer span.End()
 
 	ids := make([]string, len(containers))
 	for i, container := range containers {
 		ids[i] = container.ID
 	}
 
-	cmd := c.OSCommand.RunCustomCommand("docker inspect " + strings.Join(ids, " "))
+	// we don't hold the lock while docker inspect runs, which against a remote
+	// daemon can take a while, so that we can keep rendering what we've got
+	inspectSpan := c.OSCommand.Tracer.Start("inspect", "docker inspect")
+	cmd := endpoint.Prepare(c.OSCommand.RunCustomCommand("docker inspect " + strings.Join(ids, " ")))
 	output, err := cmd.CombinedOutput()
+	inspectSpan.End()
 	if err != nil {
 		return err
 	}
 
+	decodeSpan := c.OSCommand.Tracer.Start("decode", "decode container details")
 	var details []*Details
-	if err := json.Unmarshal(output, &details); err != nil {
+	err = json.Unmarshal(output, &details)
+	decodeSpan.End()
+	if err != nil {
 		return err
 	}
 
+	lockSpan := c.OSCommand.Tracer.Start("lock", "wait for container lock")
+	c.ContainerMutex.Lock()
+	lockSpan.End()
+	defer c.ContainerMutex.Unlock()
+
 	for i, container := range containers {
 		container.Details = *details[i]
 	}
@@ -424,11 +594,9 @@ func (c *DockerCommand) ViewAllLogs() (*exec.Cmd, error) {
 
 // DockerComposeConfig returns the result of 'docker-compose config'
 func (c *DockerCommand) DockerComposeConfig() string {
-	output, err := c.OSCommand.RunCommandWithOutput(
-		utils.ApplyTemplate(
-			c.OSCommand.Config.UserConfig.CommandTemplates.DockerComposeConfig,
-			c.NewCommandObject(CommandObject{}),
-		),
+	output, err := c.OSCommand.RunTemplateWithOutput(
+		c.OSCommand.Config.UserConfig.CommandTemplates.DockerComposeConfig,
+		c.NewCommandObject(CommandObject{}),
 	)
 
 	if err != nil {
@@ -0,0 +1,122 @@
+package commands
+
+import (
+	"crypto/sha256"
+	"fmt"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/jesseduffield/lazydocker/pkg/dockersim"
+	"github.com/stretchr/testify/assert"
+)
+
+// benchmarkSizes are the fleet sizes we benchmark against, from a laptop to a
+// busy build host
+var benchmarkSizes = []int{10, 100, 1000, 10000}
+
+func listedContainers(count int) []types.Container {
+	containers := make([]types.Container, count)
+	for i := range containers {
+		containers[i] = types.Container{
+			ID:    fmt.Sprintf("%x", sha256.Sum256([]byte(fmt.Sprint(i)))),
+			Names: []string{fmt.Sprintf("/project_service-%d_1", i)},
+			Labels: map[string]string{
+				"com.docker.compose.project": "project",
+				"com.docker.compose.service": fmt.Sprintf("service-%d", i),
+			},
+			State: "running",
+		}
+	}
+	return containers
+}
+
+// TestMatchContainers is a function.
+func TestMatchContainers(t *testing.T) {
+	c := NewDummyDockerCommand()
+	first, second := &Endpoint{Name: "first"}, &Endpoint{Name: "second"}
+	c.Endpoints = []*Endpoint{first, second}
+	listed := listedContainers(3)
+
+	existing := c.matchContainers(nil, [][]types.Container{listed[:2], listed[2:]}, []bool{false, false})
+	assert.Len(t, existing, 3)
+	existing[2].StatHistory = []RecordedStats{{}}
+
+	// the second endpoint missing a refresh mustn't lose its container, or we'd
+	// start over on its stats
+	matched := c.matchContainers(existing, [][]types.Container{listed[:1], nil}, []bool{false, true})
+	assert.EqualValues(t, []*Container{existing[0], existing[2]}, matched)
+
+	matched = c.matchContainers(matched, [][]types.Container{listed[:1], listed[2:]}, []bool{false, false})
+	assert.EqualValues(t, []*Container{existing[0], existing[2]}, matched)
+	assert.Len(t, matched[1].StatHistory, 1)
+}
+
+// BenchmarkMatchContainers matches a refreshed list of containers against the
+// ones we already have, which we do on every refresh
+func BenchmarkMatchContainers(b *testing.B) {
+	for _, size := range benchmarkSizes {
+		b.Run(fmt.Sprintf("%d containers", size), func(b *testing.B) {
+			c := NewDummyDockerCommand()
+			endpoint := &Endpoint{}
+			c.Endpoints = []*Endpoint{endpoint}
+			lists := [][]types.Container{listedContainers(size)}
+			failed := []bool{false}
+			existing := c.matchContainers(nil, lists, failed)
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				c.matchContainers(existing, lists, failed)
+			}
+		})
+	}
+}
+
+// BenchmarkGetContainers lists containers from a simulated daemon, so it
+// includes the request and decoding the response as well as the matching
+func BenchmarkGetContainers(b *testing.B) {
+	dir, err := ioutil.TempDir("", "lazydocker")
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer os.RemoveAll(dir)
+
+	for _, size := range benchmarkSizes {
+		b.Run(fmt.Sprintf("%d containers", size), func(b *testing.B) {
+			options := dockersim.DefaultOptions()
+			options.Containers = size
+			sim := dockersim.New(options)
+			if err := sim.Start(filepath.Join(dir, "docker.sock")); err != nil {
+				b.Fatal(err)
+			}
+			defer sim.Close()
+
+			endpoints, err := NewEndpoints([]config.EndpointConfig{{Host: sim.Host()}})
+			if err != nil {
+				b.Fatal(err)
+			}
+			c := NewDummyDockerCommand()
+			c.Endpoints = endpoints
+			c.Client = endpoints[0].Client
+
+			// after the first refresh, every container we list is one we have
+			if c.Containers, err = c.GetContainers(); err != nil {
+				b.Fatal(err)
+			}
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				containers, err := c.GetContainers()
+				if err != nil {
+					b.Fatal(err)
+				}
+				c.Containers = containers
+			}
+		})
+	}
+}
@@ -0,0 +1,264 @@
+package commands
+
+import (
+	"context"
+	"fmt"
+	"os"
+	"os/exec"
+	"sync"
+	"time"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/filters"
+	"github.com/docker/docker/client"
+	"github.com/fatih/color"
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// Endpoint is a docker daemon we're talking to. Usually there's just the one,
+// found through the environment, but you can configure several (e.g. a
+// rootless and a rootful daemon on the same machine) and we'll show the
+// containers, images and volumes of all of them at once
+type Endpoint struct {
+	Name string
+	// Host is what we'd set DOCKER_HOST to in order to talk to this daemon. It's
+	// empty for the daemon we get from the environment
+	Host string
+	// Client is for short requests and StreamClient is for requests that stay
+	// open, like stats and events, so that the two never compete for
+	// connections
+	Client       *client.Client
+	StreamClient *client.Client
+	// Prefix goes in front of the names of this endpoint's containers, images
+	// and volumes so you can tell which daemon they're from. It's empty if
+	// there's only the one endpoint
+	Prefix string
+	// Events streams this daemon's events. Each daemon only tells us about its
+	// own containers, images and volumes
+	Events *EventMonitor
+
+	mutex       sync.Mutex
+	latency     time.Duration
+	err         error
+	checked     bool
+	lastSuccess time.Time
+	requests    requestGroup
+	requestPool connectionPool
+	streamPool  connectionPool
+	tracer      *tracing.Tracer
+}
+
+// NewEndpoints returns an endpoint for each of the configured daemons, or just
+// the one from the environment if none have been configured
+func NewEndpoints(configs []config.EndpointConfig) ([]*Endpoint, error) {
+	if len(configs) == 0 {
+		configs = []config.EndpointConfig{{}}
+	}
+
+	endpoints := make([]*Endpoint, len(configs))
+	for i, endpointConfig := range configs {
+		name := endpointConfig.Name
+		if name == "" {
+			name = endpointConfig.Host
+		}
+		endpoint := &Endpoint{Name: name, Host: endpointConfig.Host}
+		if len(configs) > 1 {
+			endpoint.Prefix = name + ":"
+		}
+
+		var err error
+		endpoint.Client, err = newPooledClient(endpoint.Host, &endpoint.requestPool, requestIdleConnections, requestMaxConnections)
+		if err != nil {
+			return nil, err
+		}
+		// we have a stream per running container, so we don't cap these
+		endpoint.StreamClient, err = newPooledClient(endpoint.Host, &endpoint.streamPool, streamIdleConnections, 0)
+		if err != nil {
+			return nil, err
+		}
+
+		endpoints[i] = endpoint
+	}
+
+	return endpoints, nil
+}
+
+// Context returns the context to make a short request to the daemon with, so
+// that the request shows up in the endpoint's connection stats. It's fine to
+// call this on a nil endpoint
+func (e *Endpoint) Context() context.Context {
+	if e == nil {
+		return context.Background()
+	}
+	return e.requestPool.context()
+}
+
+// StreamContext is like Context, for requests made with the StreamClient
+func (e *Endpoint) StreamContext() context.Context {
+	if e == nil {
+		return context.Background()
+	}
+	return e.streamPool.context()
+}
+
+// Observe has the endpoint record how long the daemon takes to answer each
+// request into m, and spans of its requests into t. Either can be nil. It has
+// to be called before we make any requests
+func (e *Endpoint) Observe(m *metrics.Metrics, t *tracing.Tracer) {
+	e.requestPool.metrics = m
+	e.streamPool.metrics = m
+	e.requestPool.tracer = t
+	e.streamPool.tracer = t
+	e.tracer = t
+}
+
+// PoolStats returns how the endpoint's request and stream connection pools
+// are being used
+func (e *Endpoint) PoolStats() (requests PoolStats, streams PoolStats) {
+	return e.requestPool.Stats(), e.streamPool.Stats()
+}
+
+// Qualify puts the endpoint's prefix in front of the given name
+func (e *Endpoint) Qualify(name string) string {
+	if e == nil {
+		return name
+	}
+	return e.Prefix + name
+}
+
+// Prepare points a docker CLI command at this endpoint's daemon. Commands for
+// the daemon from the environment are left alone
+func (e *Endpoint) Prepare(cmd *exec.Cmd) *exec.Cmd {
+	if e == nil || e.Host == "" {
+		return cmd
+	}
+	if cmd.Env == nil {
+		cmd.Env = os.Environ()
+	}
+	cmd.Env = append(cmd.Env, "DOCKER_HOST="+e.Host)
+	return cmd
+}
+
+// record notes how our latest request to the daemon went, which we show next
+// to the endpoint's name
+func (e *Endpoint) record(start time.Time, err error) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+
+	e.latency = time.Since(start)
+	e.err = err
+	e.checked = true
+	if err == nil {
+		e.lastSuccess = time.Now()
+	}
+}
+
+// Health returns how long our latest request to the daemon took and the error
+// it failed with, if any. checked is false until we've made a request
+func (e *Endpoint) Health() (latency time.Duration, checked bool, err error) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+
+	return e.latency, e.checked, e.err
+}
+
+// GetDisplayString returns the endpoint's name along with a coloured dot for
+// whether we can reach it and how long it took to answer last time
+func (e *Endpoint) GetDisplayString() string {
+	latency, checked, err := e.Health()
+	switch {
+	case !checked:
+		return utils.ColoredString("● ", color.FgYellow) + e.Name
+	case err != nil:
+		return utils.ColoredString("● ", color.FgRed) + e.Name + utils.ColoredString(" down", color.FgRed)
+	default:
+		return utils.ColoredString("● ", color.FgGreen) + e.Name + fmt.Sprintf(" %dms", latency/time.Millisecond)
+	}
+}
+
+// listContainers lists every container on the daemon. If we're already waiting
+// on a list from an earlier refresh, we wait for that one instead of asking
+// again
+func (e *Endpoint) listContainers() ([]types.Container, error) {
+	span := e.tracer.Start("list", "list containers")
+	defer span.End()
+
+	result, err := e.requests.do("containers", func() (interface{}, error) {
+		return e.Client.ContainerList(e.Context(), types.ContainerListOptions{All: true})
+	})
+	containers, _ := result.([]types.Container)
+	return containers, err
+}
+
+// listImages is like listContainers, for images
+func (e *Endpoint) listImages() ([]types.ImageSummary, error) {
+	span := e.tracer.Start("list", "list images")
+	defer span.End()
+
+	result, err := e.requests.do("images", func() (interface{}, error) {
+		return e.Client.ImageList(e.Context(), types.ImageListOptions{})
+	})
+	images, _ := result.([]types.ImageSummary)
+	return images, err
+}
+
+// listVolumes is like listContainers, for volumes
+func (e *Endpoint) listVolumes() ([]*types.Volume, error) {
+	span := e.tracer.Start("list", "list volumes")
+	defer span.End()
+
+	result, err := e.requests.do("volumes", func() (interface{}, error) {
+		body, err := e.Client.VolumeList(e.Context(), filters.Args{})
+		return body.Volumes, err
+	})
+	volumes, _ := result.([]*types.Volume)
+	return volumes, err
+}
+
+// forEachEndpoint calls f for every endpoint at once, recording how long each
+// call took so that we can show the health of each endpoint. A daemon being
+// down shouldn't stop us showing what's on the others, so we only return an
+// error if every endpoint failed. Callers must ignore the results of any
+// endpoint for which failed[i] is true
+func forEachEndpoint(endpoints []*Endpoint, f func(int, *Endpoint) error) (failed []bool, err error) {
+	failed = make([]bool, len(endpoints))
+	err = utils.ForEachConcurrently(len(endpoints), len(endpoints), func(i int) error {
+		start := time.Now()
+		err := f(i, endpoints[i])
+		endpoints[i].record(start, err)
+		if err != nil {
+			failed[i] = true
+			return fmt.Errorf("%s: %v", endpoints[i].Name, err)
+		}
+		return nil
+	})
+
+	for _, endpointFailed := range failed {
+		if !endpointFailed {
+			return failed, nil
+		}
+	}
+	if len(endpoints) == 1 {
+		// keep the daemon's own error message when there's only the one endpoint
+		_, _, err := endpoints[0].Health()
+		return failed, err
+	}
+	return failed, err
+}
+
+// onEveryEndpoint calls f for every endpoint at once, for actions like pruning
+// that apply to everything we're showing. Unlike forEachEndpoint, every
+// endpoint's error is returned, labelled with its name if there's more than
+// one endpoint, so that the user knows which daemons it didn't work on
+func onEveryEndpoint(endpoints []*Endpoint, f func(*Endpoint) error) error {
+	return utils.ForEachConcurrently(len(endpoints), len(endpoints), func(i int) error {
+		err := f(endpoints[i])
+		if err != nil && len(endpoints) > 1 {
+			return fmt.Errorf("%s: %v", endpoints[i].Name, err)
+		}
+		return err
+	})
+}
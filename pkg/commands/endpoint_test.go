@@ -0,0 +1,157 @@
+package commands
+
+import (
+	"errors"
+	"os/exec"
+	"testing"
+
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestNewEndpoints is a function.
+func TestNewEndpoints(t *testing.T) {
+	endpoints, err := NewEndpoints(nil)
+	assert.NoError(t, err)
+	assert.Len(t, endpoints, 1)
+	assert.EqualValues(t, "web", endpoints[0].Qualify("web"))
+
+	endpoints, err = NewEndpoints([]config.EndpointConfig{
+		{Name: "rootful", Host: "unix:///var/run/docker.sock"},
+		{Host: "tcp://127.0.0.1:2375"},
+	})
+	assert.NoError(t, err)
+	assert.EqualValues(t, "rootful:web", endpoints[0].Qualify("web"))
+	assert.EqualValues(t, "tcp://127.0.0.1:2375:web", endpoints[1].Qualify("web"))
+
+	cmd := endpoints[0].Prepare(exec.Command("docker", "ps"))
+	assert.Contains(t, cmd.Env, "DOCKER_HOST=unix:///var/run/docker.sock")
+
+	_, err = NewEndpoints([]config.EndpointConfig{{Host: "not a host"}})
+	assert.Error(t, err)
+}
+
+// TestForEachEndpoint is a function.
+func TestForEachEndpoint(t *testing.T) {
+	type scenario struct {
+		testName       string
+		failures       []bool
+		expectedFailed []bool
+		expectedError  string
+	}
+
+	scenarios := []scenario{
+		{
+			"everything is up",
+			[]bool{false, false},
+			[]bool{false, false},
+			"",
+		},
+		{
+			"one daemon is down, so we keep going with the other",
+			[]bool{true, false},
+			[]bool{true, false},
+			"",
+		},
+		{
+			"every daemon is down",
+			[]bool{true, true},
+			[]bool{true, true},
+			"a: connection refused\nb: connection refused",
+		},
+		{
+			"the only daemon is down, so we keep its error as is",
+			[]bool{true},
+			[]bool{true},
+			"connection refused",
+		},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.testName, func(t *testing.T) {
+			names := []string{"a", "b"}
+			endpoints := make([]*Endpoint, len(s.failures))
+			for i := range endpoints {
+				endpoints[i] = &Endpoint{Name: names[i]}
+			}
+
+			failed, err := forEachEndpoint(endpoints, func(i int, endpoint *Endpoint) error {
+				if s.failures[i] {
+					return errors.New("connection refused")
+				}
+				return nil
+			})
+
+			assert.EqualValues(t, s.expectedFailed, failed)
+			if s.expectedError == "" {
+				assert.NoError(t, err)
+			} else {
+				assert.EqualError(t, err, s.expectedError)
+			}
+			for i, endpoint := range endpoints {
+				_, checked, endpointErr := endpoint.Health()
+				assert.True(t, checked)
+				assert.EqualValues(t, s.failures[i], endpointErr != nil)
+			}
+		})
+	}
+}
+
+// TestOnEveryEndpoint is a function.
+func TestOnEveryEndpoint(t *testing.T) {
+	type scenario struct {
+		testName      string
+		failures      []bool
+		expectedError string
+	}
+
+	scenarios := []scenario{
+		{
+			"everything is up",
+			[]bool{false, false},
+			"",
+		},
+		{
+			"one daemon is down, which we say even though the other worked",
+			[]bool{false, true},
+			"b: connection refused",
+		},
+		{
+			"the only daemon is down, so we keep its error as is",
+			[]bool{true},
+			"connection refused",
+		},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.testName, func(t *testing.T) {
+			names := []string{"a", "b"}
+			endpoints := make([]*Endpoint, len(s.failures))
+			for i := range endpoints {
+				endpoints[i] = &Endpoint{Name: names[i]}
+			}
+
+			called := make([]bool, len(endpoints))
+			err := onEveryEndpoint(endpoints, func(endpoint *Endpoint) error {
+				for i := range endpoints {
+					if endpoints[i] == endpoint {
+						called[i] = true
+						if s.failures[i] {
+							return errors.New("connection refused")
+						}
+					}
+				}
+				return nil
+			})
+
+			for i := range endpoints {
+				assert.True(t, called[i])
+			}
+			if s.expectedError == "" {
+				assert.NoError(t, err)
+			} else {
+				assert.EqualError(t, err, s.expectedError)
+			}
+		})
+	}
+}
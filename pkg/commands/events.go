@@ -0,0 +1,107 @@
+package commands
+
+import (
+	"context"
+	"fmt"
+	"sync"
+	"time"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/events"
+	"github.com/docker/docker/client"
+	"github.com/sirupsen/logrus"
+)
+
+// builderEventType is the event type the daemon uses for the build cache. Our
+// vendored client predates it so it has no constant for it
+const builderEventType = "builder"
+
+// eventsReconnectInterval is how long we wait before reconnecting to the event
+// stream if it drops out, e.g. because the daemon was restarted
+const eventsReconnectInterval = time.Second * 5
+
+// EventMonitor streams events from the docker daemon and hands each of them to
+// whoever has subscribed, so that we can refresh things when they've actually
+// changed rather than polling for them
+type EventMonitor struct {
+	Log         *logrus.Entry
+	Client      *client.Client
+	mutex       sync.Mutex
+	subscribers []func(events.Message)
+	startOnce   sync.Once
+	lastEvent   int64
+	counts      map[string]int
+}
+
+// NewEventMonitor returns a new EventMonitor. Nothing is streamed until Start
+// is called
+func NewEventMonitor(log *logrus.Entry, client *client.Client) *EventMonitor {
+	return &EventMonitor{
+		Log:    log,
+		Client: client,
+		counts: map[string]int{},
+	}
+}
+
+// Subscribe registers f to be called with every event we receive. f is called
+// on the monitor's goroutine so it shouldn't block
+func (m *EventMonitor) Subscribe(f func(events.Message)) {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	m.subscribers = append(m.subscribers, f)
+}
+
+// Start starts streaming events in the background. It only does anything the
+// first time it's called
+func (m *EventMonitor) Start() {
+	m.startOnce.Do(func() {
+		go m.monitor()
+	})
+}
+
+func (m *EventMonitor) monitor() {
+	for {
+		options := types.EventsOptions{}
+		// if we're reconnecting, we ask for whatever we missed in the meantime
+		if m.lastEvent > 0 {
+			options.Since = fmt.Sprintf("%d.%09d", m.lastEvent/int64(time.Second), m.lastEvent%int64(time.Second))
+		}
+
+		messages, errs := m.Client.Events(context.Background(), options)
+	stream:
+		for {
+			select {
+			case message := <-messages:
+				m.lastEvent = message.TimeNano
+				m.publish(message)
+			case err := <-errs:
+				m.Log.Warn(err)
+				break stream
+			}
+		}
+
+		time.Sleep(eventsReconnectInterval)
+	}
+}
+
+// Version returns how many events of the given type (e.g. 'volume') we've
+// seen, so that callers can poll it cheaply to see whether they need to
+// refresh anything of that type
+func (m *EventMonitor) Version(eventType string) int {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	return m.counts[eventType]
+}
+
+func (m *EventMonitor) publish(message events.Message) {
+	m.mutex.Lock()
+	m.counts[message.Type]++
+	subscribers := m.subscribers
+	m.mutex.Unlock()
+
+	for _, subscriber := range subscribers {
+		subscriber(message)
+	}
+}
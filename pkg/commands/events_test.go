@@ -0,0 +1,44 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types/events"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestEventMonitorPublish is a function.
+func TestEventMonitorPublish(t *testing.T) {
+	m := NewEventMonitor(NewDummyLog(), nil)
+
+	received := []string{}
+	m.Subscribe(func(message events.Message) {
+		received = append(received, message.Type+" "+message.Action)
+	})
+
+	m.publish(events.Message{Type: events.VolumeEventType, Action: "create"})
+	m.publish(events.Message{Type: events.VolumeEventType, Action: "destroy"})
+	m.publish(events.Message{Type: events.ImageEventType, Action: "pull"})
+
+	assert.EqualValues(t, []string{"volume create", "volume destroy", "image pull"}, received)
+	assert.EqualValues(t, 2, m.Version(events.VolumeEventType))
+	assert.EqualValues(t, 1, m.Version(events.ImageEventType))
+	assert.EqualValues(t, 0, m.Version(events.NetworkEventType))
+}
+
+// TestEventVersion is a function.
+func TestEventVersion(t *testing.T) {
+	local := &Endpoint{Events: NewEventMonitor(NewDummyLog(), nil)}
+	remote := &Endpoint{Events: NewEventMonitor(NewDummyLog(), nil)}
+	c := &DockerCommand{Endpoints: []*Endpoint{local, remote}}
+
+	assert.EqualValues(t, 0, c.EventVersion(events.VolumeEventType))
+
+	// a volume created on any endpoint should be noticed, not just the first
+	remote.Events.publish(events.Message{Type: events.VolumeEventType, Action: "create"})
+	assert.EqualValues(t, 1, c.EventVersion(events.VolumeEventType))
+
+	local.Events.publish(events.Message{Type: events.VolumeEventType, Action: "destroy"})
+	assert.EqualValues(t, 2, c.EventVersion(events.VolumeEventType))
+	assert.EqualValues(t, 0, c.EventVersion(events.ImageEventType))
+}
@@ -2,7 +2,9 @@ package commands
 
 import (
 	"context"
+	"fmt"
 	"github.com/docker/docker/api/types/image"
+	"sort"
 	"strings"
 
 	"github.com/docker/docker/api/types"
@@ -19,21 +21,96 @@ type Image struct {
 	Tag           string
 	ID            string
 	Image         types.ImageSummary
+	Endpoint      *Endpoint
 	Client        *client.Client
 	OSCommand     *OSCommand
 	Log           *logrus.Entry
 	DockerCommand LimitedDockerCommand
+	// LayerUsage is nil until we've worked out which of the image's layers are
+	// shared with other images
+	LayerUsage *ImageLayerUsage
+	// ContainerCount is how many containers (running or not) use the image
+	ContainerCount int
+}
+
+// SearchKey identifies the image and what SearchRow is built from
+func (i *Image) SearchKey() string {
+	return i.Endpoint.Qualify(i.ID) + " " + i.Name + ":" + i.Tag
+}
+
+// SearchRow returns what we match against when the images panel is
+// filtered: the image's name, tag and labels
+func (i *Image) SearchRow() utils.SearchRow {
+	return utils.NewSearchRow([]string{i.Endpoint.Qualify(i.Name), i.Tag}, i.Image.Labels)
+}
+
+// UsageKey is what the usage index knows the image by
+func (i *Image) UsageKey() string {
+	return i.Endpoint.Qualify(i.ID)
 }
 
 // GetDisplayStrings returns the display string of Image
 func (i *Image) GetDisplayStrings(isFocused bool) []string {
+	inUse := ""
+	if i.ContainerCount > 0 {
+		inUse = utils.ColoredString(fmt.Sprintf("%d", i.ContainerCount), color.FgGreen)
+	}
 
-	return []string{i.Name, i.Tag, utils.FormatDecimalBytes(int(i.Image.Size))}
+	if i.LayerUsage == nil {
+		return []string{i.Endpoint.Qualify(i.Name), i.Tag, inUse, utils.FormatDecimalBytes(int(i.Image.Size)), "", ""}
+	}
+
+	return []string{
+		i.Endpoint.Qualify(i.Name),
+		i.Tag,
+		inUse,
+		utils.FormatDecimalBytes(int(i.LayerUsage.Total)),
+		utils.ColoredString(utils.FormatDecimalBytes(int(i.LayerUsage.Shared)), color.FgBlue),
+		utils.ColoredString(utils.FormatDecimalBytes(int(i.LayerUsage.Unique)), color.FgYellow),
+	}
+}
+
+// Ways of sorting images. By default we keep the order the daemon gives us,
+// which is newest first
+const (
+	ImageSortDefault = ""
+	ImageSortTotal   = "total"
+	ImageSortShared  = "shared"
+	ImageSortUnique  = "unique"
+)
+
+// SortImages sorts images biggest first by the given size. Images whose layer
+// usage we don't know yet go at the end
+func SortImages(images []*Image, sortBy string) {
+	size := func(i *Image) int64 {
+		switch sortBy {
+		case ImageSortTotal:
+			return i.LayerUsage.Total
+		case ImageSortShared:
+			return i.LayerUsage.Shared
+		default:
+			return i.LayerUsage.Unique
+		}
+	}
+
+	if sortBy == ImageSortDefault {
+		sort.SliceStable(images, func(a, b int) bool {
+			return images[a].Image.Created > images[b].Image.Created
+		})
+		return
+	}
+
+	sort.SliceStable(images, func(a, b int) bool {
+		if images[a].LayerUsage == nil || images[b].LayerUsage == nil {
+			return images[b].LayerUsage == nil && images[a].LayerUsage != nil
+		}
+		return size(images[a]) > size(images[b])
+	})
 }
 
 // Remove removes the image
 func (i *Image) Remove(options types.ImageRemoveOptions) error {
-	if _, err := i.Client.ImageRemove(context.Background(), i.ID, options); err != nil {
+	if _, err := i.Client.ImageRemove(i.Endpoint.Context(), i.ID, options); err != nil {
 		return err
 	}
 
@@ -87,8 +164,11 @@ func (l *Layer) GetDisplayStrings(isFocused bool) []string {
 
 // RenderHistory renders the history of the image
 func (i *Image) RenderHistory() (string, error) {
+	return renderImageHistory(i.Client, i.ID)
+}
 
-	history, err := i.Client.ImageHistory(context.Background(), i.ID)
+func renderImageHistory(client *client.Client, imageID string) (string, error) {
+	history, err := client.ImageHistory(context.Background(), imageID)
 	if err != nil {
 		return "", err
 	}
@@ -103,47 +183,80 @@ func (i *Image) RenderHistory() (string, error) {
 
 // RefreshImages returns a slice of docker images
 func (c *DockerCommand) RefreshImages() ([]*Image, error) {
-	images, err := c.Client.ImageList(context.Background(), types.ImageListOptions{})
+	imageLists := make([][]types.ImageSummary, len(c.Endpoints))
+	failed, err := forEachEndpoint(c.Endpoints, func(i int, endpoint *Endpoint) error {
+		images, err := endpoint.listImages()
+		imageLists[i] = images
+		return err
+	})
 	if err != nil {
 		return nil, err
 	}
 
-	ownImages := make([]*Image, len(images))
+	c.listMutex.Lock()
+	defer c.listMutex.Unlock()
 
-	for i, image := range images {
-		// func (cli *Client) ImageHistory(ctx context.Context, imageID string) ([]image.HistoryResponseItem, error)
+	ownImages := []*Image{}
 
-		firstTag := ""
-		tags := image.RepoTags
-		if len(tags) > 0 {
-			firstTag = tags[0]
+	for endpointIndex, images := range imageLists {
+		endpoint := c.Endpoints[endpointIndex]
+		// we keep showing what we had for an endpoint that failed to answer
+		if failed[endpointIndex] {
+			for _, image := range c.lastImages {
+				if image.Endpoint == endpoint {
+					ownImages = append(ownImages, image)
+				}
+			}
+			continue
 		}
-
-		nameParts := strings.Split(firstTag, ":")
-		tag := ""
-		name := "none"
-		if len(nameParts) > 1 {
-			tag = nameParts[len(nameParts)-1]
-			name = strings.Join(nameParts[:len(nameParts)-1], ":")
-		}
-
-		ownImages[i] = &Image{
-			ID:            image.ID,
-			Name:          name,
-			Tag:           tag,
-			Image:         image,
-			Client:        c.Client,
-			OSCommand:     c.OSCommand,
-			Log:           c.Log,
-			DockerCommand: c,
+		for _, image := range images {
+			ownImages = append(ownImages, c.newImage(endpoint, image))
 		}
 	}
 
+	c.lastImages = ownImages
 	return ownImages, nil
 }
 
-// PruneImages prunes images
+func (c *DockerCommand) newImage(endpoint *Endpoint, image types.ImageSummary) *Image {
+	firstTag := ""
+	tags := image.RepoTags
+	if len(tags) > 0 {
+		firstTag = tags[0]
+	}
+
+	nameParts := strings.Split(firstTag, ":")
+	tag := ""
+	name := "none"
+	if len(nameParts) > 1 {
+		tag = nameParts[len(nameParts)-1]
+		name = strings.Join(nameParts[:len(nameParts)-1], ":")
+	}
+
+	// we only work out the shared layers of images on the first endpoint
+	var layerUsage *ImageLayerUsage
+	if c.OnFirstEndpoint(endpoint) {
+		layerUsage = c.Layers.usageRef(image.ID)
+	}
+
+	return &Image{
+		ID:            image.ID,
+		Name:          name,
+		Tag:           tag,
+		Image:         image,
+		LayerUsage:    layerUsage,
+		Endpoint:      endpoint,
+		Client:        endpoint.Client,
+		OSCommand:     c.OSCommand,
+		Log:           c.Log,
+		DockerCommand: c,
+	}
+}
+
+// PruneImages prunes images on every endpoint
 func (c *DockerCommand) PruneImages() error {
-	_, err := c.Client.ImagesPrune(context.Background(), filters.Args{})
-	return err
+	return onEveryEndpoint(c.Endpoints, func(endpoint *Endpoint) error {
+		_, err := endpoint.Client.ImagesPrune(endpoint.Context(), filters.Args{})
+		return err
+	})
 }
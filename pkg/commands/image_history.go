@@ -0,0 +1,98 @@
+package commands
+
+import (
+	"sync"
+
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// imageHistoryCacheSize is how many images we keep the rendered history of
+const imageHistoryCacheSize = 256
+
+// imageHistoryPrefetchConcurrency is how many histories we fetch at once when
+// prefetching
+const imageHistoryPrefetchConcurrency = 4
+
+// historyFetch is a history we're in the middle of fetching. Anyone else who
+// wants it waits for done and then takes its result, whether or not it failed
+type historyFetch struct {
+	done   chan struct{}
+	output string
+	err    error
+}
+
+// ImageHistoryCache holds on to the rendered history of recently viewed
+// images. An image's ID is the hash of its contents, so its history never
+// changes and we never need to invalidate anything. If someone asks for a
+// history that's already being fetched (e.g. by a prefetch) they wait for that
+// rather than fetching it again. We don't cache errors, which are usually the
+// daemon having a bad moment, so the next render or prefetch tries again.
+type ImageHistoryCache struct {
+	mutex   sync.Mutex
+	cache   *utils.LRU
+	pending map[string]*historyFetch
+	render  func(imageID string) (string, error)
+}
+
+// NewImageHistoryCache returns a new ImageHistoryCache which renders histories
+// with the given function
+func NewImageHistoryCache(render func(imageID string) (string, error)) *ImageHistoryCache {
+	return &ImageHistoryCache{
+		cache:   utils.NewLRU(imageHistoryCacheSize),
+		pending: map[string]*historyFetch{},
+		render:  render,
+	}
+}
+
+// Render returns the rendered history of the given image, fetching it if we
+// don't have it yet
+func (c *ImageHistoryCache) Render(imageID string) (string, error) {
+	if value, ok := c.cache.Get(imageID); ok {
+		return value.(string), nil
+	}
+
+	c.mutex.Lock()
+	fetch, ok := c.pending[imageID]
+	if ok {
+		c.mutex.Unlock()
+		// someone else is already fetching it
+		<-fetch.done
+		return fetch.output, fetch.err
+	}
+	fetch = &historyFetch{done: make(chan struct{})}
+	c.pending[imageID] = fetch
+	c.mutex.Unlock()
+
+	fetch.output, fetch.err = c.render(imageID)
+	if fetch.err == nil {
+		c.cache.Add(imageID, fetch.output)
+	}
+
+	c.mutex.Lock()
+	delete(c.pending, imageID)
+	c.mutex.Unlock()
+	close(fetch.done)
+
+	return fetch.output, fetch.err
+}
+
+// Prefetch fetches the histories of the given images in the background, so
+// that they're ready by the time the user gets to them
+func (c *ImageHistoryCache) Prefetch(imageIDs []string) {
+	missing := []string{}
+	for _, id := range imageIDs {
+		if !c.cache.Contains(id) {
+			missing = append(missing, id)
+		}
+	}
+	if len(missing) == 0 {
+		return
+	}
+
+	go func() {
+		_ = utils.ForEachConcurrently(len(missing), imageHistoryPrefetchConcurrency, func(i int) error {
+			_, _ = c.Render(missing[i])
+			return nil
+		})
+	}()
+}
@@ -0,0 +1,61 @@
+package commands
+
+import (
+	"errors"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestImageHistoryCache is a function.
+func TestImageHistoryCache(t *testing.T) {
+	var mutex sync.Mutex
+	calls := map[string]int{}
+	cache := NewImageHistoryCache(func(imageID string) (string, error) {
+		mutex.Lock()
+		calls[imageID]++
+		mutex.Unlock()
+		// giving the other callers a chance to ask for the same image
+		time.Sleep(time.Millisecond * 10)
+		return "history of " + imageID, nil
+	})
+
+	var wg sync.WaitGroup
+	for i := 0; i < 5; i++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			output, err := cache.Render("abc")
+			assert.NoError(t, err)
+			assert.EqualValues(t, "history of abc", output)
+		}()
+	}
+	wg.Wait()
+
+	output, _ := cache.Render("abc")
+	assert.EqualValues(t, "history of abc", output)
+	assert.EqualValues(t, 1, calls["abc"])
+}
+
+// TestImageHistoryCacheError is a function.
+func TestImageHistoryCacheError(t *testing.T) {
+	calls := 0
+	cache := NewImageHistoryCache(func(imageID string) (string, error) {
+		calls++
+		if calls == 1 {
+			return "", errors.New("daemon went away")
+		}
+		return "history of " + imageID, nil
+	})
+
+	_, err := cache.Render("abc")
+	assert.EqualError(t, err, "daemon went away")
+
+	// the error isn't cached, so we ask again
+	output, err := cache.Render("abc")
+	assert.NoError(t, err)
+	assert.EqualValues(t, "history of abc", output)
+	assert.EqualValues(t, 2, calls)
+}
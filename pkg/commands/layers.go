@@ -0,0 +1,240 @@
+package commands
+
+import (
+	"context"
+	"crypto/sha256"
+	"fmt"
+	"strings"
+	"sync"
+
+	"github.com/docker/docker/api/types/image"
+	"github.com/docker/docker/client"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+	"github.com/sirupsen/logrus"
+)
+
+// layerFetchConcurrency is how many images we inspect at once when building
+// the layer graph. The first time round that's every image on the host
+const layerFetchConcurrency = 8
+
+// ImageLayerUsage is how an image's size breaks down once we account for the
+// layers it has in common with other images. Unique is what we'd get back by
+// removing the image, Shared is what we wouldn't.
+type ImageLayerUsage struct {
+	Total  int64
+	Shared int64
+	Unique int64
+}
+
+// imageLayers is the chain of layers an image is built from, base layer first.
+// Layers are identified by their chain ID, which covers the layer's contents
+// and those of every layer beneath it, so two images have a layer in common
+// only if they were built on the same base
+type imageLayers struct {
+	chainIDs []string
+	sizes    []int64
+}
+
+// LayerGraph is a content-addressed graph of the layers our images are built
+// from. Image IDs are content-addressed too, so an image's layers never change
+// and we only ever fetch them once per image.
+type LayerGraph struct {
+	Log         *logrus.Entry
+	Client      *client.Client
+	mutex       sync.Mutex
+	updateMutex sync.Mutex
+	images      map[string]*imageLayers
+	usage       map[string]ImageLayerUsage
+}
+
+// NewLayerGraph returns a new LayerGraph
+func NewLayerGraph(log *logrus.Entry, client *client.Client) *LayerGraph {
+	return &LayerGraph{
+		Log:    log,
+		Client: client,
+		images: map[string]*imageLayers{},
+		usage:  map[string]ImageLayerUsage{},
+	}
+}
+
+// Usage returns the layer usage of the given image, if we know it yet
+func (g *LayerGraph) Usage(imageID string) (ImageLayerUsage, bool) {
+	g.mutex.Lock()
+	defer g.mutex.Unlock()
+
+	usage, ok := g.usage[imageID]
+	return usage, ok
+}
+
+// usageRef is like Usage but returns nil if we don't know the usage yet
+func (g *LayerGraph) usageRef(imageID string) *ImageLayerUsage {
+	usage, ok := g.Usage(imageID)
+	if !ok {
+		return nil
+	}
+	return &usage
+}
+
+// Update brings the graph in line with the given images, fetching the layers
+// of any we haven't seen before and forgetting those that have gone. It
+// returns true if the usage of any image has changed as a result
+func (g *LayerGraph) Update(imageIDs []string) bool {
+	// one update at a time, so that we're not fetching the same image twice
+	g.updateMutex.Lock()
+	defer g.updateMutex.Unlock()
+
+	g.mutex.Lock()
+	missing := []string{}
+	for _, id := range imageIDs {
+		if _, ok := g.images[id]; !ok {
+			missing = append(missing, id)
+		}
+	}
+	g.mutex.Unlock()
+
+	fetched := make([]*imageLayers, len(missing))
+	_ = utils.ForEachConcurrently(len(missing), layerFetchConcurrency, func(i int) error {
+		layers, err := g.fetch(missing[i])
+		if err != nil {
+			// the image has probably been removed since we listed it
+			g.Log.Warn(err)
+			return nil
+		}
+		fetched[i] = layers
+		return nil
+	})
+
+	g.mutex.Lock()
+	defer g.mutex.Unlock()
+
+	for i, layers := range fetched {
+		if layers != nil {
+			g.images[missing[i]] = layers
+		}
+	}
+
+	current := make(map[string]*imageLayers, len(imageIDs))
+	for _, id := range imageIDs {
+		if layers, ok := g.images[id]; ok {
+			current[id] = layers
+		}
+	}
+	g.images = current
+
+	usage := layerUsage(current)
+	changed := len(usage) != len(g.usage)
+	for id, u := range usage {
+		if g.usage[id] != u {
+			changed = true
+			break
+		}
+	}
+	g.usage = usage
+
+	return changed
+}
+
+func (g *LayerGraph) fetch(imageID string) (*imageLayers, error) {
+	inspect, _, err := g.Client.ImageInspectWithRaw(context.Background(), imageID)
+	if err != nil {
+		return nil, err
+	}
+
+	history, err := g.Client.ImageHistory(context.Background(), imageID)
+	if err != nil {
+		return nil, err
+	}
+
+	return &imageLayers{
+		chainIDs: chainIDs(inspect.RootFS.Layers),
+		sizes:    layerSizes(len(inspect.RootFS.Layers), history),
+	}, nil
+}
+
+// layerUsage works out each image's usage from the layers it's built from. A
+// layer used by more than one image counts as shared for all of them.
+func layerUsage(images map[string]*imageLayers) map[string]ImageLayerUsage {
+	refCounts := map[string]int{}
+	for _, layers := range images {
+		for _, chainID := range layers.chainIDs {
+			refCounts[chainID]++
+		}
+	}
+
+	usage := make(map[string]ImageLayerUsage, len(images))
+	for id, layers := range images {
+		u := ImageLayerUsage{}
+		for i, chainID := range layers.chainIDs {
+			u.Total += layers.sizes[i]
+			if refCounts[chainID] > 1 {
+				u.Shared += layers.sizes[i]
+			} else {
+				u.Unique += layers.sizes[i]
+			}
+		}
+		usage[id] = u
+	}
+	return usage
+}
+
+// chainIDs turns an image's diff IDs into chain IDs, the same way the daemon
+// does: the base layer's chain ID is its diff ID, and every layer above that is
+// identified by the hash of its parent's chain ID and its own diff ID
+func chainIDs(diffIDs []string) []string {
+	result := make([]string, len(diffIDs))
+	for i, diffID := range diffIDs {
+		if i == 0 {
+			result[i] = diffID
+			continue
+		}
+		result[i] = fmt.Sprintf("sha256:%x", sha256.Sum256([]byte(result[i-1]+" "+diffID)))
+	}
+	return result
+}
+
+// layerSizes works out the size of each of an image's layers from its history.
+// The history has an entry for every step of the build, newest first, but not
+// every step creates a layer and the API we target doesn't tell us which did.
+// Any step with a size did. The classic builder also creates a layer for every
+// step that isn't a metadata-only '#(nop)' one, even if it's empty, but
+// BuildKit only creates layers for steps that changed something, so its empty
+// steps are just metadata. An image can have steps from both, e.g. when it's
+// built with BuildKit on top of an older base image. If that still doesn't
+// line up with the number of layers we pad or trim empty layers at the top,
+// which doesn't change any of the sizes.
+func layerSizes(layerCount int, history []image.HistoryResponseItem) []int64 {
+	sizes := []int64{}
+	for i := len(history) - 1; i >= 0; i-- {
+		item := history[i]
+		if item.Size > 0 || isEmptyClassicLayer(item.CreatedBy) {
+			sizes = append(sizes, item.Size)
+		}
+	}
+
+	// trimming zero-sized layers, starting from the top
+	for i := len(sizes) - 1; i >= 0 && len(sizes) > layerCount; i-- {
+		if sizes[i] == 0 {
+			sizes = append(sizes[:i], sizes[i+1:]...)
+		}
+	}
+
+	for len(sizes) < layerCount {
+		sizes = append(sizes, 0)
+	}
+	return sizes[:layerCount]
+}
+
+// isEmptyClassicLayer tells us whether an empty build step created a layer,
+// which is only the case for the classic builder's non-'#(nop)' steps. Those
+// look like '/bin/sh -c make' or '|1 VERSION=2 /bin/sh -c make', whereas
+// BuildKit's steps start with their instruction, e.g. 'RUN /bin/sh -c make #
+// buildkit' or 'ENV FOO=bar'
+func isEmptyClassicLayer(createdBy string) bool {
+	if createdBy == "" || strings.Contains(createdBy, "#(nop)") {
+		return false
+	}
+	// an instruction is a word in capitals, which '|1' and '/bin/sh' aren't
+	first := strings.Fields(createdBy)[0]
+	isInstruction := first == strings.ToUpper(first) && first != strings.ToLower(first)
+	return !isInstruction
+}
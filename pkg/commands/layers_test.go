@@ -0,0 +1,150 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types/image"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestChainIDs is a function.
+func TestChainIDs(t *testing.T) {
+	assert.EqualValues(t, []string{
+		"sha256:aaa",
+		"sha256:56efb1d4f6c79b745d37d6eff87e3ed8dd2be28104e124ba73fd6e6c4892c792",
+	}, chainIDs([]string{"sha256:aaa", "sha256:bbb"}))
+
+	// the same diff on a different base is a different layer
+	assert.NotEqual(t, chainIDs([]string{"sha256:aaa", "sha256:bbb"})[1], chainIDs([]string{"sha256:ccc", "sha256:bbb"})[1])
+}
+
+// TestLayerSizes is a function.
+func TestLayerSizes(t *testing.T) {
+	type scenario struct {
+		layerCount int
+		history    []image.HistoryResponseItem
+		expected   []int64
+	}
+
+	scenarios := []scenario{
+		{
+			2,
+			[]image.HistoryResponseItem{
+				{CreatedBy: `/bin/sh -c #(nop)  CMD ["sh"]`},
+				{CreatedBy: "/bin/sh -c apk add curl", Size: 30},
+				{CreatedBy: "/bin/sh -c #(nop) ADD file:abc in / ", Size: 50},
+			},
+			[]int64{50, 30},
+		},
+		{
+			// a RUN step that didn't change anything still gets a layer
+			3,
+			[]image.HistoryResponseItem{
+				{CreatedBy: "/bin/sh -c touch -c /nothing"},
+				{CreatedBy: "/bin/sh -c #(nop) ENV FOO=bar"},
+				{CreatedBy: "/bin/sh -c #(nop) ADD file:abc in / ", Size: 50},
+				{CreatedBy: "/bin/sh -c #(nop) ADD file:def in / ", Size: 10},
+			},
+			[]int64{10, 50, 0},
+		},
+		{
+			// buildkit doesn't use #(nop) so we can't tell which steps were
+			// metadata-only, but trimming the empty ones sorts that out
+			2,
+			[]image.HistoryResponseItem{
+				{CreatedBy: `CMD ["sh"]`},
+				{CreatedBy: "RUN apk add curl", Size: 30},
+				{CreatedBy: "WORKDIR /app"},
+				{CreatedBy: "ADD file:abc in / ", Size: 50},
+			},
+			[]int64{50, 30},
+		},
+		{
+			// an empty BuildKit step is metadata, even if it's a RUN or COPY, so
+			// the empty layer from copying an empty file is the top one
+			3,
+			[]image.HistoryResponseItem{
+				{CreatedBy: `CMD ["node" "server.js"]`, Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "EXPOSE map[3000/tcp:{}]", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "COPY .env.example /app/.env # buildkit", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "RUN |1 NODE_ENV=production /bin/sh -c npm ci # buildkit", Size: 30, Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "RUN /bin/sh -c true # buildkit", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "ARG NODE_ENV=production", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "WORKDIR /app", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "ENV NODE_VERSION=18.17.0", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "/bin/sh -c #(nop) ADD file:abc in / ", Size: 50},
+			},
+			[]int64{50, 30, 0},
+		},
+		{
+			// BuildKit on top of a base image from the classic builder, whose
+			// empty RUN steps still got layers
+			4,
+			[]image.HistoryResponseItem{
+				{CreatedBy: "LABEL org.opencontainers.image.source=https://example.com", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "COPY . /app # buildkit", Size: 20, Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: "ENV PATH=/app/bin:/usr/local/bin:/usr/bin:/bin", Comment: "buildkit.dockerfile.v0"},
+				{CreatedBy: `/bin/sh -c #(nop)  CMD ["sh"]`},
+				{CreatedBy: "|1 VERSION=2 /bin/sh -c mkdir -p /data"},
+				{CreatedBy: "/bin/sh -c apk add curl", Size: 30},
+				{CreatedBy: "/bin/sh -c #(nop) ADD file:abc in / ", Size: 50},
+			},
+			[]int64{50, 30, 0, 20},
+		},
+		{
+			2,
+			[]image.HistoryResponseItem{},
+			[]int64{0, 0},
+		},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, layerSizes(s.layerCount, s.history))
+	}
+}
+
+// TestLayerUsage is a function.
+func TestLayerUsage(t *testing.T) {
+	base := chainIDs([]string{"sha256:base"})
+	app := chainIDs([]string{"sha256:base", "sha256:app"})
+	worker := chainIDs([]string{"sha256:base", "sha256:worker"})
+	other := chainIDs([]string{"sha256:other", "sha256:app"})
+
+	usage := layerUsage(map[string]*imageLayers{
+		"base":   {chainIDs: base, sizes: []int64{100}},
+		"app":    {chainIDs: app, sizes: []int64{100, 20}},
+		"worker": {chainIDs: worker, sizes: []int64{100, 5}},
+		"other":  {chainIDs: other, sizes: []int64{70, 20}},
+	})
+
+	assert.EqualValues(t, map[string]ImageLayerUsage{
+		"base":   {Total: 100, Shared: 100, Unique: 0},
+		"app":    {Total: 120, Shared: 100, Unique: 20},
+		"worker": {Total: 105, Shared: 100, Unique: 5},
+		// same diff as app's top layer, but on a different base
+		"other": {Total: 90, Shared: 0, Unique: 90},
+	}, usage)
+}
+
+// TestSortImages is a function.
+func TestSortImages(t *testing.T) {
+	images := []*Image{
+		{ID: "a", LayerUsage: &ImageLayerUsage{Total: 100, Shared: 90, Unique: 10}},
+		{ID: "b"},
+		{ID: "c", LayerUsage: &ImageLayerUsage{Total: 50, Shared: 0, Unique: 50}},
+	}
+
+	ids := func() []string {
+		result := []string{}
+		for _, image := range images {
+			result = append(result, image.ID)
+		}
+		return result
+	}
+
+	SortImages(images, ImageSortTotal)
+	assert.EqualValues(t, []string{"a", "c", "b"}, ids())
+
+	SortImages(images, ImageSortUnique)
+	assert.EqualValues(t, []string{"c", "a", "b"}, ids())
+}
@@ -2,6 +2,7 @@ package commands
 
 import (
 	"fmt"
+	"io"
 	"io/ioutil"
 	"os"
 	"os/exec"
@@ -13,6 +14,8 @@ import (
 	"github.com/go-errors/errors"
 
 	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
 	"github.com/jesseduffield/lazydocker/pkg/utils"
 	"github.com/mgutz/str"
 	"github.com/sirupsen/logrus"
@@ -36,8 +39,27 @@ type OSCommand struct {
 	Config   *config.AppConfig
 	command  func(string, ...string) *exec.Cmd
 	getenv   func(string) string
+
+	// argvCache holds the argv we've split each command string into. We run the
+	// same handful of commands over and over (e.g. the logs command each time
+	// you select a container) so there's no point parsing them every time
+	argvCache map[string][]string
+	argvMutex sync.Mutex
+
+	// Metrics is where we record how long things take for the internals tab.
+	// It's nil unless the tab is switched on
+	Metrics *metrics.Metrics
+
+	// Tracer records spans of what our refreshes spend their time on. It's nil
+	// unless lazydocker was started with --spans
+	Tracer *tracing.Tracer
 }
 
+// maxCachedArgvs is how many command strings we hold on to before starting
+// afresh. Commands include container IDs so the set of them can keep growing
+// for as long as lazydocker is open
+const maxCachedArgvs = 256
+
 // NewOSCommand os command runner
 func NewOSCommand(log *logrus.Entry, config *config.AppConfig) *OSCommand {
 	return &OSCommand{
@@ -57,16 +79,39 @@ func (c *OSCommand) SetCommand(cmd func(string, ...string) *exec.Cmd) {
 
 // RunCommandWithOutput wrapper around commands returning their output and error
 func (c *OSCommand) RunCommandWithOutput(command string) (string, error) {
+	return c.runCommandWithOutput(command, command)
+}
+
+// RunTemplateWithOutput fills in a command template and runs it. How long it
+// took is recorded against the template rather than the command, so that
+// e.g. stopping each of your services counts towards the same thing
+func (c *OSCommand) RunTemplateWithOutput(template string, object interface{}) (string, error) {
+	return c.runCommandWithOutput(template, utils.ApplyTemplate(template, object))
+}
+
+// RunTemplate is like RunTemplateWithOutput but just returns the error
+func (c *OSCommand) RunTemplate(template string, object interface{}) error {
+	_, err := c.RunTemplateWithOutput(template, object)
+	return err
+}
+
+func (c *OSCommand) runCommandWithOutput(name string, command string) (string, error) {
+	span := c.Tracer.Start("command", name)
+	defer span.End()
+
 	cmd := c.ExecutableFromString(command)
 	before := time.Now()
 	output, err := sanitisedCommandOutput(cmd.Output())
-	c.Log.Warn(fmt.Sprintf("'%s': %s", command, time.Since(before)))
+	took := time.Since(before)
+	c.Log.Warn(fmt.Sprintf("'%s': %s", command, took))
+	c.Metrics.ObserveCommand(name, took)
 	return output, err
 }
 
-// RunExecutableWithOutput runs an executable file and returns its output
+// RunExecutableWithOutput runs an executable file and returns its output. If
+// it fails, the error is whatever it wrote to stderr
 func (c *OSCommand) RunExecutableWithOutput(cmd *exec.Cmd) (string, error) {
-	return sanitisedCommandOutput(cmd.CombinedOutput())
+	return sanitisedCommandOutput(cmd.Output())
 }
 
 // RunExecutable runs an executable file and returns an error if there was one
@@ -77,11 +122,71 @@ func (c *OSCommand) RunExecutable(cmd *exec.Cmd) error {
 
 // ExecutableFromString takes a string like `docker ps -a` and returns an executable command for it
 func (c *OSCommand) ExecutableFromString(commandStr string) *exec.Cmd {
-	splitCmd := str.ToArgv(commandStr)
-	// c.Log.Info(splitCmd)
+	splitCmd := c.toArgv(commandStr)
 	return c.command(splitCmd[0], splitCmd[1:]...)
 }
 
+func (c *OSCommand) toArgv(commandStr string) []string {
+	c.argvMutex.Lock()
+	defer c.argvMutex.Unlock()
+
+	if argv, ok := c.argvCache[commandStr]; ok {
+		return argv
+	}
+
+	if c.argvCache == nil || len(c.argvCache) >= maxCachedArgvs {
+		c.argvCache = map[string][]string{}
+	}
+	// exec.Command copies the args it's given so it's safe to share these
+	argv := str.ToArgv(commandStr)
+	c.argvCache[commandStr] = argv
+	return argv
+}
+
+// NeedsShell tells us whether a command string uses shell syntax (pipes,
+// variables, globs, etc) and so has to be run through a shell. Anything else
+// can be split into an argv and exec'd directly, which saves us starting a
+// shell. Quoting is fine either way because we split on quotes the same way
+// the shell does, but we err on the side of using the shell if in doubt.
+func NeedsShell(commandStr string) bool {
+	if strings.TrimSpace(commandStr) == "" {
+		return true
+	}
+
+	var quote rune
+	inFirstWord := true
+	for _, char := range commandStr {
+		switch {
+		case char == '%':
+			// cmd expands %VAR% even inside quotes, and sh doesn't mind
+			return true
+		case quote == '\'':
+			if char == quote {
+				quote = 0
+			}
+		case quote == '"':
+			switch char {
+			case '"':
+				quote = 0
+			case '$', '`', '\\':
+				return true
+			}
+		case char == '\'' || char == '"':
+			quote = char
+		case char == ' ' || char == '\t':
+			inFirstWord = false
+		case char == '=' && inFirstWord:
+			// a leading FOO=bar is an environment variable assignment
+			return true
+		case strings.ContainsRune("|&;<>()$`\\*?[]{}#~!\n", char):
+			return true
+		}
+	}
+
+	// an unterminated quote is the shell's problem
+	return quote != 0
+}
+
 // RunCommand runs a command and just returns the error
 func (c *OSCommand) RunCommand(command string) error {
 	_, err := c.RunCommandWithOutput(command)
@@ -267,9 +372,45 @@ func (c *OSCommand) GetLazydockerPath() string {
 
 // RunCustomCommand returns the pointer to a custom command
 func (c *OSCommand) RunCustomCommand(command string) *exec.Cmd {
+	if !NeedsShell(command) {
+		return c.ExecutableFromString(command)
+	}
 	return c.PrepareSubProcess(c.Platform.shell, c.Platform.shellArg, command)
 }
 
+// RunCommandWithStop runs a command to completion, writing its output to out
+// as it goes. If the stop channel is closed before the command finishes, the
+// command and any children it has spawned are killed.
+func (c *OSCommand) RunCommandWithStop(command string, stop chan struct{}, out io.Writer) error {
+	return c.RunExecutableWithStop(c.RunCustomCommand(command), stop, out)
+}
+
+// RunExecutableWithStop is like RunCommandWithStop but for a command we've
+// already prepared
+func (c *OSCommand) RunExecutableWithStop(cmd *exec.Cmd, stop chan struct{}, out io.Writer) error {
+	c.PrepareForChildren(cmd)
+	cmd.Stdout = out
+	cmd.Stderr = out
+
+	if err := cmd.Start(); err != nil {
+		return err
+	}
+
+	done := make(chan struct{})
+	defer close(done)
+	go func() {
+		select {
+		case <-stop:
+			if err := c.Kill(cmd); err != nil {
+				c.Log.Warn(err)
+			}
+		case <-done:
+		}
+	}()
+
+	return cmd.Wait()
+}
+
 // PipeCommands runs a heap of commands and pipes their inputs/outputs together like A | B | C
 func (c *OSCommand) PipeCommands(commandStrings ...string) error {
 
@@ -58,6 +58,44 @@ func TestOSCommandRunCommand(t *testing.T) {
 	}
 }
 
+// TestNeedsShell is a function.
+func TestNeedsShell(t *testing.T) {
+	type scenario struct {
+		command  string
+		expected bool
+	}
+
+	scenarios := []scenario{
+		{"docker logs --since=60m --follow abc123", false},
+		{`docker exec abc123 sh -c "echo hello world"`, false},
+		{`docker exec abc123 /bin/sh -c 'if [ -x "$(command -v bash)" ]; then bash; fi'`, false},
+		{`echo "$HOME"`, true},
+		{"docker logs abc123 | grep error", true},
+		{"docker stop abc123 && docker rm abc123", true},
+		{"FOO=bar docker ps", true},
+		{"ls *.yml", true},
+		{`docker exec abc123 "%USERPROFILE%/setup.bat"`, true},
+		{"docker logs %CONTAINER%", true},
+		{"echo 'unterminated", true},
+		{"", true},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, NeedsShell(s.command), s.command)
+	}
+}
+
+// TestOSCommandRunCustomCommand is a function.
+func TestOSCommandRunCustomCommand(t *testing.T) {
+	osCommand := NewDummyOSCommand()
+
+	cmd := osCommand.RunCustomCommand("docker restart 'my container'")
+	assert.EqualValues(t, []string{"docker", "restart", "my container"}, cmd.Args)
+
+	cmd = osCommand.RunCustomCommand("docker ps | grep abc")
+	assert.EqualValues(t, []string{osCommand.Platform.shell, osCommand.Platform.shellArg, "docker ps | grep abc"}, cmd.Args)
+}
+
 // TestOSCommandEditFile is a function.
 func TestOSCommandEditFile(t *testing.T) {
 	type scenario struct {
@@ -0,0 +1,306 @@
+package commands
+
+import (
+	"context"
+	"encoding/json"
+	"fmt"
+	"io"
+	"sort"
+	"strings"
+	"sync"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/client"
+	"github.com/fatih/color"
+	"github.com/go-errors/errors"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+	"github.com/sirupsen/logrus"
+)
+
+// pullMessage is a single message from the JSON stream the docker daemon sends
+// back while pulling an image. We only decode the fields we care about.
+type pullMessage struct {
+	ID             string `json:"id"`
+	Status         string `json:"status"`
+	ProgressDetail struct {
+		Current int64 `json:"current"`
+		Total   int64 `json:"total"`
+	} `json:"progressDetail"`
+	Error string `json:"error"`
+}
+
+// LayerProgress tracks the download/extraction of a single layer. Layers are
+// shared between pulls: if two images have a layer in common, the daemon only
+// fetches it once, and we only show it once.
+type LayerProgress struct {
+	ID      string
+	Status  string
+	Current int64
+	Total   int64
+	Refs    []string
+}
+
+// ImagePull is a single pull of an image reference
+type ImagePull struct {
+	Ref    string
+	Status string
+	Done   bool
+	Err    error
+	Layers []string
+}
+
+// PullManager pulls images through the docker API and keeps track of the
+// progress of each pull, keyed by layer so that concurrent pulls of images
+// with layers in common can be shown side by side
+type PullManager struct {
+	Log     *logrus.Entry
+	Client  *client.Client
+	Auth    *RegistryAuth
+	mutex   sync.Mutex
+	pulls   []*ImagePull
+	layers  map[string]*LayerProgress
+	version int
+}
+
+// NewPullManager returns a new PullManager
+func NewPullManager(log *logrus.Entry, client *client.Client) *PullManager {
+	return &PullManager{
+		Log:    log,
+		Client: client,
+		Auth:   NewRegistryAuth(),
+		layers: map[string]*LayerProgress{},
+	}
+}
+
+// Pull pulls the given image reference, decoding the progress stream as it
+// arrives. Any message that isn't per-layer progress (e.g. 'Digest: ...') is
+// written to out. The pull is abandoned if stop is closed.
+func (m *PullManager) Pull(ref string, stop chan struct{}, out io.Writer) error {
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+	go func() {
+		select {
+		case <-stop:
+			cancel()
+		case <-ctx.Done():
+		}
+	}()
+
+	pull := &ImagePull{Ref: ref}
+	m.mutex.Lock()
+	m.forgetFinishedPulls()
+	m.pulls = append(m.pulls, pull)
+	m.version++
+	m.mutex.Unlock()
+
+	err := m.pull(ctx, pull, out)
+
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+	pull.Done = true
+	pull.Err = err
+	m.version++
+
+	return err
+}
+
+func (m *PullManager) pull(ctx context.Context, pull *ImagePull, out io.Writer) error {
+	// the daemon doesn't know about the CLI's credentials, so we send them along
+	// the way 'docker pull' would
+	auth, err := m.Auth.For(pull.Ref)
+	if err != nil {
+		m.Log.Warnf("couldn't find registry credentials for %s, pulling anonymously: %v", pull.Ref, err)
+	}
+
+	stream, err := m.Client.ImagePull(ctx, pull.Ref, types.ImagePullOptions{RegistryAuth: auth})
+	if err != nil {
+		return err
+	}
+	defer stream.Close()
+
+	// we decode one message at a time as they arrive rather than waiting for the
+	// whole response, otherwise we wouldn't have much of a progress bar
+	decoder := json.NewDecoder(stream)
+	for {
+		var message pullMessage
+		if err := decoder.Decode(&message); err != nil {
+			if err == io.EOF {
+				return nil
+			}
+			return err
+		}
+
+		if message.Error != "" {
+			return errors.New(message.Error)
+		}
+
+		if message.ID != "" && isLayerStatus(message.Status) {
+			m.updateLayer(pull, message)
+			continue
+		}
+
+		// anything else is a message about the pull as a whole
+		fmt.Fprintln(out, strings.TrimSpace(message.ID+" "+message.Status))
+		m.mutex.Lock()
+		pull.Status = message.Status
+		m.version++
+		m.mutex.Unlock()
+	}
+}
+
+// layerStages are the statuses a layer goes through, in order
+var layerStages = []string{"Pulling fs layer", "Waiting", "Downloading", "Verifying Checksum", "Download complete", "Extracting", "Pull complete", "Already exists"}
+
+// isLayerStatus tells us whether a status refers to the state of a layer,
+// as opposed to e.g. 'Pulling from library/postgres', which comes with the
+// tag as its ID
+func isLayerStatus(status string) bool {
+	return layerStage(status) != -1
+}
+
+func (m *PullManager) updateLayer(pull *ImagePull, message pullMessage) {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	layer, ok := m.layers[message.ID]
+	if !ok {
+		layer = &LayerProgress{ID: message.ID}
+		m.layers[message.ID] = layer
+	}
+	if !utils.IncludesString(layer.Refs, pull.Ref) {
+		layer.Refs = append(layer.Refs, pull.Ref)
+	}
+	if !utils.IncludesString(pull.Layers, message.ID) {
+		pull.Layers = append(pull.Layers, message.ID)
+	}
+
+	// another pull may have already got further along with this layer than we
+	// have, in which case we don't want to go backwards
+	if layerStage(message.Status) < layerStage(layer.Status) {
+		return
+	}
+
+	layer.Status = message.Status
+	layer.Current = message.ProgressDetail.Current
+	layer.Total = message.ProgressDetail.Total
+	m.version++
+}
+
+func layerStage(status string) int {
+	for i, prefix := range layerStages {
+		if strings.HasPrefix(status, prefix) {
+			return i
+		}
+	}
+	return -1
+}
+
+// forgetFinishedPulls clears out pulls that have finished, along with any
+// layers no unfinished pull needs. We do this when a new pull starts rather
+// than when the old one finishes so that you get to see how the old one ended.
+// It must be called with the mutex held.
+func (m *PullManager) forgetFinishedPulls() {
+	pulls := []*ImagePull{}
+	needed := map[string]bool{}
+	for _, pull := range m.pulls {
+		if pull.Done {
+			continue
+		}
+		pulls = append(pulls, pull)
+		for _, id := range pull.Layers {
+			needed[id] = true
+		}
+	}
+	m.pulls = pulls
+
+	for id := range m.layers {
+		if !needed[id] {
+			delete(m.layers, id)
+		}
+	}
+}
+
+// Version is bumped whenever any pull makes progress
+func (m *PullManager) Version() int {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+	return m.version
+}
+
+// Render returns a summary of each pull, followed by a progress bar for every
+// layer being pulled. Each layer appears once no matter how many pulls need it
+func (m *PullManager) Render(width int) string {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	if len(m.pulls) == 0 {
+		return ""
+	}
+
+	pullRows := make([][]string, len(m.pulls))
+	for i, pull := range m.pulls {
+		var current, total int64
+		complete := 0
+		for _, id := range pull.Layers {
+			layer := m.layers[id]
+			current += layer.Current
+			total += layer.Total
+			if layerStage(layer.Status) >= layerStage("Pull complete") {
+				complete++
+			}
+		}
+
+		status := utils.ColoredString(pull.Status, color.FgBlue)
+		if pull.Err != nil {
+			status = utils.ColoredString(pull.Err.Error(), color.FgRed)
+		} else if pull.Done {
+			status = utils.ColoredString("done", color.FgGreen)
+		}
+
+		pullRows[i] = []string{
+			utils.ColoredString(pull.Ref, color.FgCyan),
+			fmt.Sprintf("%d/%d layers", complete, len(pull.Layers)),
+			utils.FormatDecimalBytes(int(current)) + "/" + utils.FormatDecimalBytes(int(total)),
+			status,
+		}
+	}
+
+	ids := make([]string, 0, len(m.layers))
+	for id := range m.layers {
+		ids = append(ids, id)
+	}
+	sort.Strings(ids)
+
+	barWidth := width / 3
+	layerRows := make([][]string, len(ids))
+	for i, id := range ids {
+		layer := m.layers[id]
+
+		bar := ""
+		progress := ""
+		if layer.Total > 0 {
+			bar = utils.ProgressBar(layer.Current, layer.Total, barWidth)
+			progress = utils.FormatDecimalBytes(int(layer.Current)) + "/" + utils.FormatDecimalBytes(int(layer.Total))
+		} else if layerStage(layer.Status) >= layerStage("Pull complete") {
+			bar = utils.ProgressBar(1, 1, barWidth)
+		}
+
+		shared := ""
+		if len(layer.Refs) > 1 {
+			shared = utils.ColoredString(fmt.Sprintf("shared by %d pulls", len(layer.Refs)), color.FgYellow)
+		}
+
+		layerRows[i] = []string{id, layer.Status, bar, progress, shared}
+	}
+
+	pullTable, err := utils.RenderTable(pullRows)
+	if err != nil {
+		m.Log.Error(err)
+	}
+	layerTable, err := utils.RenderTable(layerRows)
+	if err != nil {
+		m.Log.Error(err)
+	}
+
+	return pullTable + "\n\n" + layerTable
+}
@@ -0,0 +1,92 @@
+package commands
+
+import (
+	"bytes"
+	"context"
+	"fmt"
+	"net/http"
+	"net/http/httptest"
+	"strings"
+	"testing"
+
+	"github.com/docker/docker/client"
+	"github.com/stretchr/testify/assert"
+)
+
+// newDummyPullManager returns a PullManager whose client talks to a fake
+// daemon that responds to each pull with the given JSON messages, keyed by tag
+func newDummyPullManager(t *testing.T, responses map[string][]string) (*PullManager, func()) {
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		messages, ok := responses[r.URL.Query().Get("tag")]
+		if !ok {
+			w.WriteHeader(http.StatusNotFound)
+			return
+		}
+		for _, message := range messages {
+			fmt.Fprintln(w, message)
+		}
+	}))
+
+	cli, err := client.NewClientWithOpts(client.WithHost("tcp://"+strings.TrimPrefix(server.URL, "http://")), client.WithVersion(APIVersion))
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	m := NewPullManager(NewDummyLog(), cli)
+	// not picking up whatever credentials are on this machine
+	m.Auth = nil
+	return m, server.Close
+}
+
+// TestPullManagerPull is a function.
+func TestPullManagerPull(t *testing.T) {
+	m, closeServer := newDummyPullManager(t, map[string][]string{
+		"1": {
+			`{"status":"Pulling from library/alpine","id":"1"}`,
+			`{"status":"Pulling fs layer","progressDetail":{},"id":"shared"}`,
+			`{"status":"Pulling fs layer","progressDetail":{},"id":"one"}`,
+			`{"status":"Downloading","progressDetail":{"current":50,"total":100},"id":"shared"}`,
+			`{"status":"Pull complete","progressDetail":{},"id":"one"}`,
+			`{"status":"Digest: sha256:abc"}`,
+		},
+		"2": {
+			`{"status":"Pulling from library/alpine","id":"2"}`,
+			`{"status":"Waiting","progressDetail":{},"id":"shared"}`,
+			`{"status":"Pulling fs layer","progressDetail":{},"id":"two"}`,
+		},
+		"broken": {
+			`{"status":"Pulling from library/alpine","id":"broken"}`,
+			`{"errorDetail":{"message":"manifest unknown"},"error":"manifest unknown"}`,
+		},
+	})
+	defer closeServer()
+
+	// running the pulls one after the other but without letting the manager
+	// forget about them, as if they were running concurrently
+	one := &ImagePull{Ref: "alpine:1"}
+	two := &ImagePull{Ref: "alpine:2"}
+	m.pulls = []*ImagePull{one, two}
+
+	out := &bytes.Buffer{}
+	assert.NoError(t, m.pull(context.Background(), one, out))
+	assert.NoError(t, m.pull(context.Background(), two, out))
+
+	assert.EqualValues(t, "1 Pulling from library/alpine\nDigest: sha256:abc\n2 Pulling from library/alpine\n", out.String())
+	assert.EqualValues(t, "Digest: sha256:abc", one.Status)
+	assert.EqualValues(t, []string{"shared", "one"}, one.Layers)
+	assert.EqualValues(t, []string{"shared", "two"}, two.Layers)
+
+	// the second pull came late to the shared layer so it mustn't drag it back
+	// from downloading to waiting
+	shared := m.layers["shared"]
+	assert.EqualValues(t, "Downloading", shared.Status)
+	assert.EqualValues(t, 50, shared.Current)
+	assert.EqualValues(t, []string{"alpine:1", "alpine:2"}, shared.Refs)
+
+	rendered := m.Render(60)
+	assert.Contains(t, rendered, "shared by 2 pulls")
+	assert.Contains(t, rendered, "1/2 layers")
+
+	assert.EqualError(t, m.Pull("alpine:broken", make(chan struct{}), out), "manifest unknown")
+	assert.Len(t, m.pulls, 3)
+}
@@ -0,0 +1,181 @@
+package commands
+
+import (
+	"fmt"
+	"strconv"
+	"strings"
+)
+
+// queryOperators are the comparisons a query term can make, longest first so
+// that e.g. '>=' isn't taken for '>'
+var queryOperators = []string{"!=", ">=", "<=", "=", ">", "<", "~"}
+
+// ContainerQuery is a filter over containers written like
+// `state=running cpu>50 label:team=payments image~redis`. '=' and '!=' compare
+// exactly (ignoring case), '~' looks for a substring, and cpu and mem (both
+// percentages) can be compared with '>', '<', '>=' and '<='. Any words that
+// aren't comparisons end up in Text, to be fuzzy-matched as usual
+type ContainerQuery struct {
+	Text       string
+	predicates []func(*Container) bool
+}
+
+// ParseContainerQuery parses the given query, returning an error if it
+// compares a field we don't know about or compares it in a way that makes no
+// sense, e.g. `name>3`
+func ParseContainerQuery(query string) (*ContainerQuery, error) {
+	q := &ContainerQuery{}
+	words := []string{}
+
+	for _, term := range strings.Fields(query) {
+		field, operator, value := splitQueryTerm(term)
+		if operator == "" {
+			words = append(words, term)
+			continue
+		}
+
+		predicate, err := containerPredicate(field, operator, value)
+		if err != nil {
+			return nil, err
+		}
+		q.predicates = append(q.predicates, predicate)
+	}
+
+	q.Text = strings.Join(words, " ")
+	return q, nil
+}
+
+// Matches tells us whether the container satisfies every field comparison in
+// the query. It doesn't look at Text
+func (q *ContainerQuery) Matches(container *Container) bool {
+	for _, predicate := range q.predicates {
+		if !predicate(container) {
+			return false
+		}
+	}
+	return true
+}
+
+// splitQueryTerm splits e.g. `cpu>=50` into its field, operator and value.
+// The operator is empty if the term isn't a comparison. For labels the field
+// includes the label's key, e.g. `label:team`
+func splitQueryTerm(term string) (string, string, string) {
+	start := 0
+	if strings.HasPrefix(strings.ToLower(term), "label:") {
+		start = len("label:")
+	}
+
+	index, operator := -1, ""
+	for _, candidate := range queryOperators {
+		if i := strings.Index(term[start:], candidate); i != -1 && (index == -1 || i < index) {
+			index, operator = i, candidate
+		}
+	}
+	if index == -1 {
+		if start > 0 {
+			// `label:team` on its own asks whether the label is there at all
+			return term, "?", ""
+		}
+		return term, "", ""
+	}
+	index += start
+	return term[:index], operator, term[index+len(operator):]
+}
+
+func containerPredicate(field string, operator string, value string) (func(*Container) bool, error) {
+	if strings.HasPrefix(strings.ToLower(field), "label:") {
+		key := field[len("label:"):]
+		if key == "" {
+			return nil, fmt.Errorf("no label given in '%s'", field)
+		}
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) {
+			labelValue, ok := c.Container.Labels[key]
+			return labelValue, ok
+		})
+	}
+
+	field = strings.ToLower(field)
+	switch field {
+	case "state":
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) { return c.Container.State, true })
+	case "name":
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) { return c.Name, true })
+	case "image":
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) { return c.Container.Image, true })
+	case "service":
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) { return c.ServiceName, c.ServiceName != "" })
+	case "project":
+		return stringPredicate(field, operator, value, func(c *Container) (string, bool) { return c.ProjectName, c.ProjectName != "" })
+	case "cpu":
+		return numberPredicate(field, operator, value, (*Container).CPUPercentage)
+	case "mem":
+		return numberPredicate(field, operator, value, (*Container).MemoryPercentage)
+	}
+
+	return nil, fmt.Errorf("unknown field '%s'", field)
+}
+
+// stringPredicate compares the value get returns for a container. get returns
+// false if the container doesn't have the field at all (e.g. a label it
+// doesn't have), in which case only '!=' matches
+func stringPredicate(field string, operator string, value string, get func(*Container) (string, bool)) (func(*Container) bool, error) {
+	value = strings.ToLower(value)
+
+	switch operator {
+	case "?":
+		return func(c *Container) bool {
+			_, ok := get(c)
+			return ok
+		}, nil
+	case "=":
+		return func(c *Container) bool {
+			actual, ok := get(c)
+			return ok && strings.ToLower(actual) == value
+		}, nil
+	case "!=":
+		return func(c *Container) bool {
+			actual, ok := get(c)
+			return !ok || strings.ToLower(actual) != value
+		}, nil
+	case "~":
+		return func(c *Container) bool {
+			actual, ok := get(c)
+			return ok && strings.Contains(strings.ToLower(actual), value)
+		}, nil
+	}
+
+	return nil, fmt.Errorf("can't use '%s' with %s", operator, field)
+}
+
+// numberPredicate compares the number get returns for a container. get returns
+// false if we don't know the number yet (e.g. we haven't got any stats for the
+// container), in which case nothing matches
+func numberPredicate(field string, operator string, value string, get func(*Container) (float64, bool)) (func(*Container) bool, error) {
+	expected, err := strconv.ParseFloat(strings.TrimSuffix(value, "%"), 64)
+	if err != nil {
+		return nil, fmt.Errorf("%s needs a number, not '%s'", field, value)
+	}
+
+	var compare func(float64) bool
+	switch operator {
+	case "=":
+		compare = func(actual float64) bool { return actual == expected }
+	case "!=":
+		compare = func(actual float64) bool { return actual != expected }
+	case ">":
+		compare = func(actual float64) bool { return actual > expected }
+	case "<":
+		compare = func(actual float64) bool { return actual < expected }
+	case ">=":
+		compare = func(actual float64) bool { return actual >= expected }
+	case "<=":
+		compare = func(actual float64) bool { return actual <= expected }
+	default:
+		return nil, fmt.Errorf("can't use '%s' with %s", operator, field)
+	}
+
+	return func(c *Container) bool {
+		actual, ok := get(c)
+		return ok && compare(actual)
+	}, nil
+}
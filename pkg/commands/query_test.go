@@ -0,0 +1,85 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestContainerQuery is a function.
+func TestContainerQuery(t *testing.T) {
+	type scenario struct {
+		query    string
+		text     string
+		expected []string
+	}
+
+	containers := []*Container{
+		{
+			Name:        "payments-api",
+			ServiceName: "api",
+			Container:   types.Container{State: "running", Image: "payments:1.4", Labels: map[string]string{"team": "Payments"}},
+			CLIStats:    ContainerCliStat{CPUPerc: "75.20%", MemPerc: "10.00%"},
+		},
+		{
+			Name:      "cache",
+			Container: types.Container{State: "running", Image: "redis:5", Labels: map[string]string{"team": "payments"}},
+			CLIStats:  ContainerCliStat{CPUPerc: "3.10%", MemPerc: "40.00%"},
+		},
+		{
+			Name:      "old-job",
+			Container: types.Container{State: "exited", Image: "bitnami/redis"},
+			CLIStats:  ContainerCliStat{CPUPerc: "--"},
+		},
+	}
+
+	scenarios := []scenario{
+		{"state=running", "", []string{"payments-api", "cache"}},
+		{"State=RUNNING cpu>50", "", []string{"payments-api"}},
+		{"cpu<=3.1", "", []string{"cache"}},
+		{"mem>=10%", "", []string{"payments-api", "cache"}},
+		{"label:team=payments", "", []string{"payments-api", "cache"}},
+		{"label:team", "", []string{"payments-api", "cache"}},
+		{"label:team!=payments", "", []string{"old-job"}},
+		{"image~redis", "", []string{"cache", "old-job"}},
+		{"service=api", "", []string{"payments-api"}},
+		{"state!=exited pay", "pay", []string{"payments-api", "cache"}},
+		{"just words", "just words", []string{"payments-api", "cache", "old-job"}},
+	}
+
+	for _, s := range scenarios {
+		query, err := ParseContainerQuery(s.query)
+		assert.NoError(t, err, s.query)
+		assert.EqualValues(t, s.text, query.Text, s.query)
+
+		names := []string{}
+		for _, container := range containers {
+			if query.Matches(container) {
+				names = append(names, container.Name)
+			}
+		}
+		assert.EqualValues(t, s.expected, names, s.query)
+	}
+}
+
+// TestParseContainerQueryErrors is a function.
+func TestParseContainerQueryErrors(t *testing.T) {
+	type scenario struct {
+		query    string
+		expected string
+	}
+
+	scenarios := []scenario{
+		{"colour=red", "unknown field 'colour'"},
+		{"name>3", "can't use '>' with name"},
+		{"cpu~5", "can't use '~' with cpu"},
+		{"cpu>lots", "cpu needs a number, not 'lots'"},
+		{"label:=x", "no label given in 'label:'"},
+	}
+
+	for _, s := range scenarios {
+		_, err := ParseContainerQuery(s.query)
+		assert.EqualError(t, err, s.expected, s.query)
+	}
+}
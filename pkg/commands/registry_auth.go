@@ -0,0 +1,157 @@
+package commands
+
+import (
+	"bytes"
+	"encoding/base64"
+	"encoding/json"
+	"io/ioutil"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"strings"
+
+	"github.com/docker/distribution/reference"
+	"github.com/docker/docker/api/types"
+)
+
+// dockerHubAuthKey is what the docker CLI files Docker Hub's credentials under
+const dockerHubAuthKey = "https://index.docker.io/v1/"
+
+// dockerConfigFile is the part of the docker CLI's config.json that says where
+// to find registry credentials
+type dockerConfigFile struct {
+	Auths       map[string]types.AuthConfig `json:"auths"`
+	CredsStore  string                      `json:"credsStore"`
+	CredHelpers map[string]string           `json:"credHelpers"`
+}
+
+// helperCredentials is what a docker-credential-* helper prints for 'get'
+type helperCredentials struct {
+	Username string
+	Secret   string
+}
+
+// RegistryAuth finds the credentials the docker CLI would use to pull an image,
+// so that pulling through the API works against the same private registries
+// that 'docker pull' does. It reads the CLI's config.json and asks credential
+// helpers the same way the CLI does, but doesn't support anything the CLI
+// only learns at runtime, e.g. prompting for a password
+type RegistryAuth struct {
+	configDir string
+	// runHelper runs the given docker-credential-* helper's 'get' for a server
+	runHelper func(helper string, server string) ([]byte, error)
+}
+
+// NewRegistryAuth returns a RegistryAuth that reads the docker CLI's config
+// from $DOCKER_CONFIG, or ~/.docker if that isn't set
+func NewRegistryAuth() *RegistryAuth {
+	configDir := os.Getenv("DOCKER_CONFIG")
+	if configDir == "" {
+		if home, err := os.UserHomeDir(); err == nil {
+			configDir = filepath.Join(home, ".docker")
+		}
+	}
+	return &RegistryAuth{configDir: configDir, runHelper: runCredentialHelper}
+}
+
+func runCredentialHelper(helper string, server string) ([]byte, error) {
+	cmd := exec.Command("docker-credential-"+helper, "get")
+	cmd.Stdin = strings.NewReader(server)
+	return cmd.Output()
+}
+
+// For returns the encoded credentials to pull the given image reference with,
+// ready for ImagePullOptions.RegistryAuth. It returns an empty string if we
+// don't have any credentials for the image's registry, in which case we pull
+// anonymously
+func (a *RegistryAuth) For(ref string) (string, error) {
+	if a == nil || a.configDir == "" {
+		return "", nil
+	}
+
+	named, err := reference.ParseNormalizedNamed(ref)
+	if err != nil {
+		return "", err
+	}
+	registry := reference.Domain(named)
+	key := registry
+	if registry == "docker.io" {
+		key = dockerHubAuthKey
+	}
+
+	data, err := ioutil.ReadFile(filepath.Join(a.configDir, "config.json"))
+	if os.IsNotExist(err) {
+		return "", nil
+	}
+	if err != nil {
+		return "", err
+	}
+	config := dockerConfigFile{}
+	if err := json.Unmarshal(data, &config); err != nil {
+		return "", err
+	}
+
+	authConfig, found, err := a.lookup(config, registry, key)
+	if err != nil || !found {
+		return "", err
+	}
+	authConfig.ServerAddress = key
+
+	encoded, err := json.Marshal(authConfig)
+	if err != nil {
+		return "", err
+	}
+	return base64.URLEncoding.EncodeToString(encoded), nil
+}
+
+// lookup finds the credentials for a registry the way the docker CLI does: a
+// helper for that registry, then the default store, then config.json itself
+func (a *RegistryAuth) lookup(config dockerConfigFile, registry string, key string) (types.AuthConfig, bool, error) {
+	helper := config.CredHelpers[registry]
+	if helper == "" {
+		helper = config.CredsStore
+	}
+	if helper != "" {
+		output, err := a.runHelper(helper, key)
+		if err != nil {
+			// helpers exit non-zero when they've got nothing for the server
+			return types.AuthConfig{}, false, nil
+		}
+		credentials := helperCredentials{}
+		if err := json.Unmarshal(bytes.TrimSpace(output), &credentials); err != nil {
+			return types.AuthConfig{}, false, err
+		}
+		// helpers store identity tokens with this as the username
+		if credentials.Username == "<token>" {
+			return types.AuthConfig{IdentityToken: credentials.Secret}, true, nil
+		}
+		return types.AuthConfig{Username: credentials.Username, Password: credentials.Secret}, true, nil
+	}
+
+	for address, authConfig := range config.Auths {
+		if address != key && registryHostname(address) != registry {
+			continue
+		}
+		if authConfig.Auth != "" {
+			decoded, err := base64.StdEncoding.DecodeString(authConfig.Auth)
+			if err != nil {
+				return types.AuthConfig{}, false, err
+			}
+			parts := strings.SplitN(string(decoded), ":", 2)
+			if len(parts) == 2 {
+				authConfig.Username, authConfig.Password = parts[0], parts[1]
+			}
+			authConfig.Auth = ""
+		}
+		return authConfig, true, nil
+	}
+	return types.AuthConfig{}, false, nil
+}
+
+// registryHostname turns a key from config.json's auths, which older CLIs wrote
+// as URLs like 'https://registry.example.com/v1/', into just the hostname
+func registryHostname(address string) string {
+	address = strings.TrimPrefix(address, "http://")
+	address = strings.TrimPrefix(address, "https://")
+	return strings.SplitN(address, "/", 2)[0]
+}
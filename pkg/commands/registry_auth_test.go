@@ -0,0 +1,73 @@
+package commands
+
+import (
+	"encoding/base64"
+	"encoding/json"
+	"errors"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestRegistryAuthFor is a function.
+func TestRegistryAuthFor(t *testing.T) {
+	dir, err := ioutil.TempDir("", "lazydocker-registry-auth")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	config := `{
+		"auths": {
+			"https://index.docker.io/v1/": {"auth": "` + base64.StdEncoding.EncodeToString([]byte("hubuser:hubpass")) + `"},
+			"https://registry.example.com/v1/": {"auth": "` + base64.StdEncoding.EncodeToString([]byte("old:style")) + `"},
+			"ghcr.io": {}
+		},
+		"credHelpers": {"123.dkr.ecr.us-east-1.amazonaws.com": "ecr-login", "gcr.io": "gcloud"}
+	}`
+	assert.NoError(t, ioutil.WriteFile(filepath.Join(dir, "config.json"), []byte(config), 0600))
+
+	auth := &RegistryAuth{configDir: dir, runHelper: func(helper string, server string) ([]byte, error) {
+		switch helper {
+		case "ecr-login":
+			return []byte(`{"ServerURL":"` + server + `","Username":"AWS","Secret":"ecrpass"}`), nil
+		default:
+			return nil, errors.New("credentials not found in native keychain")
+		}
+	}}
+
+	type scenario struct {
+		ref      string
+		expected *types.AuthConfig
+	}
+
+	scenarios := []scenario{
+		{"postgres:12", &types.AuthConfig{Username: "hubuser", Password: "hubpass", ServerAddress: dockerHubAuthKey}},
+		{"registry.example.com/team/app:1.0", &types.AuthConfig{Username: "old", Password: "style", ServerAddress: "registry.example.com"}},
+		{"123.dkr.ecr.us-east-1.amazonaws.com/app", &types.AuthConfig{Username: "AWS", Password: "ecrpass", ServerAddress: "123.dkr.ecr.us-east-1.amazonaws.com"}},
+		{"gcr.io/project/app", nil},
+		{"quay.io/someone/app", nil},
+	}
+
+	for _, s := range scenarios {
+		encoded, err := auth.For(s.ref)
+		assert.NoError(t, err, s.ref)
+		if s.expected == nil {
+			assert.EqualValues(t, "", encoded, s.ref)
+			continue
+		}
+
+		decoded, err := base64.URLEncoding.DecodeString(encoded)
+		assert.NoError(t, err, s.ref)
+		actual := types.AuthConfig{}
+		assert.NoError(t, json.Unmarshal(decoded, &actual), s.ref)
+		assert.EqualValues(t, *s.expected, actual, s.ref)
+	}
+
+	// without a config we just pull anonymously
+	encoded, err := (&RegistryAuth{configDir: filepath.Join(dir, "missing")}).For("postgres")
+	assert.NoError(t, err)
+	assert.EqualValues(t, "", encoded)
+}
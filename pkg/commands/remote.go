@@ -0,0 +1,133 @@
+package commands
+
+import (
+	"strings"
+	"sync"
+	"time"
+)
+
+// Remote modes. In auto mode we switch remote mode on if any of our endpoints
+// is reached over the network
+const (
+	RemoteModeAuto = "auto"
+	RemoteModeOn   = "on"
+	RemoteModeOff  = "off"
+)
+
+// remoteRefreshFactor is how many round trips' worth of time we leave between
+// refreshes in remote mode. Without it, a refresh that takes longer than the
+// refresh interval is followed immediately by the next one, and the daemon
+// spends all its time answering us
+const remoteRefreshFactor = 4
+
+// staleRefreshes is how many refreshes we can miss before we tell the user the
+// lists they're looking at are out of date
+const staleRefreshes = 3
+
+// requestGroup lets concurrent callers making the same request share a single
+// round trip to the daemon rather than each making their own
+type requestGroup struct {
+	mutex    sync.Mutex
+	inFlight map[string]*request
+}
+
+type request struct {
+	done   chan struct{}
+	result interface{}
+	err    error
+}
+
+// do calls f, unless a call with the same key is already in flight, in which
+// case it waits for that one and returns its result instead
+func (g *requestGroup) do(key string, f func() (interface{}, error)) (interface{}, error) {
+	g.mutex.Lock()
+	if r, ok := g.inFlight[key]; ok {
+		g.mutex.Unlock()
+		<-r.done
+		return r.result, r.err
+	}
+	if g.inFlight == nil {
+		g.inFlight = map[string]*request{}
+	}
+	r := &request{done: make(chan struct{})}
+	g.inFlight[key] = r
+	g.mutex.Unlock()
+
+	r.result, r.err = f()
+
+	g.mutex.Lock()
+	delete(g.inFlight, key)
+	g.mutex.Unlock()
+	close(r.done)
+
+	return r.result, r.err
+}
+
+// IsRemote tells us whether we reach the endpoint's daemon over the network
+// rather than through a local socket
+func (e *Endpoint) IsRemote() bool {
+	host := e.Client.DaemonHost()
+	for _, scheme := range []string{"tcp://", "http://", "https://", "ssh://"} {
+		if strings.HasPrefix(host, scheme) {
+			return true
+		}
+	}
+	return false
+}
+
+// age returns how long it's been since we last heard back from the daemon
+// along with how long that took. Both are zero if we haven't heard back yet
+func (e *Endpoint) age() (time.Duration, time.Duration) {
+	e.mutex.Lock()
+	defer e.mutex.Unlock()
+
+	if e.lastSuccess.IsZero() {
+		return 0, 0
+	}
+	return time.Since(e.lastSuccess), e.latency
+}
+
+// remoteMode works out whether to use remote mode given the configured value
+func remoteMode(configured string, endpoints []*Endpoint) bool {
+	switch configured {
+	case RemoteModeOn:
+		return true
+	case RemoteModeOff:
+		return false
+	}
+	for _, endpoint := range endpoints {
+		if endpoint.IsRemote() {
+			return true
+		}
+	}
+	return false
+}
+
+// RefreshDelay returns how long to wait before refreshing something again,
+// given the configured interval and how long the last refresh took. Locally
+// that's just the interval, but against a remote daemon we back off in
+// proportion to how slow it's being
+func (c *DockerCommand) RefreshDelay(interval time.Duration, took time.Duration) time.Duration {
+	if !c.RemoteMode {
+		return interval
+	}
+	if delay := took * remoteRefreshFactor; delay > interval {
+		return delay
+	}
+	return interval
+}
+
+// Staleness returns how long it's been since we heard back from the slowest of
+// our endpoints, if that's long enough that we've missed a few refreshes.
+// Otherwise it returns zero. We keep showing the lists we've got in the
+// meantime, so this lets the user know not to trust them
+func (c *DockerCommand) Staleness(interval time.Duration) time.Duration {
+	staleness := time.Duration(0)
+	for _, endpoint := range c.Endpoints {
+		age, latency := endpoint.age()
+		if age > staleRefreshes*c.RefreshDelay(interval, latency) && age > staleness {
+			staleness = age
+		}
+	}
+	return staleness
+}
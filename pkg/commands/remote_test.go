@@ -0,0 +1,101 @@
+package commands
+
+import (
+	"sync"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestRequestGroup is a function.
+func TestRequestGroup(t *testing.T) {
+	group := requestGroup{}
+	release := make(chan struct{})
+	var calls int32
+
+	f := func() (interface{}, error) {
+		atomic.AddInt32(&calls, 1)
+		<-release
+		return "containers", nil
+	}
+
+	wg := sync.WaitGroup{}
+	results := make([]interface{}, 5)
+	for i := range results {
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			results[i], _ = group.do("containers", f)
+		}(i)
+	}
+
+	// give every caller a chance to join the request in flight
+	time.Sleep(time.Millisecond * 50)
+	close(release)
+	wg.Wait()
+
+	assert.EqualValues(t, 1, calls)
+	for _, result := range results {
+		assert.EqualValues(t, "containers", result)
+	}
+
+	// once it's done, the next caller makes a request of its own
+	_, _ = group.do("containers", f)
+	assert.EqualValues(t, 2, calls)
+}
+
+// TestRefreshDelay is a function.
+func TestRefreshDelay(t *testing.T) {
+	type scenario struct {
+		testName   string
+		remoteMode bool
+		took       time.Duration
+		expected   time.Duration
+	}
+
+	interval := time.Millisecond * 100
+	scenarios := []scenario{
+		{"local daemons refresh at the configured interval", false, time.Millisecond * 500, interval},
+		{"fast remote daemons do too", true, time.Millisecond * 10, interval},
+		{"slow remote daemons get a breather", true, time.Millisecond * 80, time.Millisecond * 320},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.testName, func(t *testing.T) {
+			c := &DockerCommand{RemoteMode: s.remoteMode}
+			assert.EqualValues(t, s.expected, c.RefreshDelay(interval, s.took))
+		})
+	}
+}
+
+// TestRemoteMode is a function.
+func TestRemoteMode(t *testing.T) {
+	endpoints, err := NewEndpoints([]config.EndpointConfig{
+		{Name: "local", Host: "unix:///var/run/docker.sock"},
+		{Name: "remote", Host: "tcp://10.0.0.2:2375"},
+	})
+	assert.NoError(t, err)
+
+	assert.False(t, endpoints[0].IsRemote())
+	assert.True(t, endpoints[1].IsRemote())
+	assert.True(t, remoteMode(RemoteModeAuto, endpoints))
+	assert.False(t, remoteMode(RemoteModeAuto, endpoints[:1]))
+	assert.True(t, remoteMode(RemoteModeOn, endpoints[:1]))
+	assert.False(t, remoteMode(RemoteModeOff, endpoints))
+}
+
+// TestStaleness is a function.
+func TestStaleness(t *testing.T) {
+	fresh := &Endpoint{latency: time.Millisecond * 80, lastSuccess: time.Now()}
+	stale := &Endpoint{latency: time.Millisecond * 80, lastSuccess: time.Now().Add(-time.Second * 5)}
+	neverReached := &Endpoint{}
+
+	c := &DockerCommand{RemoteMode: true, Endpoints: []*Endpoint{fresh, neverReached}}
+	assert.EqualValues(t, 0, c.Staleness(time.Millisecond*100))
+
+	c.Endpoints = append(c.Endpoints, stale)
+	assert.True(t, c.Staleness(time.Millisecond*100) >= time.Second*5)
+}
@@ -32,6 +32,23 @@ func (s *Service) GetDisplayStrings(isFocused bool) []string {
 	return []string{cont.GetDisplayStatus(), cont.GetDisplaySubstatus(), s.Name, cont.GetDisplayCPUPerc()}
 }
 
+// SearchKey identifies the service and what SearchRow is built from
+func (s *Service) SearchKey() string {
+	if s.Container == nil {
+		return s.Name
+	}
+	return s.Name + " " + s.Container.ID + " " + s.Container.Name
+}
+
+// SearchRow returns what we match against when the services panel is
+// filtered: the service's name, plus its container's name and image
+func (s *Service) SearchRow() utils.SearchRow {
+	if s.Container == nil {
+		return utils.NewSearchRow([]string{s.Name}, nil)
+	}
+	return utils.NewSearchRow([]string{s.Name, s.Container.Name, s.Container.Container.Image}, nil)
+}
+
 // Remove removes the service's containers
 func (s *Service) Remove(options types.ContainerRemoveOptions) error {
 	return s.Container.Remove(options)
@@ -40,26 +57,24 @@ func (s *Service) Remove(options types.ContainerRemoveOptions) error {
 // Stop stops the service's containers
 func (s *Service) Stop() error {
 	templateString := s.OSCommand.Config.UserConfig.CommandTemplates.StopService
-	command := utils.ApplyTemplate(
+	return s.OSCommand.RunTemplate(
 		templateString,
 		s.DockerCommand.NewCommandObject(CommandObject{Service: s}),
 	)
-	return s.OSCommand.RunCommand(command)
 }
 
 // Restart restarts the service
 func (s *Service) Restart() error {
 	templateString := s.OSCommand.Config.UserConfig.CommandTemplates.RestartService
-	command := utils.ApplyTemplate(
+	return s.OSCommand.RunTemplate(
 		templateString,
 		s.DockerCommand.NewCommandObject(CommandObject{Service: s}),
 	)
-	return s.OSCommand.RunCommand(command)
 }
 
-// Attach attaches to the service
-func (s *Service) Attach() (*exec.Cmd, error) {
-	return s.Container.Attach()
+// AttachSession attaches to the service's container
+func (s *Service) AttachSession() (*Session, error) {
+	return s.Container.AttachSession()
 }
 
 // Top returns process information
@@ -84,10 +99,8 @@ func (s *Service) ViewLogs() (*exec.Cmd, error) {
 // RenderTop renders the process list of the service
 func (s *Service) RenderTop() (string, error) {
 	templateString := s.OSCommand.Config.UserConfig.CommandTemplates.ServiceTop
-	command := utils.ApplyTemplate(
+	return s.OSCommand.RunTemplateWithOutput(
 		templateString,
 		s.DockerCommand.NewCommandObject(CommandObject{Service: s}),
 	)
-
-	return s.OSCommand.RunCommandWithOutput(command)
 }
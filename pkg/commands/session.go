@@ -0,0 +1,171 @@
+package commands
+
+import (
+	"bufio"
+	"context"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"sync"
+
+	"github.com/docker/docker/api/types"
+	"github.com/go-errors/errors"
+)
+
+// execShellCommand starts the user's login shell in the container, falling
+// back to sh if we can't work out what it is
+var execShellCommand = []string{"/bin/sh", "-c", "eval $(grep ^$(id -un): /etc/passwd | cut -d : -f 7-)"}
+
+// Session is an interactive connection to a process in a container, either a
+// new process started with exec or the container's main process when we attach
+// to it. Unlike a subprocess, it goes straight over the docker API so we don't
+// need to hand the terminal over to anybody.
+type Session struct {
+	// Tty tells us whether the process is running in a pseudo-terminal. If it's
+	// not, its output won't include carriage returns and it won't echo input.
+	Tty bool
+
+	conn      types.HijackedResponse
+	reader    io.Reader
+	resize    func(width, height uint) error
+	detach    []byte
+	closeOnce sync.Once
+}
+
+// Read reads the process's output
+func (s *Session) Read(p []byte) (int, error) {
+	return s.reader.Read(p)
+}
+
+// Write sends input to the process
+func (s *Session) Write(p []byte) (int, error) {
+	return s.conn.Conn.Write(p)
+}
+
+// Resize tells the process how big its terminal is
+func (s *Session) Resize(width, height int) error {
+	if !s.Tty || width < 1 || height < 1 {
+		return nil
+	}
+	return s.resize(uint(width), uint(height))
+}
+
+// Close ends the session. If we're attached to a container this detaches from
+// it without stopping it. It is safe to call this more than once
+func (s *Session) Close() error {
+	s.closeOnce.Do(func() {
+		if s.detach != nil {
+			_, _ = s.conn.Conn.Write(s.detach)
+		}
+		s.conn.Close()
+	})
+	return nil
+}
+
+// ExecShell starts a shell in the container and returns a session connected to
+// it
+func (c *Container) ExecShell() (*Session, error) {
+	return c.Exec(execShellCommand)
+}
+
+// Exec runs the given command in the container in a pseudo-terminal
+func (c *Container) Exec(cmd []string) (*Session, error) {
+	c.Log.Warn(fmt.Sprintf("executing %v in container %s", cmd, c.Name))
+
+	ctx := context.Background()
+	exec, err := c.Client.ContainerExecCreate(ctx, c.ID, types.ExecConfig{
+		Tty:          true,
+		AttachStdin:  true,
+		AttachStdout: true,
+		AttachStderr: true,
+		Env:          []string{"TERM=xterm"},
+		Cmd:          cmd,
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	conn, err := c.Client.ContainerExecAttach(ctx, exec.ID, types.ExecStartCheck{Tty: true})
+	if err != nil {
+		return nil, err
+	}
+
+	return &Session{
+		Tty:    true,
+		conn:   conn,
+		reader: conn.Reader,
+		resize: func(width, height uint) error {
+			return c.Client.ContainerExecResize(ctx, exec.ID, types.ResizeOptions{Width: width, Height: height})
+		},
+	}, nil
+}
+
+// AttachSession attaches to the container's main process
+func (c *Container) AttachSession() (*Session, error) {
+	c.Log.Warn(fmt.Sprintf("attaching to container %s", c.Name))
+
+	if err := c.checkAttachable(); err != nil {
+		return nil, err
+	}
+
+	// we ask the daemon to detach us when we send ctrl+q. Simply hanging up
+	// would close the container's stdin, which some containers take as their
+	// cue to exit.
+	ctx := context.Background()
+	conn, err := c.Client.ContainerAttach(ctx, c.ID, types.ContainerAttachOptions{
+		Stream:     true,
+		Stdin:      true,
+		Stdout:     true,
+		Stderr:     true,
+		DetachKeys: "ctrl-q",
+	})
+	if err != nil {
+		return nil, err
+	}
+
+	tty := c.Details.Config.Tty
+	var reader io.Reader = conn.Reader
+	if !tty {
+		reader = &demuxReader{reader: conn.Reader}
+	}
+
+	return &Session{
+		Tty:    tty,
+		conn:   conn,
+		reader: reader,
+		detach: []byte{0x11},
+		resize: func(width, height uint) error {
+			return c.Client.ContainerResize(ctx, c.ID, types.ResizeOptions{Width: width, Height: height})
+		},
+	}, nil
+}
+
+// demuxReader reads the output of a process without a pseudo-terminal. The
+// daemon multiplexes stdout and stderr into one stream where each frame has an
+// 8 byte header: the stream number, three bytes of padding, and the frame size
+// as a big-endian uint32. We don't distinguish between stdout and stderr, so we
+// just strip the headers.
+type demuxReader struct {
+	reader    *bufio.Reader
+	remaining int
+}
+
+func (d *demuxReader) Read(p []byte) (int, error) {
+	for d.remaining == 0 {
+		header := make([]byte, 8)
+		if _, err := io.ReadFull(d.reader, header); err != nil {
+			if err == io.ErrUnexpectedEOF {
+				return 0, errors.New("unexpected end of container output")
+			}
+			return 0, err
+		}
+		d.remaining = int(binary.BigEndian.Uint32(header[4:]))
+	}
+
+	if len(p) > d.remaining {
+		p = p[:d.remaining]
+	}
+	n, err := d.reader.Read(p)
+	d.remaining -= n
+	return n, err
+}
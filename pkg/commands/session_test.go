@@ -0,0 +1,61 @@
+package commands
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/binary"
+	"io/ioutil"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+func frame(stream byte, payload string) []byte {
+	header := []byte{stream, 0, 0, 0, 0, 0, 0, 0}
+	binary.BigEndian.PutUint32(header[4:], uint32(len(payload)))
+	return append(header, payload...)
+}
+
+// TestDemuxReader is a function.
+func TestDemuxReader(t *testing.T) {
+	type scenario struct {
+		name          string
+		input         []byte
+		expected      string
+		expectedError string
+	}
+
+	scenarios := []scenario{
+		{
+			"stdout and stderr are interleaved",
+			append(append(frame(1, "hello "), frame(2, "from stderr ")...), frame(1, "world")...),
+			"hello from stderr world",
+			"",
+		},
+		{
+			"empty frames are skipped",
+			append(frame(1, ""), frame(1, "ok")...),
+			"ok",
+			"",
+		},
+		{
+			"truncated header",
+			append(frame(1, "ok"), 1, 0, 0),
+			"ok",
+			"unexpected end of container output",
+		},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.name, func(t *testing.T) {
+			reader := &demuxReader{reader: bufio.NewReader(bytes.NewReader(s.input))}
+			output, err := ioutil.ReadAll(reader)
+			assert.EqualValues(t, s.expected, string(output))
+			if s.expectedError == "" {
+				assert.NoError(t, err)
+			} else {
+				assert.EqualError(t, err, s.expectedError)
+			}
+		})
+	}
+}
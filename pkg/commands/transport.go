@@ -0,0 +1,321 @@
+package commands
+
+import (
+	"bytes"
+	"context"
+	"net"
+	"net/http"
+	"net/http/httptrace"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/docker/docker/client"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
+)
+
+// Each endpoint has two clients, with a connection pool each: one for short
+// requests (lists, inspects, stopping a container) and one for streams that
+// stay open for as long as we're watching something (stats, events, pulls).
+// With a single pool, every running container's stats stream holds on to a
+// connection, and a list request has to wait for a connection to free up or
+// set up a new one alongside all the streams being set up
+const (
+	// requestIdleConnections is how many connections we keep open for short
+	// requests between refreshes. We make a handful of requests at once on
+	// each refresh, and Go's default of two means setting up new connections
+	// for most of them
+	requestIdleConnections = 16
+
+	// requestMaxConnections caps how many short requests we have going at
+	// once, so that a burst of them (e.g. after stopping fifty containers)
+	// doesn't open fifty sockets to the daemon
+	requestMaxConnections = 32
+
+	// streamIdleConnections is how many connections we keep for streams. A
+	// stream's connection can only be reused once it has been read to the end,
+	// which rarely happens, so there's little point in keeping many
+	streamIdleConnections = 2
+
+	// idleConnectionTimeout is how long an unused connection stays open
+	idleConnectionTimeout = 90 * time.Second
+
+	// tcpKeepAlive is how often we check that a TCP connection to the daemon is
+	// still there, so that a stream through a NAT or load balancer that has
+	// silently dropped it doesn't hang forever
+	tcpKeepAlive = 30 * time.Second
+)
+
+// PoolStats tells us how a connection pool to the daemon is being used. The
+// request counts only include requests made with the pool's context
+type PoolStats struct {
+	OpenSockets    int64
+	Dials          int64
+	DialErrors     int64
+	DialTime       time.Duration
+	BytesRead      int64
+	BytesWritten   int64
+	Requests       int64
+	Reused         int64
+	ConnectionWait time.Duration
+}
+
+// connectionPool counts what happens on one of an endpoint's transports. All
+// fields are updated atomically
+type connectionPool struct {
+	openSockets    int64
+	dials          int64
+	dialErrors     int64
+	dialTime       int64
+	bytesRead      int64
+	bytesWritten   int64
+	requests       int64
+	reused         int64
+	connectionWait int64
+
+	// metrics is where we record how long the daemon takes to answer each
+	// request. It's nil unless the internals tab is switched on, and it's set
+	// before we make any requests
+	metrics *metrics.Metrics
+	// tracer is where we record spans of how long each request waits on the
+	// daemon. Like metrics, it's set before we make any requests
+	tracer *tracing.Tracer
+}
+
+// Stats returns a snapshot of the pool's counters
+func (p *connectionPool) Stats() PoolStats {
+	return PoolStats{
+		OpenSockets:    atomic.LoadInt64(&p.openSockets),
+		Dials:          atomic.LoadInt64(&p.dials),
+		DialErrors:     atomic.LoadInt64(&p.dialErrors),
+		DialTime:       time.Duration(atomic.LoadInt64(&p.dialTime)),
+		BytesRead:      atomic.LoadInt64(&p.bytesRead),
+		BytesWritten:   atomic.LoadInt64(&p.bytesWritten),
+		Requests:       atomic.LoadInt64(&p.requests),
+		Reused:         atomic.LoadInt64(&p.reused),
+		ConnectionWait: time.Duration(atomic.LoadInt64(&p.connectionWait)),
+	}
+}
+
+// context returns a context to make a request with, which records whether the
+// request got an idle connection and how long it waited for one. When we're
+// tracing, it also records a span from asking for a connection to the first
+// byte of the response, which is the time we spent on the daemon rather than
+// on decoding what it sent back
+func (p *connectionPool) context() context.Context {
+	var start time.Time
+	var span tracing.Span
+	return httptrace.WithClientTrace(context.Background(), &httptrace.ClientTrace{
+		GetConn: func(string) {
+			start = time.Now()
+			// this is called on the goroutine making the request, so the span sits
+			// under whatever that goroutine was doing
+			span = p.tracer.Start("daemon", "waiting on daemon")
+		},
+		GotFirstResponseByte: func() {
+			span.End()
+		},
+		GotConn: func(info httptrace.GotConnInfo) {
+			atomic.AddInt64(&p.requests, 1)
+			if info.Reused {
+				atomic.AddInt64(&p.reused, 1)
+			}
+			atomic.AddInt64(&p.connectionWait, int64(time.Since(start)))
+		},
+	})
+}
+
+// newPooledClient returns a docker client for the given host (or the one from
+// the environment if host is empty) whose transport counts what it does into
+// pool. Docker gives us a bare transport with Go's defaults, so we set the
+// limits ourselves
+func newPooledClient(host string, pool *connectionPool, idleConnections int, maxConnections int) (*client.Client, error) {
+	opts := []func(*client.Client) error{client.FromEnv, client.WithVersion(APIVersion)}
+	if host != "" {
+		opts = append(opts, client.WithHost(host))
+	}
+	cli, err := client.NewClientWithOpts(opts...)
+	if err != nil {
+		return nil, err
+	}
+
+	// HTTPClient hands us the client's own transport, not a copy of it
+	transport, ok := cli.HTTPClient().Transport.(*http.Transport)
+	if !ok {
+		return cli, nil
+	}
+	transport.MaxIdleConns = idleConnections
+	transport.MaxIdleConnsPerHost = idleConnections
+	transport.MaxConnsPerHost = maxConnections
+	transport.IdleConnTimeout = idleConnectionTimeout
+	pool.instrument(transport)
+
+	return cli, nil
+}
+
+// instrument wraps the transport's dialer so that we can count the sockets it
+// opens, and turns on keep-alives for TCP connections
+func (p *connectionPool) instrument(transport *http.Transport) {
+	dial := transport.DialContext
+	if dial == nil && transport.Dial != nil {
+		plainDial := transport.Dial
+		dial = func(_ context.Context, network string, addr string) (net.Conn, error) {
+			return plainDial(network, addr)
+		}
+	}
+	if dial == nil {
+		dial = (&net.Dialer{}).DialContext
+	}
+
+	transport.Dial = nil
+	transport.DialContext = func(ctx context.Context, network string, addr string) (net.Conn, error) {
+		start := time.Now()
+		conn, err := dial(ctx, network, addr)
+		atomic.AddInt64(&p.dials, 1)
+		atomic.AddInt64(&p.dialTime, int64(time.Since(start)))
+		if err != nil {
+			atomic.AddInt64(&p.dialErrors, 1)
+			return nil, err
+		}
+
+		if tcpConn, ok := conn.(*net.TCPConn); ok {
+			_ = tcpConn.SetKeepAlive(true)
+			_ = tcpConn.SetKeepAlivePeriod(tcpKeepAlive)
+		}
+
+		atomic.AddInt64(&p.openSockets, 1)
+		return &countedConn{Conn: conn, pool: p}, nil
+	}
+}
+
+// countedConn is a connection that counts the bytes going through it, and
+// lets its pool know when it's closed
+type countedConn struct {
+	net.Conn
+	pool      *connectionPool
+	closeOnce sync.Once
+
+	// when we're recording metrics, these are the request we're waiting on a
+	// response to and when we sent it. Go writes requests and reads responses
+	// on separate goroutines, hence the mutex
+	requestMutex sync.Mutex
+	requestName  string
+	requestStart time.Time
+}
+
+func (c *countedConn) Read(b []byte) (int, error) {
+	n, err := c.Conn.Read(b)
+	atomic.AddInt64(&c.pool.bytesRead, int64(n))
+	if n > 0 && c.pool.metrics != nil {
+		c.responseStarted()
+	}
+	return n, err
+}
+
+func (c *countedConn) Write(b []byte) (int, error) {
+	if c.pool.metrics != nil {
+		c.requestStarted(b)
+	}
+	n, err := c.Conn.Write(b)
+	atomic.AddInt64(&c.pool.bytesWritten, int64(n))
+	return n, err
+}
+
+// requestStarted notes the time if we're writing the start of a request. We
+// time requests from down here because the docker client needs its transport
+// to be an *http.Transport, so we can't wrap it to time them from up there
+func (c *countedConn) requestStarted(b []byte) {
+	name, ok := requestName(b)
+	if !ok {
+		return
+	}
+	c.requestMutex.Lock()
+	c.requestName = name
+	c.requestStart = time.Now()
+	c.requestMutex.Unlock()
+}
+
+// responseStarted records how long the daemon took to start answering the
+// request we're waiting on, if any. For streams like stats and logs that's
+// how long it took to send the headers
+func (c *countedConn) responseStarted() {
+	c.requestMutex.Lock()
+	name, start := c.requestName, c.requestStart
+	c.requestName = ""
+	c.requestMutex.Unlock()
+
+	if name != "" {
+		c.pool.metrics.ObserveAPI(name, time.Since(start))
+	}
+}
+
+func (c *countedConn) Close() error {
+	c.closeOnce.Do(func() {
+		atomic.AddInt64(&c.pool.openSockets, -1)
+	})
+	return c.Conn.Close()
+}
+
+// CloseWrite lets attach sessions (which hijack one of our connections) close
+// their end of the connection like they would with the underlying one
+func (c *countedConn) CloseWrite() error {
+	if closeWriter, ok := c.Conn.(interface{ CloseWrite() error }); ok {
+		return closeWriter.CloseWrite()
+	}
+	return nil
+}
+
+// idCollections are the parts of the API whose paths have an ID or name after
+// them, e.g. /containers/{id}/json
+var idCollections = map[string]bool{
+	"containers": true, "images": true, "volumes": true, "networks": true, "exec": true,
+	"plugins": true, "services": true, "tasks": true, "secrets": true, "configs": true,
+	"nodes": true, "distribution": true,
+}
+
+// collectionActions are what can come straight after an idCollection without an
+// ID in between, e.g. /containers/json
+var collectionActions = map[string]bool{
+	"json": true, "create": true, "prune": true, "search": true, "load": true, "get": true,
+}
+
+// requestName returns a name for the HTTP request that b starts, with the API
+// version and any IDs taken out so that e.g. inspecting each of your
+// containers counts towards the same thing: 'GET /containers/{id}/json'. It
+// returns false if b isn't the start of a request. A request over TLS never
+// looks like one from down here, so those aren't timed
+func requestName(b []byte) (string, bool) {
+	end := bytes.Index(b, []byte("\r\n"))
+	if end < 0 {
+		return "", false
+	}
+	fields := strings.Fields(string(b[:end]))
+	if len(fields) != 3 || !strings.HasPrefix(fields[2], "HTTP/1.") || !strings.HasPrefix(fields[1], "/") {
+		return "", false
+	}
+	method, path := fields[0], fields[1]
+
+	if i := strings.IndexByte(path, '?'); i >= 0 {
+		path = path[:i]
+	}
+	segments := strings.Split(strings.TrimPrefix(path, "/"), "/")
+	if len(segments) > 1 && strings.HasPrefix(segments[0], "v") && strings.Contains(segments[0], ".") {
+		segments = segments[1:]
+	}
+
+	// image names can have slashes in them, so everything between the
+	// collection and the action at the end is the ID
+	if idCollections[segments[0]] && len(segments) > 1 {
+		switch {
+		case len(segments) == 2 && collectionActions[segments[1]]:
+		case len(segments) == 2:
+			segments = []string{segments[0], "{id}"}
+		default:
+			segments = []string{segments[0], "{id}", segments[len(segments)-1]}
+		}
+	}
+
+	return method + " /" + strings.Join(segments, "/"), true
+}
@@ -0,0 +1,79 @@
+package commands
+
+import (
+	"fmt"
+	"net/http"
+	"net/http/httptest"
+	"strings"
+	"testing"
+
+	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestEndpointConnectionPools is a function.
+func TestEndpointConnectionPools(t *testing.T) {
+	server := httptest.NewServer(http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		if strings.HasSuffix(r.URL.Path, "/stats") {
+			fmt.Fprintln(w, "{}")
+			return
+		}
+		fmt.Fprint(w, "[]")
+	}))
+	defer server.Close()
+
+	endpoints, err := NewEndpoints([]config.EndpointConfig{{Host: "tcp://" + strings.TrimPrefix(server.URL, "http://")}})
+	assert.NoError(t, err)
+	endpoint := endpoints[0]
+
+	// one after the other, every list should reuse the first list's connection
+	for i := 0; i < 3; i++ {
+		_, err := endpoint.listContainers()
+		assert.NoError(t, err)
+	}
+
+	requests, streams := endpoint.PoolStats()
+	assert.EqualValues(t, 1, requests.Dials)
+	assert.EqualValues(t, 1, requests.OpenSockets)
+	assert.EqualValues(t, 3, requests.Requests)
+	assert.EqualValues(t, 2, requests.Reused)
+	assert.True(t, requests.BytesRead > 0 && requests.BytesWritten > 0)
+	assert.EqualValues(t, PoolStats{}, streams)
+
+	// a stream gets a connection of its own rather than taking the idle one
+	stats, err := endpoint.StreamClient.ContainerStats(endpoint.StreamContext(), "abc", true)
+	assert.NoError(t, err)
+	stats.Body.Close()
+
+	requests, streams = endpoint.PoolStats()
+	assert.EqualValues(t, 1, requests.Dials)
+	assert.EqualValues(t, 1, streams.Dials)
+	assert.EqualValues(t, 1, streams.Requests)
+}
+
+// TestRequestName is a function.
+func TestRequestName(t *testing.T) {
+	type scenario struct {
+		request      string
+		expected     string
+		expectedOkay bool
+	}
+
+	scenarios := []scenario{
+		{"GET /v1.25/containers/json?all=1 HTTP/1.1\r\nHost: docker\r\n\r\n", "GET /containers/json", true},
+		{"GET /v1.25/containers/4f2a9c/stats?stream=1 HTTP/1.1\r\n", "GET /containers/{id}/stats", true},
+		{"DELETE /v1.25/volumes/my-volume HTTP/1.1\r\n", "DELETE /volumes/{id}", true},
+		{"GET /v1.25/images/library/nginx:latest/json HTTP/1.1\r\n", "GET /images/{id}/json", true},
+		{"GET /_ping HTTP/1.1\r\n", "GET /_ping", true},
+		{"GET /v1.25/system/df HTTP/1.1\r\n", "GET /system/df", true},
+		// a request body, or what you type into an attached container
+		{"{\"Detach\": false}", "", false},
+		{"GET /etc/passwd\r\n", "", false},
+	}
+
+	for _, s := range scenarios {
+		name, ok := requestName([]byte(s.request))
+		assert.EqualValues(t, s.expectedOkay, ok)
+		assert.EqualValues(t, s.expected, name)
+	}
+}
@@ -0,0 +1,171 @@
+package commands
+
+import (
+	"sort"
+	"sync"
+)
+
+// indexedContainer is what we've indexed a container under, so that we can
+// tell whether it needs re-indexing
+type indexedContainer struct {
+	name    string
+	imageID string
+	volumes []string
+}
+
+// UsageIndex maps images and volumes to the containers that use them, so that
+// we can tell whether something is in use without asking the daemon. It is
+// updated incrementally: only containers that have appeared, gone, or changed
+// what they use are touched on each refresh
+type UsageIndex struct {
+	mutex      sync.RWMutex
+	containers map[string]indexedContainer
+	byImage    map[string]map[string]bool
+	byVolume   map[string]map[string]bool
+	version    int
+}
+
+// NewUsageIndex returns a new, empty, UsageIndex
+func NewUsageIndex() *UsageIndex {
+	return &UsageIndex{
+		containers: map[string]indexedContainer{},
+		byImage:    map[string]map[string]bool{},
+		byVolume:   map[string]map[string]bool{},
+	}
+}
+
+// Update brings the index in line with the given containers. Only volume
+// mounts count: bind mounts don't belong to any volume
+func (x *UsageIndex) Update(containers []*Container) {
+	x.mutex.Lock()
+	defer x.mutex.Unlock()
+
+	changed := false
+	seen := make(map[string]bool, len(containers))
+	for _, container := range containers {
+		// with several endpoints, the same image or volume name on two daemons
+		// is two different things, so everything is keyed by endpoint too
+		endpoint := container.Endpoint
+		id := endpoint.Qualify(container.ID)
+		seen[id] = true
+
+		entry := indexedContainer{name: container.Name, imageID: endpoint.Qualify(container.Container.ImageID)}
+		for _, mount := range container.Container.Mounts {
+			if mount.Type == "volume" && mount.Name != "" {
+				entry.volumes = append(entry.volumes, endpoint.Qualify(mount.Name))
+			}
+		}
+
+		if existing, ok := x.containers[id]; ok {
+			if existing.equals(entry) {
+				continue
+			}
+			x.remove(id, existing)
+		}
+		x.add(id, entry)
+		changed = true
+	}
+
+	for id, existing := range x.containers {
+		if !seen[id] {
+			x.remove(id, existing)
+			changed = true
+		}
+	}
+
+	if changed {
+		x.version++
+	}
+}
+
+func (x *UsageIndex) add(containerID string, entry indexedContainer) {
+	x.containers[containerID] = entry
+	addToSet(x.byImage, entry.imageID, containerID)
+	for _, volume := range entry.volumes {
+		addToSet(x.byVolume, volume, containerID)
+	}
+}
+
+func (x *UsageIndex) remove(containerID string, entry indexedContainer) {
+	delete(x.containers, containerID)
+	removeFromSet(x.byImage, entry.imageID, containerID)
+	for _, volume := range entry.volumes {
+		removeFromSet(x.byVolume, volume, containerID)
+	}
+}
+
+func addToSet(sets map[string]map[string]bool, key string, value string) {
+	if sets[key] == nil {
+		sets[key] = map[string]bool{}
+	}
+	sets[key][value] = true
+}
+
+func removeFromSet(sets map[string]map[string]bool, key string, value string) {
+	delete(sets[key], value)
+	if len(sets[key]) == 0 {
+		delete(sets, key)
+	}
+}
+
+func (e indexedContainer) equals(other indexedContainer) bool {
+	if e.name != other.name || e.imageID != other.imageID || len(e.volumes) != len(other.volumes) {
+		return false
+	}
+	for i := range e.volumes {
+		if e.volumes[i] != other.volumes[i] {
+			return false
+		}
+	}
+	return true
+}
+
+// Version is bumped whenever the index changes, so that callers can tell
+// whether they need to re-render anything that depends on it
+func (x *UsageIndex) Version() int {
+	x.mutex.RLock()
+	defer x.mutex.RUnlock()
+
+	return x.version
+}
+
+// ImageUseCount returns how many containers (running or not) use the image
+func (x *UsageIndex) ImageUseCount(imageID string) int {
+	x.mutex.RLock()
+	defer x.mutex.RUnlock()
+
+	return len(x.byImage[imageID])
+}
+
+// VolumeUseCount returns how many containers (running or not) mount the volume
+func (x *UsageIndex) VolumeUseCount(volumeName string) int {
+	x.mutex.RLock()
+	defer x.mutex.RUnlock()
+
+	return len(x.byVolume[volumeName])
+}
+
+// ImageContainerNames returns the names of the containers using the image
+func (x *UsageIndex) ImageContainerNames(imageID string) []string {
+	x.mutex.RLock()
+	defer x.mutex.RUnlock()
+
+	return x.names(x.byImage[imageID])
+}
+
+// VolumeContainerNames returns the names of the containers mounting the volume
+func (x *UsageIndex) VolumeContainerNames(volumeName string) []string {
+	x.mutex.RLock()
+	defer x.mutex.RUnlock()
+
+	return x.names(x.byVolume[volumeName])
+}
+
+func (x *UsageIndex) names(containerIDs map[string]bool) []string {
+	names := make([]string, 0, len(containerIDs))
+	for id := range containerIDs {
+		names = append(names, x.containers[id].name)
+	}
+	sort.Strings(names)
+	return names
+}
@@ -0,0 +1,52 @@
+package commands
+
+import (
+	"testing"
+
+	"github.com/docker/docker/api/types"
+	"github.com/stretchr/testify/assert"
+)
+
+func newIndexedContainer(id string, name string, imageID string, volumes ...string) *Container {
+	mounts := []types.MountPoint{{Type: "bind", Source: "/tmp", Destination: "/tmp"}}
+	for _, volume := range volumes {
+		mounts = append(mounts, types.MountPoint{Type: "volume", Name: volume})
+	}
+	return &Container{ID: id, Name: name, Container: types.Container{ImageID: imageID, Mounts: mounts}}
+}
+
+// TestUsageIndex is a function.
+func TestUsageIndex(t *testing.T) {
+	index := NewUsageIndex()
+
+	index.Update([]*Container{
+		newIndexedContainer("1", "web", "sha256:app", "data"),
+		newIndexedContainer("2", "worker", "sha256:app", "data", "cache"),
+		newIndexedContainer("3", "db", "sha256:postgres", "pgdata"),
+	})
+	version := index.Version()
+
+	assert.EqualValues(t, 2, index.ImageUseCount("sha256:app"))
+	assert.EqualValues(t, []string{"web", "worker"}, index.ImageContainerNames("sha256:app"))
+	assert.EqualValues(t, 2, index.VolumeUseCount("data"))
+	assert.EqualValues(t, 0, index.VolumeUseCount("/tmp"))
+
+	// nothing has changed so the index shouldn't have either
+	index.Update([]*Container{
+		newIndexedContainer("1", "web", "sha256:app", "data"),
+		newIndexedContainer("2", "worker", "sha256:app", "data", "cache"),
+		newIndexedContainer("3", "db", "sha256:postgres", "pgdata"),
+	})
+	assert.EqualValues(t, version, index.Version())
+
+	// the worker has gone and the web container has been recreated from a new image
+	index.Update([]*Container{
+		newIndexedContainer("1", "web", "sha256:app2", "data"),
+		newIndexedContainer("3", "db", "sha256:postgres", "pgdata"),
+	})
+	assert.NotEqual(t, version, index.Version())
+	assert.EqualValues(t, 0, index.ImageUseCount("sha256:app"))
+	assert.EqualValues(t, 1, index.ImageUseCount("sha256:app2"))
+	assert.EqualValues(t, []string{"web"}, index.VolumeContainerNames("data"))
+	assert.EqualValues(t, 0, index.VolumeUseCount("cache"))
+}
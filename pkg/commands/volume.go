@@ -1,12 +1,14 @@
 package commands
 
 import (
-	"context"
+	"fmt"
 	"sort"
 
 	"github.com/docker/docker/api/types"
 	"github.com/docker/docker/api/types/filters"
 	"github.com/docker/docker/client"
+	"github.com/fatih/color"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
 	"github.com/sirupsen/logrus"
 )
 
@@ -14,55 +16,116 @@ import (
 type Volume struct {
 	Name          string
 	Volume        *types.Volume
+	Endpoint      *Endpoint
 	Client        *client.Client
 	OSCommand     *OSCommand
 	Log           *logrus.Entry
 	DockerCommand LimitedDockerCommand
+	// ContainerCount is how many containers (running or not) mount the volume
+	ContainerCount int
+	// Size is -1 until we've worked out the disk usage, or if the volume's
+	// driver can't tell us
+	Size int64
 }
 
 // GetDisplayStrings returns the dispaly string of Container
 func (v *Volume) GetDisplayStrings(isFocused bool) []string {
-	return []string{v.Volume.Driver, v.Name}
+	inUse := ""
+	if v.ContainerCount > 0 {
+		inUse = utils.ColoredString(fmt.Sprintf("%d", v.ContainerCount), color.FgGreen)
+	}
+	size := ""
+	if v.Size >= 0 {
+		size = utils.FormatDecimalBytes(int(v.Size))
+	}
+	return []string{v.Volume.Driver, v.Endpoint.Qualify(v.Name), size, inUse}
 }
 
-// RefreshVolumes gets the volumes and stores them
-func (c *DockerCommand) RefreshVolumes() error {
-	result, err := c.Client.VolumeList(context.Background(), filters.Args{})
-	if err != nil {
+// SearchKey identifies the volume and what SearchRow is built from, which is
+// all fixed when the volume's created
+func (v *Volume) SearchKey() string {
+	return v.Endpoint.Qualify(v.Name)
+}
+
+// SearchRow returns what we match against when the volumes panel is
+// filtered: the volume's name, driver and labels
+func (v *Volume) SearchRow() utils.SearchRow {
+	return utils.NewSearchRow([]string{v.Endpoint.Qualify(v.Name), v.Volume.Driver}, v.Volume.Labels)
+}
+
+// UsageKey is what the usage index knows the volume by
+func (v *Volume) UsageKey() string {
+	return v.Endpoint.Qualify(v.Name)
+}
+
+// RefreshVolumes gets the volumes and stores them. complete is false if any of
+// the endpoints failed to answer, in which case we've kept whatever we had for
+// them
+func (c *DockerCommand) RefreshVolumes() (complete bool, err error) {
+	volumeLists := make([][]*types.Volume, len(c.Endpoints))
+	failed, err := forEachEndpoint(c.Endpoints, func(i int, endpoint *Endpoint) error {
+		volumes, err := endpoint.listVolumes()
+		volumeLists[i] = volumes
 		return err
+	})
+	if err != nil {
+		return false, err
 	}
 
-	volumes := result.Volumes
+	c.listMutex.Lock()
+	defer c.listMutex.Unlock()
 
-	ownVolumes := make([]*Volume, len(volumes))
+	ownVolumes := []*Volume{}
 
-	sort.Slice(volumes, func(i, j int) bool {
-		return volumes[i].Name < volumes[j].Name
-	})
+	for endpointIndex, volumes := range volumeLists {
+		endpoint := c.Endpoints[endpointIndex]
+		// we keep showing what we had for an endpoint that failed to answer
+		if failed[endpointIndex] {
+			for _, volume := range c.lastVolumes {
+				if volume.Endpoint == endpoint {
+					ownVolumes = append(ownVolumes, volume)
+				}
+			}
+			continue
+		}
 
-	for i, volume := range volumes {
-		ownVolumes[i] = &Volume{
-			Name:          volume.Name,
-			Volume:        volume,
-			Client:        c.Client,
-			OSCommand:     c.OSCommand,
-			Log:           c.Log,
-			DockerCommand: c,
+		sort.Slice(volumes, func(i, j int) bool {
+			return volumes[i].Name < volumes[j].Name
+		})
+
+		for _, volume := range volumes {
+			ownVolumes = append(ownVolumes, &Volume{
+				Name:          volume.Name,
+				Volume:        volume,
+				Size:          -1,
+				Endpoint:      endpoint,
+				Client:        endpoint.Client,
+				OSCommand:     c.OSCommand,
+				Log:           c.Log,
+				DockerCommand: c,
+			})
 		}
 	}
 
+	c.lastVolumes = ownVolumes
 	c.Volumes = ownVolumes
 
-	return nil
+	complete = true
+	for _, endpointFailed := range failed {
+		complete = complete && !endpointFailed
+	}
+	return complete, nil
 }
 
-// PruneVolumes prunes volumes
+// PruneVolumes prunes volumes on every endpoint
 func (c *DockerCommand) PruneVolumes() error {
-	_, err := c.Client.VolumesPrune(context.Background(), filters.Args{})
-	return err
+	return onEveryEndpoint(c.Endpoints, func(endpoint *Endpoint) error {
+		_, err := endpoint.Client.VolumesPrune(endpoint.Context(), filters.Args{})
+		return err
+	})
 }
 
 // Remove removes the volume
 func (v *Volume) Remove(force bool) error {
-	return v.Client.VolumeRemove(context.Background(), v.Name, force)
+	return v.Client.VolumeRemove(v.Endpoint.Context(), v.Name, force)
 }
@@ -63,6 +63,19 @@ type UserConfig struct {
 	// Stats determines how long lazydocker will gather container stats for, and
 	// what stat info to graph
 	Stats StatsConfig `yaml:"stats,omitempty"`
+
+	// Jobs determines how background jobs (commands with `background: true`)
+	// are run
+	Jobs JobsConfig `yaml:"jobs,omitempty"`
+
+	// Endpoints are the docker daemons to show in the one session, e.g. a
+	// rootless and a rootful daemon on the same machine. Their containers,
+	// images and volumes are listed together, each name prefixed with the name
+	// of the endpoint it came from. Services are matched up with containers on
+	// the first endpoint, so that should be the daemon docker-compose talks to.
+	// If you leave this empty we just talk to whichever daemon your environment
+	// points at
+	Endpoints []EndpointConfig `yaml:"endpoints,omitempty"`
 }
 
 // ThemeConfig is for setting the colors of panels and some text.
@@ -109,6 +122,18 @@ type GuiConfig struct {
 
 	// WrapMainPanel determines whether we use word wrap on the main panel
 	WrapMainPanel bool `yaml:"wrapMainPanel,omitempty"`
+
+	// BatchConcurrency determines how many items we act on at once when you've
+	// marked several items in a list panel and then stop/restart/remove them.
+	// Docker is happy to handle a few requests in parallel, but if you're
+	// working against a slow remote daemon you may want to turn this down
+	BatchConcurrency int `yaml:"batchConcurrency,omitempty"`
+
+	// ShowInternals adds an 'internals' tab to the project panel, showing how
+	// long lazydocker is spending on docker API calls, commands, refreshes and
+	// drawing. It's for working out whether lazydocker or the daemon is to
+	// blame when things are slow, so it's off by default
+	ShowInternals bool `yaml:"showInternals,omitempty"`
 }
 
 // CommandTemplatesConfig determines what commands actually get called when we
@@ -200,6 +225,40 @@ type UpdateConfig struct {
 	// It expects a valid duration like: 100ms, 2s, 200ns
 	// for docs see: https://golang.org/pkg/time/#ParseDuration
 	DockerRefreshInterval time.Duration `yaml:"dockerRefreshInterval,omitempty"`
+
+	// RemoteMode is for when the daemon is at the other end of a slow network
+	// connection. We then wait longer between refreshes the longer the daemon
+	// takes to answer, keep more connections open to it, and tell you when the
+	// lists you're looking at are out of date. It can be 'on', 'off' or 'auto',
+	// which turns it on if any endpoint is a tcp:// or ssh:// address
+	RemoteMode string `yaml:"remoteMode,omitempty"`
+}
+
+// JobsConfig determines how many background jobs we run at once and how much
+// of their output we hold on to
+type JobsConfig struct {
+	// MaxConcurrent is the number of jobs that can run at the same time. Any
+	// more than that will be queued up until a running job finishes. Pulls and
+	// builds tend to saturate your network or CPU anyway so there's not much to
+	// gain by running lots of them at once
+	MaxConcurrent int `yaml:"maxConcurrent,omitempty"`
+
+	// MaxOutputLines is the number of lines of output we keep for each job. Once
+	// a job goes past this, its oldest lines are dropped. The same limit applies
+	// to custom commands streamed into the main panel
+	MaxOutputLines int `yaml:"maxOutputLines,omitempty"`
+}
+
+// EndpointConfig is a docker daemon to connect to
+type EndpointConfig struct {
+	// Name is shown in front of everything from this daemon. It defaults to
+	// the host
+	Name string `yaml:"name,omitempty"`
+
+	// Host is the daemon's address, in the same form as DOCKER_HOST e.g.
+	// unix:///run/user/1000/docker.sock or tcp://192.168.1.10:2375. If it's
+	// empty we use the daemon from the environment
+	Host string `yaml:"host,omitempty"`
 }
 
 // GraphConfig specifies how to make a graph of recorded container stats
@@ -279,15 +338,37 @@ type CustomCommand struct {
 
 	// Attach tells us whether to switch to a subprocess to interact with the
 	// called program, or just read its output. If Attach is set to false, the
-	// command will run in the background. I'm open to the idea of having a third
-	// option where the output plays in the main panel.
+	// command will run in the background (see also Stream and Background).
 	Attach bool `yaml:"attach"`
 
+	// Stream tells us to play the command's output in the main panel as it
+	// runs. If you've marked several items, the command is run against each of
+	// them at once and each gets its own tab in the main panel (switch between
+	// them with '[' and ']'). Like the logs, the command is killed when you
+	// move on to something else. If Attach is also set, Attach wins.
+	Stream bool `yaml:"stream"`
+
+	// Background tells us to run the command as a background job rather than
+	// blocking on it. The job's output can be seen in the 'jobs' tab of the
+	// project panel while you carry on using lazydocker. This is what you want
+	// for things like pulls and builds that take a while and that you don't
+	// need to interact with. Attach and Stream both take precedence over this.
+	Background bool `yaml:"background"`
+
 	// Command is the command we want to run. We can use the go templates here as
 	// well. One example might be `{{ .DockerCompose }} exec {{ .Service.Name }}
 	// /bin/sh`
 	Command string `yaml:"command"`
 
+	// Argv is an alternative to Command where you give the program and each of
+	// its arguments separately, e.g. ['docker', 'restart', '{{ .Container.ID }}'].
+	// Each argument is templated on its own and the program is run directly
+	// rather than through a shell, so there's no quoting to worry about. If
+	// Argv is set, Command is ignored. Commands without any shell syntax (pipes,
+	// variables, etc) are run directly anyway, so you only need this if your
+	// arguments contain characters the shell would otherwise interpret.
+	Argv []string `yaml:"argv,omitempty"`
+
 	// ServiceNames is used to restrict this command to just one or more services.
 	// An example might be 'rails migrate' for your rails api service(s). This
 	// field has no effect on customcommands under the 'communications' part of
@@ -321,6 +402,8 @@ func GetDefaultConfig() UserConfig {
 			ShowAllContainers: false,
 			ReturnImmediately: false,
 			WrapMainPanel:     false,
+			BatchConcurrency:  4,
+			ShowInternals:     false,
 		},
 		Reporting:     "undetermined",
 		ConfirmOnQuit: false,
@@ -359,23 +442,23 @@ func GetDefaultConfig() UserConfig {
 					Command: "{{ .DockerCompose }} up -d",
 				},
 				{
-					Name:    "up (attached)",
-					Command: "{{ .DockerCompose }} up",
-					Attach:  true,
+					Name:       "up (attached)",
+					Command:    "{{ .DockerCompose }} up",
+					Background: true,
 				},
 				{
 					Name:    "stop",
 					Command: "{{ .DockerCompose }} stop",
 				},
 				{
-					Name:    "pull",
-					Command: "{{ .DockerCompose }} pull",
-					Attach:  true,
+					Name:       "pull",
+					Command:    "{{ .DockerCompose }} pull",
+					Background: true,
 				},
 				{
-					Name:    "build",
-					Command: "{{ .DockerCompose }} build --parallel --force-rm",
-					Attach:  true,
+					Name:       "build",
+					Command:    "{{ .DockerCompose }} build --parallel --force-rm",
+					Background: true,
 				},
 				{
 					Name:    "down",
@@ -401,6 +484,11 @@ func GetDefaultConfig() UserConfig {
 		OS: GetPlatformDefaultConfig(),
 		Update: UpdateConfig{
 			DockerRefreshInterval: time.Millisecond * 100,
+			RemoteMode:            "auto",
+		},
+		Jobs: JobsConfig{
+			MaxConcurrent:  2,
+			MaxOutputLines: 5000,
 		},
 		Stats: StatsConfig{
 			MaxDuration: duration,
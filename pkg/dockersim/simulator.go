@@ -0,0 +1,818 @@
+// Package dockersim serves a fake Docker Engine API over a unix socket, so that
+// we can see how lazydocker copes with a thousand containers without having to
+// run them. It answers the requests lazydocker makes (lists, inspects, stats
+// and log streams, events, top, images and volumes) with made up data, and can
+// churn through containers, write logs at a given rate and add latency to
+// every response.
+//
+// Point a docker client at it with client.WithHost(sim.Host()), or run
+// test/dockersim/cmd and set DOCKER_HOST.
+package dockersim
+
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"math/rand"
+	"net"
+	"net/http"
+	"os"
+	"regexp"
+	"strconv"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/container"
+	"github.com/docker/docker/api/types/events"
+	"github.com/docker/docker/api/types/image"
+	"github.com/docker/docker/api/types/volume"
+)
+
+// APIVersion is the version of the engine API we claim to speak
+const APIVersion = "1.25"
+
+// Options describe the fleet we simulate and how it behaves
+type Options struct {
+	// Containers is how many containers there are at any one time. Roughly one
+	// in ten is stopped
+	Containers int
+
+	// Images and Volumes are how many images and volumes there are. Containers
+	// are spread evenly across the images
+	Images  int
+	Volumes int
+
+	// ChurnInterval is how often we remove a container and create another in
+	// its place, sending the events the daemon would. Zero means never
+	ChurnInterval time.Duration
+
+	// LogLinesPerSecond is how many lines a followed log stream gets per
+	// second
+	LogLinesPerSecond int
+
+	// Latency is how long we wait before answering each request. Streams wait
+	// this long before sending their headers
+	Latency time.Duration
+
+	// Seed seeds the random numbers behind stats, logs and churn, so that runs
+	// with the same options see the same fleet
+	Seed int64
+}
+
+// DefaultOptions returns a modest fleet with no churn or latency
+func DefaultOptions() Options {
+	return Options{
+		Containers:        100,
+		Images:            20,
+		Volumes:           20,
+		LogLinesPerSecond: 10,
+		Seed:              1,
+	}
+}
+
+// statsInterval is how often the daemon sends a stats frame
+const statsInterval = time.Second
+
+// logBacklog is how many lines of logs each container has when we start
+// reading them
+const logBacklog = 100
+
+// simCPUs is how many CPUs our containers think they have
+const simCPUs = 4
+
+// Simulator is a fake docker daemon
+type Simulator struct {
+	options Options
+
+	mutex       sync.Mutex
+	random      *rand.Rand
+	containers  []*simContainer
+	images      []types.ImageSummary
+	volumes     []*types.Volume
+	subscribers map[chan events.Message]struct{}
+	created     int
+
+	listener net.Listener
+	server   *http.Server
+	stop     chan struct{}
+	stopOnce sync.Once
+	requests int64
+}
+
+type simContainer struct {
+	summary      types.Container
+	startedAt    time.Time
+	finishedAt   time.Time
+	restartCount int
+	logLines     int
+}
+
+// New returns a simulator with its fleet set up. Call Start to serve it
+func New(options Options) *Simulator {
+	if options.Images < 1 {
+		options.Images = 1
+	}
+
+	s := &Simulator{
+		options:     options,
+		random:      rand.New(rand.NewSource(options.Seed)),
+		subscribers: map[chan events.Message]struct{}{},
+		stop:        make(chan struct{}),
+	}
+
+	created := time.Now().Add(-time.Hour * 24 * 30)
+	for i := 0; i < options.Images; i++ {
+		s.images = append(s.images, types.ImageSummary{
+			ID:          "sha256:" + hash("image", i),
+			Created:     created.Add(time.Duration(i) * time.Hour).Unix(),
+			RepoTags:    []string{fmt.Sprintf("sim/image-%d:latest", i)},
+			RepoDigests: []string{},
+			Labels:      map[string]string{},
+			Size:        int64(50+s.random.Intn(500)) * 1024 * 1024,
+			SharedSize:  -1,
+			Containers:  -1,
+		})
+	}
+	for i := 0; i < options.Volumes; i++ {
+		name := hash("volume", i)
+		s.volumes = append(s.volumes, &types.Volume{
+			Name:       name,
+			Driver:     "local",
+			Mountpoint: "/var/lib/docker/volumes/" + name + "/_data",
+			Labels:     map[string]string{},
+			Options:    map[string]string{},
+			Scope:      "local",
+			CreatedAt:  created.Format(time.RFC3339),
+		})
+	}
+	for i := 0; i < options.Containers; i++ {
+		c := s.newContainer()
+		if i%10 == 9 {
+			c.summary.State = "exited"
+			c.summary.Status = "Exited (0) 5 minutes ago"
+			c.finishedAt = time.Now().Add(-time.Minute * 5)
+		}
+		s.containers = append(s.containers, c)
+	}
+
+	return s
+}
+
+// newContainer returns a running container belonging to the next service in
+// the 'sim' compose project. Call with the mutex held
+func (s *Simulator) newContainer() *simContainer {
+	n := s.created
+	s.created++
+
+	id := hash("container", n)
+	img := s.images[n%len(s.images)]
+	service := fmt.Sprintf("svc-%d", n)
+	startedAt := time.Now().Add(-time.Duration(s.random.Intn(3600)) * time.Second)
+
+	return &simContainer{
+		summary: types.Container{
+			ID:      id,
+			Names:   []string{"/sim_" + service + "_1"},
+			Image:   img.RepoTags[0],
+			ImageID: img.ID,
+			Command: "/bin/sim",
+			Created: startedAt.Unix(),
+			Ports:   []types.Port{},
+			Labels: map[string]string{
+				"com.docker.compose.project":          "sim",
+				"com.docker.compose.service":          service,
+				"com.docker.compose.container-number": "1",
+				"com.docker.compose.oneoff":           "False",
+			},
+			State:  "running",
+			Status: "Up About an hour",
+		},
+		startedAt: startedAt,
+	}
+}
+
+// hash gives us a made up but stable 64 character ID
+func hash(kind string, n int) string {
+	sum := sha256.Sum256([]byte(fmt.Sprintf("%s-%d", kind, n)))
+	return hex.EncodeToString(sum[:])
+}
+
+// Start serves the API on a unix socket at socketPath, replacing anything
+// that's already there
+func (s *Simulator) Start(socketPath string) error {
+	_ = os.Remove(socketPath)
+	listener, err := net.Listen("unix", socketPath)
+	if err != nil {
+		return err
+	}
+	s.listener = listener
+	s.server = &http.Server{Handler: s}
+
+	go func() {
+		// Serve only returns once we close the listener
+		_ = s.server.Serve(listener)
+	}()
+	if s.options.ChurnInterval > 0 {
+		go s.churn()
+	}
+	return nil
+}
+
+// Host returns the DOCKER_HOST for talking to the simulator
+func (s *Simulator) Host() string {
+	return "unix://" + s.listener.Addr().String()
+}
+
+// Requests returns how many requests we've been sent so far
+func (s *Simulator) Requests() int64 {
+	return atomic.LoadInt64(&s.requests)
+}
+
+// Close stops the simulator, ending any streams that are still open
+func (s *Simulator) Close() error {
+	s.stopOnce.Do(func() {
+		close(s.stop)
+	})
+	if s.server == nil {
+		return nil
+	}
+	return s.server.Close()
+}
+
+// churn replaces a container every ChurnInterval, the way a busy host would
+// see them come and go
+func (s *Simulator) churn() {
+	ticker := time.NewTicker(s.options.ChurnInterval)
+	defer ticker.Stop()
+
+	for {
+		select {
+		case <-s.stop:
+			return
+		case <-ticker.C:
+		}
+
+		s.mutex.Lock()
+		if len(s.containers) > 0 {
+			i := s.random.Intn(len(s.containers))
+			old := s.containers[i]
+			s.containers = append(s.containers[:i], s.containers[i+1:]...)
+			s.publish(old, "die")
+			s.publish(old, "destroy")
+		}
+		c := s.newContainer()
+		c.startedAt = time.Now()
+		s.containers = append(s.containers, c)
+		s.publish(c, "create")
+		s.publish(c, "start")
+		s.mutex.Unlock()
+	}
+}
+
+// publish sends a container event to everyone listening. Call with the mutex
+// held
+func (s *Simulator) publish(c *simContainer, action string) {
+	now := time.Now()
+	message := events.Message{
+		Status: action,
+		ID:     c.summary.ID,
+		From:   c.summary.Image,
+		Type:   events.ContainerEventType,
+		Action: action,
+		Actor: events.Actor{
+			ID:         c.summary.ID,
+			Attributes: map[string]string{"name": strings.TrimPrefix(c.summary.Names[0], "/")},
+		},
+		Scope:    "local",
+		Time:     now.Unix(),
+		TimeNano: now.UnixNano(),
+	}
+	for subscriber := range s.subscribers {
+		select {
+		case subscriber <- message:
+		default:
+			// the daemon drops events for listeners that can't keep up too
+		}
+	}
+}
+
+var versionPrefix = regexp.MustCompile(`^/v[0-9.]+`)
+
+// ServeHTTP routes a request to its handler, after waiting out our latency
+func (s *Simulator) ServeHTTP(w http.ResponseWriter, r *http.Request) {
+	atomic.AddInt64(&s.requests, 1)
+	if s.options.Latency > 0 {
+		time.Sleep(s.options.Latency)
+	}
+
+	path := versionPrefix.ReplaceAllString(r.URL.Path, "")
+	parts := strings.Split(strings.Trim(path, "/"), "/")
+
+	switch {
+	case path == "/_ping":
+		w.Header().Set("API-Version", APIVersion)
+		fmt.Fprint(w, "OK")
+	case path == "/containers/json":
+		s.listContainers(w, r)
+	case len(parts) >= 2 && parts[0] == "containers":
+		s.containerRoute(w, r, parts[1], strings.Join(parts[2:], "/"))
+	case path == "/images/json":
+		s.listImages(w)
+	case len(parts) >= 2 && parts[0] == "images":
+		s.imageRoute(w, r, strings.Join(parts[1:len(parts)-1], "/"), parts[len(parts)-1])
+	case path == "/volumes":
+		s.listVolumes(w)
+	case len(parts) == 2 && parts[0] == "volumes" && r.Method == http.MethodDelete:
+		s.removeVolume(w, parts[1])
+	case path == "/events":
+		s.streamEvents(w, r)
+	case path == "/system/df":
+		s.diskUsage(w)
+	default:
+		writeError(w, http.StatusNotFound, "page not found")
+	}
+}
+
+func writeJSON(w http.ResponseWriter, value interface{}) {
+	w.Header().Set("Content-Type", "application/json")
+	_ = json.NewEncoder(w).Encode(value)
+}
+
+func writeError(w http.ResponseWriter, status int, message string) {
+	w.Header().Set("Content-Type", "application/json")
+	w.WriteHeader(status)
+	_ = json.NewEncoder(w).Encode(map[string]string{"message": message})
+}
+
+func (s *Simulator) listContainers(w http.ResponseWriter, r *http.Request) {
+	all := r.URL.Query().Get("all") == "1" || r.URL.Query().Get("all") == "true"
+
+	s.mutex.Lock()
+	list := make([]types.Container, 0, len(s.containers))
+	for _, c := range s.containers {
+		if all || c.summary.State == "running" {
+			list = append(list, c.summary)
+		}
+	}
+	s.mutex.Unlock()
+
+	writeJSON(w, list)
+}
+
+// findContainer looks a container up by ID, ID prefix or name. Call with the
+// mutex held
+func (s *Simulator) findContainer(ref string) (int, *simContainer) {
+	for i, c := range s.containers {
+		if strings.HasPrefix(c.summary.ID, ref) || c.summary.Names[0] == "/"+ref {
+			return i, c
+		}
+	}
+	return -1, nil
+}
+
+func (s *Simulator) containerRoute(w http.ResponseWriter, r *http.Request, ref string, action string) {
+	s.mutex.Lock()
+	i, c := s.findContainer(ref)
+	s.mutex.Unlock()
+	if c == nil {
+		writeError(w, http.StatusNotFound, "No such container: "+ref)
+		return
+	}
+
+	switch {
+	case action == "json":
+		s.inspectContainer(w, c)
+	case action == "stats":
+		s.streamStats(w, r, c)
+	case action == "logs":
+		s.streamLogs(w, r, c)
+	case action == "top":
+		s.top(w, c)
+	case action == "" && r.Method == http.MethodDelete:
+		s.mutex.Lock()
+		if i, _ = s.findContainer(ref); i >= 0 {
+			s.containers = append(s.containers[:i], s.containers[i+1:]...)
+			s.publish(c, "destroy")
+		}
+		s.mutex.Unlock()
+		w.WriteHeader(http.StatusNoContent)
+	case r.Method == http.MethodPost:
+		s.changeState(w, c, action)
+	default:
+		writeError(w, http.StatusNotFound, "page not found")
+	}
+}
+
+// changeState handles start, stop, restart and friends
+func (s *Simulator) changeState(w http.ResponseWriter, c *simContainer, action string) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	switch action {
+	case "stop", "kill":
+		c.summary.State = "exited"
+		c.summary.Status = "Exited (0) Less than a second ago"
+		c.finishedAt = time.Now()
+		s.publish(c, action)
+		s.publish(c, "die")
+	case "start", "unpause":
+		c.summary.State = "running"
+		c.summary.Status = "Up Less than a second"
+		c.startedAt = time.Now()
+		s.publish(c, action)
+	case "restart":
+		c.summary.State = "running"
+		c.summary.Status = "Up Less than a second"
+		c.startedAt = time.Now()
+		c.restartCount++
+		s.publish(c, "die")
+		s.publish(c, "start")
+		s.publish(c, "restart")
+	case "pause":
+		c.summary.State = "paused"
+		c.summary.Status = "Up About an hour (Paused)"
+		s.publish(c, action)
+	default:
+		writeError(w, http.StatusNotFound, "page not found")
+		return
+	}
+	w.WriteHeader(http.StatusNoContent)
+}
+
+func (s *Simulator) inspectContainer(w http.ResponseWriter, c *simContainer) {
+	s.mutex.Lock()
+	summary := c.summary
+	running := summary.State == "running" || summary.State == "paused"
+	state := &types.ContainerState{
+		Status:    summary.State,
+		Running:   running,
+		Paused:    summary.State == "paused",
+		StartedAt: c.startedAt.Format(time.RFC3339Nano),
+	}
+	if running {
+		state.Pid = 1000 + len(summary.ID)
+	}
+	if !c.finishedAt.IsZero() {
+		state.FinishedAt = c.finishedAt.Format(time.RFC3339Nano)
+	}
+	restartCount := c.restartCount
+	s.mutex.Unlock()
+
+	writeJSON(w, types.ContainerJSON{
+		ContainerJSONBase: &types.ContainerJSONBase{
+			ID:           summary.ID,
+			Created:      time.Unix(summary.Created, 0).Format(time.RFC3339Nano),
+			Path:         summary.Command,
+			Args:         []string{},
+			State:        state,
+			Image:        summary.ImageID,
+			Name:         summary.Names[0],
+			RestartCount: restartCount,
+			Driver:       "overlay2",
+			Platform:     "linux",
+			HostConfig:   &container.HostConfig{},
+		},
+		Mounts: []types.MountPoint{},
+		Config: &container.Config{
+			Hostname: summary.ID[:12],
+			Image:    summary.Image,
+			Cmd:      []string{summary.Command},
+			Labels:   summary.Labels,
+		},
+		NetworkSettings: &types.NetworkSettings{},
+	})
+}
+
+// streamStats sends a stats frame every second until the client goes away,
+// or just the one if it asked for stream=0. Like the daemon, we only send
+// the CPU and memory numbers for running containers
+func (s *Simulator) streamStats(w http.ResponseWriter, r *http.Request, c *simContainer) {
+	stream := r.URL.Query().Get("stream") != "0" && r.URL.Query().Get("stream") != "false"
+
+	s.mutex.Lock()
+	random := rand.New(rand.NewSource(s.random.Int63()))
+	s.mutex.Unlock()
+
+	w.Header().Set("Content-Type", "application/json")
+	encoder := json.NewEncoder(w)
+	flusher, _ := w.(http.Flusher)
+
+	var previous types.StatsJSON
+	var cpu, system uint64
+	ticker := time.NewTicker(statsInterval)
+	defer ticker.Stop()
+
+	for {
+		frame := types.StatsJSON{
+			Name: c.summary.Names[0],
+			ID:   c.summary.ID,
+		}
+		frame.Read = time.Now()
+		frame.PreRead = previous.Read
+		frame.PreCPUStats = previous.CPUStats
+
+		s.mutex.Lock()
+		running := c.summary.State == "running"
+		s.mutex.Unlock()
+
+		if running {
+			// somewhere between idle and half of one CPU
+			used := uint64(random.Int63n(int64(statsInterval) / 2))
+			cpu += used
+			system += uint64(statsInterval) * simCPUs
+			perCPU := make([]uint64, simCPUs)
+			for i := range perCPU {
+				perCPU[i] = cpu / simCPUs
+			}
+			frame.CPUStats = types.CPUStats{
+				CPUUsage:    types.CPUUsage{TotalUsage: cpu, PercpuUsage: perCPU},
+				SystemUsage: system,
+				OnlineCPUs:  simCPUs,
+			}
+			frame.MemoryStats = types.MemoryStats{
+				Usage: uint64(32+random.Intn(256)) * 1024 * 1024,
+				Limit: 8 * 1024 * 1024 * 1024,
+			}
+			frame.PidsStats = types.PidsStats{Current: uint64(1 + random.Intn(10))}
+			frame.Networks = map[string]types.NetworkStats{
+				"eth0": {RxBytes: uint64(random.Intn(1 << 20)), TxBytes: uint64(random.Intn(1 << 20))},
+			}
+		}
+
+		if err := encoder.Encode(frame); err != nil || !stream {
+			return
+		}
+		if flusher != nil {
+			flusher.Flush()
+		}
+		previous = frame
+
+		select {
+		case <-r.Context().Done():
+			return
+		case <-s.stop:
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+// streamLogs sends the container's logs in the daemon's multiplexed format
+// (an 8 byte header before each chunk saying which stream it's from and how
+// long it is), then if asked to follow, keeps sending LogLinesPerSecond lines
+// a second
+func (s *Simulator) streamLogs(w http.ResponseWriter, r *http.Request, c *simContainer) {
+	query := r.URL.Query()
+	follow := query.Get("follow") == "1" || query.Get("follow") == "true"
+	timestamps := query.Get("timestamps") == "1" || query.Get("timestamps") == "true"
+
+	s.mutex.Lock()
+	total := c.logLines + logBacklog
+	s.mutex.Unlock()
+
+	first := 0
+	if tail, err := strconv.Atoi(query.Get("tail")); err == nil && tail < total {
+		first = total - tail
+	}
+
+	w.Header().Set("Content-Type", "application/vnd.docker.raw-stream")
+	flusher, _ := w.(http.Flusher)
+
+	write := func(from int, to int) error {
+		for n := from; n < to; n++ {
+			stream := byte(1)
+			level := "info"
+			if n%17 == 0 {
+				stream = 2
+				level = "error"
+			}
+			line := fmt.Sprintf("level=%s msg=\"handled request %d\" container=%s\n", level, n, c.summary.ID[:12])
+			if timestamps {
+				line = time.Now().UTC().Format(time.RFC3339Nano) + " " + line
+			}
+			header := make([]byte, 8)
+			header[0] = stream
+			binary.BigEndian.PutUint32(header[4:], uint32(len(line)))
+			if _, err := w.Write(append(header, line...)); err != nil {
+				return err
+			}
+		}
+		if flusher != nil {
+			flusher.Flush()
+		}
+		return nil
+	}
+
+	if err := write(first, total); err != nil || !follow || s.options.LogLinesPerSecond <= 0 {
+		return
+	}
+
+	// we send lines in batches ten times a second rather than one at a time,
+	// which is closer to how a busy container's output arrives anyway
+	ticker := time.NewTicker(time.Second / 10)
+	defer ticker.Stop()
+	start := time.Now()
+	sent := total
+	for {
+		select {
+		case <-r.Context().Done():
+			return
+		case <-s.stop:
+			return
+		case <-ticker.C:
+		}
+
+		due := total + int(time.Since(start).Seconds()*float64(s.options.LogLinesPerSecond))
+		if due == sent {
+			continue
+		}
+		if err := write(sent, due); err != nil {
+			return
+		}
+		s.mutex.Lock()
+		c.logLines += due - sent
+		s.mutex.Unlock()
+		sent = due
+	}
+}
+
+func (s *Simulator) top(w http.ResponseWriter, c *simContainer) {
+	s.mutex.Lock()
+	running := c.summary.State == "running"
+	s.mutex.Unlock()
+	if !running {
+		writeError(w, http.StatusConflict, "Container "+c.summary.ID+" is not running")
+		return
+	}
+
+	writeJSON(w, container.ContainerTopOKBody{
+		Titles: []string{"UID", "PID", "PPID", "C", "STIME", "TTY", "TIME", "CMD"},
+		Processes: [][]string{
+			{"root", "1001", "1000", "0", "12:00", "?", "00:00:01", c.summary.Command},
+			{"root", "1002", "1001", "0", "12:00", "?", "00:00:00", c.summary.Command + " --worker"},
+		},
+	})
+}
+
+func (s *Simulator) listImages(w http.ResponseWriter) {
+	s.mutex.Lock()
+	list := append([]types.ImageSummary{}, s.images...)
+	s.mutex.Unlock()
+
+	writeJSON(w, list)
+}
+
+// findImage looks an image up by ID (with or without its sha256: prefix) or
+// tag. Call with the mutex held
+func (s *Simulator) findImage(ref string) (int, *types.ImageSummary) {
+	for i := range s.images {
+		img := &s.images[i]
+		if strings.HasPrefix(img.ID, ref) || strings.HasPrefix(strings.TrimPrefix(img.ID, "sha256:"), ref) || img.RepoTags[0] == ref {
+			return i, img
+		}
+	}
+	return -1, nil
+}
+
+func (s *Simulator) imageRoute(w http.ResponseWriter, r *http.Request, ref string, action string) {
+	// a DELETE has no action on the end, so what we took for the action is
+	// really the last part of the reference
+	if r.Method == http.MethodDelete {
+		if ref != "" {
+			ref += "/"
+		}
+		ref += action
+		action = ""
+	}
+
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	i, img := s.findImage(ref)
+	if img == nil {
+		writeError(w, http.StatusNotFound, "No such image: "+ref)
+		return
+	}
+
+	switch action {
+	case "json":
+		writeJSON(w, types.ImageInspect{
+			ID:           img.ID,
+			RepoTags:     img.RepoTags,
+			RepoDigests:  img.RepoDigests,
+			Created:      time.Unix(img.Created, 0).Format(time.RFC3339Nano),
+			Architecture: "amd64",
+			Os:           "linux",
+			Size:         img.Size,
+			VirtualSize:  img.Size,
+			Config:       &container.Config{Cmd: []string{"/bin/sim"}, Labels: img.Labels},
+			RootFS:       types.RootFS{Type: "layers", Layers: []string{"sha256:" + hash("layer", i)}},
+		})
+	case "history":
+		writeJSON(w, []image.HistoryResponseItem{
+			{ID: img.ID, Created: img.Created, CreatedBy: "/bin/sh -c #(nop)  CMD [\"/bin/sim\"]", Tags: img.RepoTags, Size: 0},
+			{ID: "<missing>", Created: img.Created, CreatedBy: "/bin/sh -c #(nop) ADD file:sim in / ", Size: img.Size},
+		})
+	case "":
+		// img points into s.images, which removing it shifts along
+		id := img.ID
+		s.images = append(s.images[:i], s.images[i+1:]...)
+		writeJSON(w, []types.ImageDeleteResponseItem{{Deleted: id}})
+	default:
+		writeError(w, http.StatusNotFound, "page not found")
+	}
+}
+
+func (s *Simulator) listVolumes(w http.ResponseWriter) {
+	s.mutex.Lock()
+	list := append([]*types.Volume{}, s.volumes...)
+	s.mutex.Unlock()
+
+	writeJSON(w, volume.VolumeListOKBody{Volumes: list, Warnings: []string{}})
+}
+
+func (s *Simulator) removeVolume(w http.ResponseWriter, name string) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	for i, v := range s.volumes {
+		if v.Name == name {
+			s.volumes = append(s.volumes[:i], s.volumes[i+1:]...)
+			w.WriteHeader(http.StatusNoContent)
+			return
+		}
+	}
+	writeError(w, http.StatusNotFound, "get "+name+": no such volume")
+}
+
+// streamEvents sends events as they happen until the client goes away
+func (s *Simulator) streamEvents(w http.ResponseWriter, r *http.Request) {
+	messages := make(chan events.Message, 256)
+	s.mutex.Lock()
+	s.subscribers[messages] = struct{}{}
+	s.mutex.Unlock()
+	defer func() {
+		s.mutex.Lock()
+		delete(s.subscribers, messages)
+		s.mutex.Unlock()
+	}()
+
+	w.Header().Set("Content-Type", "application/json")
+	w.WriteHeader(http.StatusOK)
+	flusher, _ := w.(http.Flusher)
+	if flusher != nil {
+		flusher.Flush()
+	}
+	encoder := json.NewEncoder(w)
+
+	for {
+		select {
+		case <-r.Context().Done():
+			return
+		case <-s.stop:
+			return
+		case message := <-messages:
+			if err := encoder.Encode(message); err != nil {
+				return
+			}
+			if flusher != nil {
+				flusher.Flush()
+			}
+		}
+	}
+}
+
+func (s *Simulator) diskUsage(w http.ResponseWriter) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	usage := types.DiskUsage{
+		Images:     []*types.ImageSummary{},
+		Containers: []*types.Container{},
+		Volumes:    []*types.Volume{},
+		BuildCache: []*types.BuildCache{},
+	}
+	for i := range s.images {
+		img := s.images[i]
+		usage.Images = append(usage.Images, &img)
+		usage.LayersSize += img.Size
+	}
+	for _, c := range s.containers {
+		summary := c.summary
+		summary.SizeRw = 1024 * 1024
+		summary.SizeRootFs = 100 * 1024 * 1024
+		usage.Containers = append(usage.Containers, &summary)
+	}
+	for _, v := range s.volumes {
+		withUsage := *v
+		withUsage.UsageData = &types.VolumeUsageData{Size: 10 * 1024 * 1024, RefCount: 1}
+		usage.Volumes = append(usage.Volumes, &withUsage)
+	}
+
+	writeJSON(w, usage)
+}
@@ -0,0 +1,171 @@
+package dockersim
+
+import (
+	"bytes"
+	"context"
+	"encoding/binary"
+	"encoding/json"
+	"io"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/docker/docker/api/types"
+	"github.com/docker/docker/api/types/filters"
+	"github.com/docker/docker/client"
+	"github.com/stretchr/testify/assert"
+)
+
+// demux splits the daemon's multiplexed log format back into stdout and stderr
+func demux(r io.Reader, stdout io.Writer, stderr io.Writer) error {
+	header := make([]byte, 8)
+	for {
+		if _, err := io.ReadFull(r, header); err != nil {
+			if err == io.EOF {
+				return nil
+			}
+			return err
+		}
+		dst := stdout
+		if header[0] == 2 {
+			dst = stderr
+		}
+		if _, err := io.CopyN(dst, r, int64(binary.BigEndian.Uint32(header[4:]))); err != nil {
+			return err
+		}
+	}
+}
+
+func startSimulator(t *testing.T, options Options) (*Simulator, *client.Client, func()) {
+	dir, err := ioutil.TempDir("", "dockersim")
+	assert.NoError(t, err)
+
+	sim := New(options)
+	assert.NoError(t, sim.Start(filepath.Join(dir, "docker.sock")))
+
+	cli, err := client.NewClientWithOpts(client.WithHost(sim.Host()), client.WithVersion(APIVersion))
+	assert.NoError(t, err)
+
+	return sim, cli, func() {
+		cli.Close()
+		sim.Close()
+		os.RemoveAll(dir)
+	}
+}
+
+// TestSimulatorLists is a function.
+func TestSimulatorLists(t *testing.T) {
+	_, cli, done := startSimulator(t, Options{Containers: 50, Images: 5, Volumes: 3})
+	defer done()
+	ctx := context.Background()
+
+	all, err := cli.ContainerList(ctx, types.ContainerListOptions{All: true})
+	assert.NoError(t, err)
+	assert.Len(t, all, 50)
+
+	running, err := cli.ContainerList(ctx, types.ContainerListOptions{})
+	assert.NoError(t, err)
+	assert.Len(t, running, 45)
+
+	details, err := cli.ContainerInspect(ctx, all[0].ID[:12])
+	assert.NoError(t, err)
+	assert.EqualValues(t, all[0].ID, details.ID)
+	assert.True(t, details.State.Running)
+	assert.EqualValues(t, "sim", details.Config.Labels["com.docker.compose.project"])
+
+	_, err = cli.ContainerInspect(ctx, "nope")
+	assert.True(t, client.IsErrNotFound(err))
+
+	top, err := cli.ContainerTop(ctx, all[0].ID, []string{})
+	assert.NoError(t, err)
+	assert.Len(t, top.Processes, 2)
+
+	images, err := cli.ImageList(ctx, types.ImageListOptions{})
+	assert.NoError(t, err)
+	assert.Len(t, images, 5)
+
+	history, err := cli.ImageHistory(ctx, images[0].ID)
+	assert.NoError(t, err)
+	assert.NotEmpty(t, history)
+
+	deleted, err := cli.ImageRemove(ctx, images[0].ID, types.ImageRemoveOptions{})
+	assert.NoError(t, err)
+	assert.EqualValues(t, []types.ImageDeleteResponseItem{{Deleted: images[0].ID}}, deleted)
+	images, err = cli.ImageList(ctx, types.ImageListOptions{})
+	assert.NoError(t, err)
+	assert.Len(t, images, 4)
+
+	volumes, err := cli.VolumeList(ctx, filters.Args{})
+	assert.NoError(t, err)
+	assert.Len(t, volumes.Volumes, 3)
+
+	usage, err := cli.DiskUsage(ctx)
+	assert.NoError(t, err)
+	assert.Len(t, usage.Containers, 50)
+}
+
+// TestSimulatorStreams is a function.
+func TestSimulatorStreams(t *testing.T) {
+	_, cli, done := startSimulator(t, Options{Containers: 2, Images: 1, LogLinesPerSecond: 100})
+	defer done()
+	ctx := context.Background()
+
+	list, err := cli.ContainerList(ctx, types.ContainerListOptions{All: true})
+	assert.NoError(t, err)
+	id := list[0].ID
+
+	stats, err := cli.ContainerStats(ctx, id, false)
+	assert.NoError(t, err)
+	frame := types.StatsJSON{}
+	assert.NoError(t, json.NewDecoder(stats.Body).Decode(&frame))
+	stats.Body.Close()
+	assert.EqualValues(t, id, frame.ID)
+	assert.True(t, frame.MemoryStats.Usage > 0)
+
+	logs, err := cli.ContainerLogs(ctx, id, types.ContainerLogsOptions{ShowStdout: true, ShowStderr: true, Tail: "10"})
+	assert.NoError(t, err)
+	stdout, stderr := &bytes.Buffer{}, &bytes.Buffer{}
+	err = demux(logs, stdout, stderr)
+	logs.Close()
+	assert.NoError(t, err)
+	assert.EqualValues(t, 10, bytes.Count(stdout.Bytes(), []byte("\n"))+bytes.Count(stderr.Bytes(), []byte("\n")))
+
+	// following the logs keeps them coming at the configured rate
+	followCtx, cancel := context.WithTimeout(ctx, time.Millisecond*500)
+	defer cancel()
+	logs, err = cli.ContainerLogs(followCtx, id, types.ContainerLogsOptions{ShowStdout: true, Follow: true, Tail: "0"})
+	assert.NoError(t, err)
+	stdout.Reset()
+	_ = demux(logs, stdout, ioutil.Discard)
+	logs.Close()
+	assert.True(t, bytes.Count(stdout.Bytes(), []byte("\n")) > 10)
+}
+
+// TestSimulatorChurn is a function.
+func TestSimulatorChurn(t *testing.T) {
+	_, cli, done := startSimulator(t, Options{Containers: 10, Images: 1, ChurnInterval: time.Millisecond * 20})
+	defer done()
+
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+	messages, errs := cli.Events(ctx, types.EventsOptions{})
+
+	actions := map[string]bool{}
+	timeout := time.After(time.Second * 5)
+	for !(actions["destroy"] && actions["start"]) {
+		select {
+		case message := <-messages:
+			actions[message.Action] = true
+		case err := <-errs:
+			t.Fatal(err)
+		case <-timeout:
+			t.Fatal("timed out waiting for churn events")
+		}
+	}
+
+	list, err := cli.ContainerList(ctx, types.ContainerListOptions{All: true})
+	assert.NoError(t, err)
+	assert.Len(t, list, 10)
+}
@@ -68,7 +68,7 @@ func (gui *Gui) createPromptPanel(g *gocui.Gui, currentView *gocui.View, title s
 		return err
 	}
 	confirmationView.Editable = true
-	return gui.setKeyBindings(g, handleConfirm, nil)
+	return gui.setPromptKeyBindings(g, handleConfirm, nil)
 }
 
 func (gui *Gui) prepareConfirmationPanel(currentView *gocui.View, title, prompt string, hasLoader bool) (*gocui.View, error) {
@@ -84,7 +84,7 @@ func (gui *Gui) prepareConfirmationPanel(currentView *gocui.View, title, prompt
 		confirmationView.Wrap = true
 		confirmationView.FgColor = gocui.ColorWhite
 	}
-	gui.g.Update(func(g *gocui.Gui) error {
+	gui.update(func(g *gocui.Gui) error {
 		return gui.switchFocus(gui.g, currentView, confirmationView, false)
 	})
 	return confirmationView, nil
@@ -106,7 +106,7 @@ func (gui *Gui) createConfirmationPanel(g *gocui.Gui, currentView *gocui.View, t
 
 func (gui *Gui) createPopupPanel(g *gocui.Gui, currentView *gocui.View, title, prompt string, hasLoader bool, handleConfirm, handleClose func(*gocui.Gui, *gocui.View) error) error {
 	gui.onNewPopupPanel()
-	g.Update(func(g *gocui.Gui) error {
+	gui.update(func(g *gocui.Gui) error {
 		// delete the existing confirmation panel if it exists
 		if view, _ := g.View("confirmation"); view != nil {
 			if err := gui.closeConfirmationPrompt(g); err != nil {
@@ -145,6 +145,16 @@ func (gui *Gui) setKeyBindings(g *gocui.Gui, handleConfirm, handleClose func(*go
 	return nil
 }
 
+// setPromptKeyBindings is like setKeyBindings but without the 'y' and 'n'
+// shortcuts, because in a prompt those are just letters you might want to type
+func (gui *Gui) setPromptKeyBindings(g *gocui.Gui, handleConfirm, handleClose func(*gocui.Gui, *gocui.View) error) error {
+	if err := g.SetKeybinding("confirmation", nil, gocui.KeyEnter, gocui.ModNone, gui.wrappedConfirmationFunction(handleConfirm)); err != nil {
+		return err
+	}
+
+	return g.SetKeybinding("confirmation", nil, gocui.KeyEsc, gocui.ModNone, gui.wrappedConfirmationFunction(handleClose))
+}
+
 // createSpecificErrorPanel allows you to create an error popup, specifying the
 //  view to be focused when the user closes the popup, and a boolean specifying
 // whether we will log the error. If the message may include a user password,
@@ -4,6 +4,7 @@ import (
 	"encoding/json"
 	"fmt"
 	"strings"
+	"sync"
 	"time"
 
 	"github.com/docker/docker/api/types"
@@ -25,17 +26,89 @@ func (gui *Gui) getContainerContextTitles() []string {
 	return []string{gui.Tr.LogsTitle, gui.Tr.StatsTitle, gui.Tr.ConfigTitle, gui.Tr.TopTitle}
 }
 
+// getSelectedContainer returns the selected container. If the containers are
+// grouped and a project or service is selected, there isn't one
 func (gui *Gui) getSelectedContainer() (*commands.Container, error) {
 	selectedLine := gui.State.Panels.Containers.SelectedLine
 	if selectedLine == -1 {
 		return &commands.Container{}, gui.Errors.ErrNoContainers
 	}
 
-	return gui.DockerCommand.DisplayContainers[selectedLine], nil
+	container := gui.getContainerAtLine(selectedLine)
+	if container == nil {
+		return &commands.Container{}, gui.Errors.ErrNoContainers
+	}
+	return container, nil
+}
+
+// getSelectedContainerGroup returns the selected project or service when the
+// containers are grouped, or nil if a container is selected
+func (gui *Gui) getSelectedContainerGroup() *commands.ContainerTreeRow {
+	panelState := gui.State.Panels.Containers
+	if !panelState.Grouped || panelState.SelectedLine < 0 || panelState.SelectedLine >= len(panelState.Rows) {
+		return nil
+	}
+	if row := panelState.Rows[panelState.SelectedLine]; row.IsGroup() {
+		return row
+	}
+	return nil
+}
+
+// getContainerRowCount returns how many rows the containers panel has, which
+// includes the projects and services when the containers are grouped
+func (gui *Gui) getContainerRowCount() int {
+	if gui.State.Panels.Containers.Grouped {
+		return len(gui.State.Panels.Containers.Rows)
+	}
+	return len(gui.DockerCommand.DisplayContainers)
+}
+
+// getContainerAtLine returns the container on the given line of the containers
+// panel, or nil if that line is a project or service
+func (gui *Gui) getContainerAtLine(line int) *commands.Container {
+	panelState := gui.State.Panels.Containers
+	if panelState.Grouped {
+		return panelState.Rows[line].Container
+	}
+	return gui.DockerCommand.DisplayContainers[line]
+}
+
+// getContainerIDs returns the qualified ID of the container on each line of
+// the containers panel, or the group's key for lines that are groups
+func (gui *Gui) getContainerIDs() []string {
+	panelState := gui.State.Panels.Containers
+	if panelState.Grouped {
+		ids := make([]string, len(panelState.Rows))
+		for i, row := range panelState.Rows {
+			ids[i] = row.Key
+		}
+		return ids
+	}
+
+	ids := make([]string, len(gui.DockerCommand.DisplayContainers))
+	for i, container := range gui.DockerCommand.DisplayContainers {
+		ids[i] = container.QualifiedID()
+	}
+	return ids
+}
+
+// getMarkedContainers returns the containers the user has marked, or the
+// selected container if none are marked
+func (gui *Gui) getMarkedContainers() []*commands.Container {
+	panelState := gui.State.Panels.Containers
+	indices := panelState.Selection.markedIndices(gui.getContainerIDs(), panelState.SelectedLine)
+	containers := make([]*commands.Container, 0, len(indices))
+	for _, index := range indices {
+		// marked projects and services don't count
+		if container := gui.getContainerAtLine(index); container != nil {
+			containers = append(containers, container)
+		}
+	}
+	return containers
 }
 
 func (gui *Gui) handleContainersClick(g *gocui.Gui, v *gocui.View) error {
-	itemCount := len(gui.DockerCommand.DisplayContainers)
+	itemCount := gui.getContainerRowCount()
 	handleSelect := gui.handleContainerSelect
 	selectedLine := &gui.State.Panels.Containers.SelectedLine
 
@@ -43,6 +116,13 @@ func (gui *Gui) handleContainersClick(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleContainerSelect(g *gocui.Gui, v *gocui.View) error {
+	if group := gui.getSelectedContainerGroup(); group != nil {
+		if err := gui.focusPoint(0, gui.State.Panels.Containers.SelectedLine, gui.getContainerRowCount(), v); err != nil {
+			return err
+		}
+		return gui.renderContainerGroup(group)
+	}
+
 	container, err := gui.getSelectedContainer()
 	if err != nil {
 		if err != gui.Errors.ErrNoContainers {
@@ -51,7 +131,7 @@ func (gui *Gui) handleContainerSelect(g *gocui.Gui, v *gocui.View) error {
 		return nil
 	}
 
-	if err := gui.focusPoint(0, gui.State.Panels.Containers.SelectedLine, len(gui.DockerCommand.DisplayContainers), v); err != nil {
+	if err := gui.focusPoint(0, gui.State.Panels.Containers.SelectedLine, gui.getContainerRowCount(), v); err != nil {
 		return err
 	}
 
@@ -90,6 +170,30 @@ func (gui *Gui) handleContainerSelect(g *gocui.Gui, v *gocui.View) error {
 	return nil
 }
 
+// renderContainerGroup shows the totals of the selected project or service in
+// the main panel
+func (gui *Gui) renderContainerGroup(group *commands.ContainerTreeRow) error {
+	key := "containers-group-" + group.Key
+	if !gui.shouldRefresh(key) {
+		return nil
+	}
+
+	mainView := gui.getMainView()
+	mainView.Tabs = nil
+	mainView.Autoscroll = false
+	mainView.Wrap = gui.Config.UserConfig.Gui.WrapMainPanel
+	gui.clearMainView()
+
+	padding := 12
+	output := ""
+	output += utils.WithPadding("Name: ", padding) + group.Name + "\n"
+	output += utils.WithPadding("Running: ", padding) + fmt.Sprintf("%d/%d", group.Running, group.Total) + "\n"
+	output += utils.WithPadding("CPU: ", padding) + fmt.Sprintf("%.2f%%", group.CPU) + "\n"
+	output += utils.WithPadding("Memory: ", padding) + fmt.Sprintf("%.2f%%", group.Memory) + "\n"
+
+	return gui.renderString(gui.g, "main", output)
+}
+
 func (gui *Gui) renderContainerConfig(container *commands.Container) error {
 	mainView := gui.getMainView()
 	mainView.Autoscroll = false
@@ -184,7 +288,7 @@ func (gui *Gui) renderContainerLogs(container *commands.Container) error {
 			gui.Config.UserConfig.CommandTemplates.ContainerLogs,
 			gui.DockerCommand.NewCommandObject(commands.CommandObject{Container: container}),
 		)
-		cmd := gui.OSCommand.RunCustomCommand(command)
+		cmd := container.Endpoint.Prepare(gui.OSCommand.RunCustomCommand(command))
 
 		// Ensure the child process is treated as a group, as the child process spawns
 		// its own children. Termination requires sending the signal to the group
@@ -196,6 +300,7 @@ func (gui *Gui) renderContainerLogs(container *commands.Container) error {
 		cmd.Stderr = mainView
 
 		cmd.Start()
+		logProcessDone := gui.Metrics.StartLogProcess()
 
 		go func() {
 			<-stop
@@ -207,6 +312,7 @@ func (gui *Gui) renderContainerLogs(container *commands.Container) error {
 		}()
 
 		cmd.Wait()
+		logProcessDone()
 
 		// if we are here because the task has been stopped, we should return
 		// if we are here then the container must have exited, meaning we should wait until it's back again before
@@ -216,6 +322,7 @@ func (gui *Gui) renderContainerLogs(container *commands.Container) error {
 			case <-stop:
 				return
 			default:
+				start := time.Now()
 				result, err := container.Inspect()
 				if err != nil {
 					// if we get an error, then the container has probably been removed so we'll get out of here
@@ -226,7 +333,7 @@ func (gui *Gui) renderContainerLogs(container *commands.Container) error {
 				if result.State.Running {
 					break L
 				}
-				time.Sleep(time.Millisecond * 100)
+				time.Sleep(gui.DockerCommand.RefreshDelay(time.Millisecond*100, time.Since(start)))
 			}
 		}
 	})
@@ -246,9 +353,25 @@ func (gui *Gui) refreshContainersAndServices() error {
 		selectedService = gui.DockerCommand.Services[sl]
 	}
 
+	usageVersion := gui.DockerCommand.UsageIndex.Version()
+	selectedContainerID := gui.selectedContainerID()
 	if err := gui.DockerCommand.RefreshContainersAndServices(); err != nil {
 		return err
 	}
+	gui.sortContainers(gui.DockerCommand.DisplayContainers, selectedContainerID)
+	gui.State.Panels.Services.Unfiltered = gui.DockerCommand.Services
+	gui.filterServices()
+
+	// if containers have come or gone, the in-use counts of our images and
+	// volumes may have changed
+	if gui.DockerCommand.UsageIndex.Version() != usageVersion {
+		gui.update(func(g *gocui.Gui) error {
+			if err := gui.renderImages(); err != nil {
+				return err
+			}
+			return gui.renderVolumes()
+		})
+	}
 
 	// see if our selected service has moved
 	if selectedService != nil {
@@ -265,11 +388,11 @@ func (gui *Gui) refreshContainersAndServices() error {
 		}
 	}
 
-	if len(gui.DockerCommand.DisplayContainers) > 0 && gui.State.Panels.Containers.SelectedLine == -1 {
+	if gui.getContainerRowCount() > 0 && gui.State.Panels.Containers.SelectedLine == -1 {
 		gui.State.Panels.Containers.SelectedLine = 0
 	}
-	if len(gui.DockerCommand.DisplayContainers)-1 < gui.State.Panels.Containers.SelectedLine {
-		gui.State.Panels.Containers.SelectedLine = len(gui.DockerCommand.DisplayContainers) - 1
+	if gui.getContainerRowCount()-1 < gui.State.Panels.Containers.SelectedLine {
+		gui.State.Panels.Containers.SelectedLine = gui.getContainerRowCount() - 1
 	}
 
 	// doing the exact same thing for services
@@ -280,15 +403,10 @@ func (gui *Gui) refreshContainersAndServices() error {
 		gui.State.Panels.Services.SelectedLine = len(gui.DockerCommand.Services) - 1
 	}
 
-	gui.g.Update(func(g *gocui.Gui) error {
-		containersView.Clear()
-		isFocused := gui.g.CurrentView().Name() == "containers"
-
-		list, err := utils.RenderList(gui.DockerCommand.DisplayContainers, utils.IsFocused(isFocused))
-		if err != nil {
+	gui.update(func(g *gocui.Gui) error {
+		if err := gui.renderContainers(); err != nil {
 			return err
 		}
-		fmt.Fprint(containersView, list)
 
 		if containersView == g.CurrentView() {
 			if err := gui.handleContainerSelect(g, containersView); err != nil {
@@ -300,15 +418,11 @@ func (gui *Gui) refreshContainersAndServices() error {
 		if !gui.DockerCommand.InDockerComposeProject {
 			return nil
 		}
-		servicesView := gui.getServicesView()
-		servicesView.Clear()
-		isFocused = gui.g.CurrentView().Name() == "services"
-		list, err = utils.RenderList(gui.DockerCommand.Services, utils.IsFocused(isFocused))
-		if err != nil {
+		if err := gui.renderServices(); err != nil {
 			return err
 		}
-		fmt.Fprint(servicesView, list)
 
+		servicesView := gui.getServicesView()
 		if servicesView == g.CurrentView() {
 			return gui.handleServiceSelect(g, servicesView)
 		}
@@ -318,13 +432,209 @@ func (gui *Gui) refreshContainersAndServices() error {
 	return nil
 }
 
+// selectedContainerID returns the ID of the selected container, or the key of
+// the selected group if the containers are grouped
+func (gui *Gui) selectedContainerID() string {
+	selectedLine := gui.State.Panels.Containers.SelectedLine
+	if selectedLine < 0 || selectedLine >= gui.getContainerRowCount() {
+		return ""
+	}
+	return gui.getContainerIDs()[selectedLine]
+}
+
+// selectContainerID selects the container (or group) with the given ID, if
+// it's still around
+func (gui *Gui) selectContainerID(id string) {
+	for i, rowID := range gui.getContainerIDs() {
+		if rowID == id {
+			gui.State.Panels.Containers.SelectedLine = i
+			return
+		}
+	}
+}
+
+// sortContainers sorts the given containers the way the user has asked and
+// filters them, keeping the given container selected if it's still around.
+// We start from the order we sorted them into last time, so that only the
+// containers whose stats have moved them get moved
+func (gui *Gui) sortContainers(containers []*commands.Container, selectedID string) {
+	panelState := gui.State.Panels.Containers
+	panelState.Unfiltered = commands.SortContainers(containers, panelState.Unfiltered, panelState.SortBy)
+	gui.filterContainers()
+	gui.selectContainerID(selectedID)
+}
+
+func (gui *Gui) handleContainersSortMenu(g *gocui.Gui, v *gocui.View) error {
+	options := []*sortOption{
+		{description: gui.Tr.SortByDaemonOrder, sortBy: commands.ContainerSortDefault},
+		{description: gui.Tr.SortByName, sortBy: commands.ContainerSortName},
+		{description: gui.Tr.SortByCPU, sortBy: commands.ContainerSortCPU},
+		{description: gui.Tr.SortByMemory, sortBy: commands.ContainerSortMemory},
+		{description: gui.Tr.SortByNetwork, sortBy: commands.ContainerSortNetwork},
+		{description: gui.Tr.SortByUptime, sortBy: commands.ContainerSortUptime},
+		{description: gui.Tr.SortByRestarts, sortBy: commands.ContainerSortRestarts},
+	}
+	for _, option := range options {
+		option.selected = option.sortBy == gui.State.Panels.Containers.SortBy
+	}
+
+	handleMenuPress := func(index int) error {
+		panelState := gui.State.Panels.Containers
+		if panelState.SortBy == options[index].sortBy {
+			return nil
+		}
+		panelState.SortBy = options[index].sortBy
+
+		// going back to the daemon's order means we need the daemon's order,
+		// which we don't keep, so we refresh instead
+		if panelState.SortBy == commands.ContainerSortDefault {
+			return gui.refreshContainersAndServices()
+		}
+		gui.sortContainers(panelState.Unfiltered, gui.selectedContainerID())
+		if err := gui.renderContainers(); err != nil {
+			return err
+		}
+		return gui.handleContainerSelect(gui.g, gui.getContainersView())
+	}
+
+	return gui.createMenu(gui.Tr.SortTitle, options, len(options), handleMenuPress)
+}
+
+// filterContainers narrows the containers we display down to those matching
+// the containers panel's filter. Besides words to fuzzy-match, the filter can
+// compare fields like `state=running cpu>50`. We filter again every time we
+// refresh, so the results keep up with the containers' stats
+func (gui *Gui) filterContainers() {
+	panelState := gui.State.Panels.Containers
+	filter := panelState.Filter
+	all := panelState.Unfiltered
+	filter.err = nil
+	if filter.Query == "" {
+		gui.setDisplayContainers(all)
+		return
+	}
+
+	query, err := commands.ParseContainerQuery(filter.Query)
+	if err != nil {
+		filter.err = err
+		gui.setDisplayContainers([]*commands.Container{})
+		return
+	}
+
+	matches := filter.matches(query.Text, len(all), func(i int) string { return all[i].SearchKey() }, func(i int) utils.SearchRow { return all[i].SearchRow() })
+	containers := make([]*commands.Container, 0, len(matches))
+	for _, index := range matches {
+		if query.Matches(all[index]) {
+			containers = append(containers, all[index])
+		}
+	}
+	gui.setDisplayContainers(containers)
+}
+
+// setDisplayContainers sets the containers we display, arranging them into a
+// tree if the containers are grouped
+func (gui *Gui) setDisplayContainers(containers []*commands.Container) {
+	panelState := gui.State.Panels.Containers
+	gui.DockerCommand.DisplayContainers = containers
+	if panelState.Grouped {
+		panelState.Rows = commands.GroupContainers(containers, panelState.Collapsed)
+	}
+}
+
+// handleContainersToggleGrouped switches between listing the containers and
+// grouping them into a tree by compose project and service
+func (gui *Gui) handleContainersToggleGrouped(g *gocui.Gui, v *gocui.View) error {
+	panelState := gui.State.Panels.Containers
+	selectedID := gui.selectedContainerID()
+
+	panelState.Grouped = !panelState.Grouped
+	gui.setDisplayContainers(gui.DockerCommand.DisplayContainers)
+	panelState.SelectedLine = 0
+	if gui.getContainerRowCount() == 0 {
+		panelState.SelectedLine = -1
+	}
+	gui.selectContainerID(selectedID)
+
+	if err := gui.renderContainers(); err != nil {
+		return err
+	}
+	return gui.handleContainerSelect(gui.g, v)
+}
+
+// handleContainersEnter expands or collapses the selected project or service,
+// or focuses the main panel if a container is selected
+func (gui *Gui) handleContainersEnter(g *gocui.Gui, v *gocui.View) error {
+	group := gui.getSelectedContainerGroup()
+	if group == nil {
+		return gui.handleEnterMain(g, v)
+	}
+
+	panelState := gui.State.Panels.Containers
+	if panelState.Collapsed[group.Key] {
+		delete(panelState.Collapsed, group.Key)
+	} else {
+		panelState.Collapsed[group.Key] = true
+	}
+	gui.setDisplayContainers(gui.DockerCommand.DisplayContainers)
+	gui.selectContainerID(group.Key)
+
+	if err := gui.renderContainers(); err != nil {
+		return err
+	}
+	return gui.handleContainerSelect(gui.g, v)
+}
+
+// renderContainers writes the containers list to its view. It must be called
+// from within the gui's main loop
+func (gui *Gui) renderContainers() error {
+	containersView := gui.getContainersView()
+	window := gui.updateListWindow(containersView, gui.getContainerRowCount())
+	containersView.Clear()
+	isFocused := gui.g.CurrentView().Name() == "containers"
+
+	panelState := gui.State.Panels.Containers
+	markedLines := panelState.Selection.renderOption(gui.getContainerIDs(), panelState.SelectedLine, window.start)
+	var rows interface{} = gui.DockerCommand.DisplayContainers[window.start:window.end]
+	if panelState.Grouped {
+		rows = panelState.Rows[window.start:window.end]
+	}
+	list, err := utils.RenderList(rows, utils.IsFocused(isFocused), markedLines)
+	if err != nil {
+		return err
+	}
+	fmt.Fprint(containersView, list)
+	return nil
+}
+
+// renderServices writes the services list to its view. It must be called from
+// within the gui's main loop
+func (gui *Gui) renderServices() error {
+	servicesView := gui.getServicesView()
+	window := gui.updateListWindow(servicesView, len(gui.DockerCommand.Services))
+	servicesView.Clear()
+	isFocused := gui.g.CurrentView().Name() == "services"
+
+	list, err := utils.RenderList(gui.DockerCommand.Services[window.start:window.end], utils.IsFocused(isFocused))
+	if err != nil {
+		return err
+	}
+	fmt.Fprint(servicesView, list)
+	return nil
+}
+
 func (gui *Gui) handleContainersNextLine(g *gocui.Gui, v *gocui.View) error {
 	if gui.popupPanelFocused() || gui.g.CurrentView() != v {
 		return nil
 	}
 
 	panelState := gui.State.Panels.Containers
-	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.DisplayContainers), false)
+	gui.changeSelectedLine(&panelState.SelectedLine, gui.getContainerRowCount(), false)
+
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderContainers(); err != nil {
+			return err
+		}
+	}
 
 	return gui.handleContainerSelect(gui.g, v)
 }
@@ -335,12 +645,22 @@ func (gui *Gui) handleContainersPrevLine(g *gocui.Gui, v *gocui.View) error {
 	}
 
 	panelState := gui.State.Panels.Containers
-	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.DisplayContainers), true)
+	gui.changeSelectedLine(&panelState.SelectedLine, gui.getContainerRowCount(), true)
+
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderContainers(); err != nil {
+			return err
+		}
+	}
 
 	return gui.handleContainerSelect(gui.g, v)
 }
 
 func (gui *Gui) handleContainersNextContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(1) {
+		return nil
+	}
+
 	contexts := gui.getContainerContexts()
 	if gui.State.Panels.Containers.ContextIndex >= len(contexts)-1 {
 		gui.State.Panels.Containers.ContextIndex = 0
@@ -354,6 +674,10 @@ func (gui *Gui) handleContainersNextContext(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleContainersPrevContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(-1) {
+		return nil
+	}
+
 	contexts := gui.getContainerContexts()
 	if gui.State.Panels.Containers.ContextIndex <= 0 {
 		gui.State.Panels.Containers.ContextIndex = len(contexts) - 1
@@ -366,6 +690,33 @@ func (gui *Gui) handleContainersPrevContext(g *gocui.Gui, v *gocui.View) error {
 	return nil
 }
 
+func (gui *Gui) handleContainersToggleMarked(g *gocui.Gui, v *gocui.View) error {
+	container, err := gui.getSelectedContainer()
+	if err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Containers
+	panelState.Selection.toggle(container.QualifiedID())
+	gui.changeSelectedLine(&panelState.SelectedLine, gui.getContainerRowCount(), false)
+
+	if err := gui.renderContainers(); err != nil {
+		return err
+	}
+	return gui.handleContainerSelect(gui.g, v)
+}
+
+func (gui *Gui) handleContainersToggleRange(g *gocui.Gui, v *gocui.View) error {
+	if _, err := gui.getSelectedContainer(); err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Containers
+	panelState.Selection.toggleRange(gui.getContainerIDs(), panelState.SelectedLine)
+
+	return gui.renderContainers()
+}
+
 type removeContainerOption struct {
 	description   string
 	command       string
@@ -384,20 +735,26 @@ func (gui *Gui) handleHideStoppedContainers(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleContainersRemoveMenu(g *gocui.Gui, v *gocui.View) error {
-	container, err := gui.getSelectedContainer()
-	if err != nil {
+	containers := gui.getMarkedContainers()
+	if len(containers) == 0 {
 		return nil
 	}
 
+	shortIDs := make([]string, len(containers))
+	for i, container := range containers {
+		shortIDs[i] = container.ID[1:10]
+	}
+	ids := strings.Join(shortIDs, " ")
+
 	options := []*removeContainerOption{
 		{
 			description:   gui.Tr.Remove,
-			command:       "docker rm " + container.ID[1:10],
+			command:       "docker rm " + ids,
 			configOptions: types.ContainerRemoveOptions{},
 		},
 		{
 			description:   gui.Tr.RemoveWithVolumes,
-			command:       "docker rm --volumes " + container.ID[1:10],
+			command:       "docker rm --volumes " + ids,
 			configOptions: types.ContainerRemoveOptions{RemoveVolumes: true},
 		},
 		{
@@ -410,61 +767,78 @@ func (gui *Gui) handleContainersRemoveMenu(g *gocui.Gui, v *gocui.View) error {
 			return nil
 		}
 		configOptions := options[index].configOptions
+		gui.State.Panels.Containers.Selection.clear()
+
+		// running containers can only be removed by force, so we collect them
+		// up and ask about all of them at once after the others are gone
+		var mutex sync.Mutex
+		mustForce := []*commands.Container{}
+
+		remove := func(i int) error {
+			err := containers[i].Remove(configOptions)
+			if commands.HasErrorCode(err, commands.MustStopContainer) {
+				mutex.Lock()
+				mustForce = append(mustForce, containers[i])
+				mutex.Unlock()
+				return nil
+			}
+			return err
+		}
 
-		return gui.WithWaitingStatus(gui.Tr.RemovingStatus, func() error {
-			if err := container.Remove(configOptions); err != nil {
-				if commands.HasErrorCode(err, commands.MustStopContainer) {
-					return gui.createConfirmationPanel(gui.g, v, gui.Tr.Confirm, gui.Tr.MustForceToRemoveContainer, func(g *gocui.Gui, v *gocui.View) error {
-						return gui.WithWaitingStatus(gui.Tr.RemovingStatus, func() error {
-							configOptions.Force = true
-							if err := container.Remove(configOptions); err != nil {
-								return err
-							}
-							return gui.refreshContainersAndServices()
-						})
-					}, nil)
-				}
-				return gui.createErrorPanel(gui.g, err.Error())
+		return gui.runBatch(gui.Tr.RemovingStatus, len(containers), remove, func() error {
+			if err := gui.refreshContainersAndServices(); err != nil {
+				return err
+			}
+			if len(mustForce) == 0 {
+				return nil
 			}
-			return gui.refreshContainersAndServices()
-		})
 
+			return gui.createConfirmationPanel(gui.g, v, gui.Tr.Confirm, gui.Tr.MustForceToRemoveContainer, func(g *gocui.Gui, v *gocui.View) error {
+				configOptions.Force = true
+				forceRemove := func(i int) error {
+					return mustForce[i].Remove(configOptions)
+				}
+				return gui.runBatch(gui.Tr.RemovingStatus, len(mustForce), forceRemove, gui.refreshContainersAndServices)
+			}, nil)
+		})
 	}
 
 	return gui.createMenu("", options, len(options), handleMenuPress)
 }
 
 func (gui *Gui) handleContainerStop(g *gocui.Gui, v *gocui.View) error {
-	container, err := gui.getSelectedContainer()
-	if err != nil {
+	containers := gui.getMarkedContainers()
+	if len(containers) == 0 {
 		return nil
 	}
 
-	return gui.createConfirmationPanel(gui.g, v, gui.Tr.Confirm, gui.Tr.StopContainer, func(g *gocui.Gui, v *gocui.View) error {
-		return gui.WithWaitingStatus(gui.Tr.StoppingStatus, func() error {
-			if err := container.Stop(); err != nil {
-				return gui.createErrorPanel(gui.g, err.Error())
-			}
+	prompt := gui.Tr.StopContainer
+	if len(containers) > 1 {
+		prompt = fmt.Sprintf(gui.Tr.StopMarkedContainers, len(containers))
+	}
 
-			return gui.refreshContainersAndServices()
-		})
+	return gui.createConfirmationPanel(gui.g, v, gui.Tr.Confirm, prompt, func(g *gocui.Gui, v *gocui.View) error {
+		gui.State.Panels.Containers.Selection.clear()
 
+		stop := func(i int) error {
+			return containers[i].Stop()
+		}
+		return gui.runBatch(gui.Tr.StoppingStatus, len(containers), stop, gui.refreshContainersAndServices)
 	}, nil)
 }
 
 func (gui *Gui) handleContainerRestart(g *gocui.Gui, v *gocui.View) error {
-	container, err := gui.getSelectedContainer()
-	if err != nil {
+	containers := gui.getMarkedContainers()
+	if len(containers) == 0 {
 		return nil
 	}
 
-	return gui.WithWaitingStatus(gui.Tr.RestartingStatus, func() error {
-		if err := container.Restart(); err != nil {
-			return gui.createErrorPanel(gui.g, err.Error())
-		}
+	gui.State.Panels.Containers.Selection.clear()
 
-		return gui.refreshContainersAndServices()
-	})
+	restart := func(i int) error {
+		return containers[i].Restart()
+	}
+	return gui.runBatch(gui.Tr.RestartingStatus, len(containers), restart, gui.refreshContainersAndServices)
 }
 
 func (gui *Gui) handleContainerAttach(g *gocui.Gui, v *gocui.View) error {
@@ -473,13 +847,12 @@ func (gui *Gui) handleContainerAttach(g *gocui.Gui, v *gocui.View) error {
 		return nil
 	}
 
-	c, err := container.Attach()
+	session, err := container.AttachSession()
 	if err != nil {
 		return gui.createErrorPanel(gui.g, err.Error())
 	}
 
-	gui.SubProcess = c
-	return gui.Errors.ErrSubProcess
+	return gui.openTerminal(fmt.Sprintf("%s: %s", gui.Tr.Attach, container.Name), session)
 }
 
 func (gui *Gui) handlePruneContainers() error {
@@ -514,54 +887,55 @@ func (gui *Gui) handleContainersExecShell(g *gocui.Gui, v *gocui.View) error {
 	if err != nil {
 		return nil
 	}
-	commandObject := gui.DockerCommand.NewCommandObject(commands.CommandObject{
-		Container: container,
-	})
-	resolvedCommand := utils.ApplyTemplate("docker exec -it {{ .Container.ID }} /bin/sh -c 'eval $(grep ^$(id -un): /etc/passwd | cut -d : -f 7-)'", commandObject)
-	// attach and return the subprocess error
-	cmd := gui.OSCommand.ExecutableFromString(resolvedCommand)
-	gui.SubProcess = cmd
-	return gui.Errors.ErrSubProcess
+
+	session, err := container.ExecShell()
+	if err != nil {
+		return gui.createErrorPanel(gui.g, err.Error())
+	}
+
+	return gui.openTerminal(fmt.Sprintf("%s: %s", gui.Tr.ExecShell, container.Name), session)
 }
 
 func (gui *Gui) handleContainersCustomCommand(g *gocui.Gui, v *gocui.View) error {
-	container, err := gui.getSelectedContainer()
-	if err != nil {
+	if _, err := gui.getSelectedContainer(); err != nil {
 		return nil
 	}
 
-	commandObject := gui.DockerCommand.NewCommandObject(commands.CommandObject{
-		Container: container,
-	})
+	containers := gui.getMarkedContainers()
+	targets := make([]commandTarget, len(containers))
+	for i, container := range containers {
+		targets[i] = commandTarget{
+			name:          container.Endpoint.Qualify(container.Name),
+			commandObject: gui.DockerCommand.NewCommandObject(commands.CommandObject{Container: container}),
+		}
+	}
 
 	customCommands := gui.Config.UserConfig.CustomCommands.Containers
 
-	return gui.createCustomCommandMenu(customCommands, commandObject)
+	return gui.createCustomCommandMenu(customCommands, targets)
 }
 
 func (gui *Gui) handleStopContainers() error {
 	return gui.createConfirmationPanel(gui.g, gui.getContainersView(), gui.Tr.Confirm, gui.Tr.ConfirmStopContainers, func(g *gocui.Gui, v *gocui.View) error {
-		return gui.WithWaitingStatus(gui.Tr.StoppingStatus, func() error {
-
-			for _, container := range gui.DockerCommand.Containers {
-				_ = container.Stop()
-			}
-
+		containers := gui.DockerCommand.Containers
+		stop := func(i int) error {
+			_ = containers[i].Stop()
 			return nil
-		})
+		}
+
+		return gui.runBatch(gui.Tr.StoppingStatus, len(containers), stop, gui.refreshContainersAndServices)
 	}, nil)
 }
 
 func (gui *Gui) handleRemoveContainers() error {
 	return gui.createConfirmationPanel(gui.g, gui.getContainersView(), gui.Tr.Confirm, gui.Tr.ConfirmRemoveContainers, func(g *gocui.Gui, v *gocui.View) error {
-		return gui.WithWaitingStatus(gui.Tr.RemovingStatus, func() error {
-
-			for _, container := range gui.DockerCommand.Containers {
-				_ = container.Remove(types.ContainerRemoveOptions{Force: true})
-			}
-
+		containers := gui.DockerCommand.Containers
+		remove := func(i int) error {
+			_ = containers[i].Remove(types.ContainerRemoveOptions{Force: true})
 			return nil
-		})
+		}
+
+		return gui.runBatch(gui.Tr.RemovingStatus, len(containers), remove, gui.refreshContainersAndServices)
 	}, nil)
 }
 
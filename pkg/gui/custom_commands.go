@@ -1,12 +1,27 @@
 package gui
 
 import (
+	"fmt"
+	"io"
+	"os/exec"
+	"strings"
+	"time"
+
 	"github.com/fatih/color"
+	"github.com/jesseduffield/gocui"
 	"github.com/jesseduffield/lazydocker/pkg/commands"
 	"github.com/jesseduffield/lazydocker/pkg/config"
+	"github.com/jesseduffield/lazydocker/pkg/tasks"
 	"github.com/jesseduffield/lazydocker/pkg/utils"
 )
 
+// commandTarget is something we run a custom command against, e.g. a container.
+// If several items are marked, we have one target per item.
+type commandTarget struct {
+	name          string
+	commandObject commands.CommandObject
+}
+
 type customCommandOption struct {
 	customCommand config.CustomCommand
 	description   string
@@ -14,6 +29,27 @@ type customCommandOption struct {
 	name          string
 	runCommand    bool
 	attach        bool
+
+	// targetNames and targetCommands have an entry per target, with the command
+	// resolved for that target. command is the one for the first target.
+	// If the custom command has an argv, targetArgvs holds it for each target.
+	// targetEndpoints is the daemon each target lives on
+	targetNames     []string
+	targetCommands  []string
+	targetArgvs     [][]string
+	targetEndpoints []*commands.Endpoint
+}
+
+// executable returns the command to run against the i'th target. Argvs are
+// run directly, everything else goes through RunCustomCommand which only uses
+// a shell if the command needs one
+func (r *customCommandOption) executable(osCommand *commands.OSCommand, i int) *exec.Cmd {
+	endpoint := r.targetEndpoints[i]
+	if r.targetArgvs != nil {
+		argv := r.targetArgvs[i]
+		return endpoint.Prepare(osCommand.PrepareSubProcess(argv[0], argv[1:]...))
+	}
+	return endpoint.Prepare(osCommand.RunCustomCommand(r.targetCommands[i]))
 }
 
 // GetDisplayStrings is a function.
@@ -21,18 +57,55 @@ func (r *customCommandOption) GetDisplayStrings(isFocused bool) []string {
 	return []string{r.name, utils.ColoredString(r.description, color.FgCyan)}
 }
 
-func (gui *Gui) createCommandMenu(customCommands []config.CustomCommand, commandObject commands.CommandObject, title string, waitingStatus string) error {
+// streamState holds the output of a custom command being streamed into the
+// main panel, with one tab per target
+type streamState struct {
+	Titles   []string
+	Outputs  []*tasks.OutputBuffer
+	TabIndex int
+}
+
+func (gui *Gui) createCommandMenu(customCommands []config.CustomCommand, targets []commandTarget, title string, waitingStatus string) error {
 	options := make([]*customCommandOption, len(customCommands)+1)
 	for i, command := range customCommands {
-		resolvedCommand := utils.ApplyTemplate(command.Command, commandObject)
+		targetNames := make([]string, len(targets))
+		targetCommands := make([]string, len(targets))
+		targetEndpoints := make([]*commands.Endpoint, len(targets))
+		var targetArgvs [][]string
+		if len(command.Argv) > 0 {
+			targetArgvs = make([][]string, len(targets))
+		}
+		for j, target := range targets {
+			targetNames[j] = target.name
+			targetEndpoints[j] = target.commandObject.Endpoint()
+			if targetArgvs == nil {
+				targetCommands[j] = utils.ApplyTemplate(command.Command, target.commandObject)
+				continue
+			}
+			argv := make([]string, len(command.Argv))
+			for k, arg := range command.Argv {
+				argv[k] = utils.ApplyTemplate(arg, target.commandObject)
+			}
+			targetArgvs[j] = argv
+			targetCommands[j] = strings.Join(argv, " ")
+		}
+
+		description := utils.WithShortSha(targetCommands[0])
+		if len(targets) > 1 {
+			description += " " + fmt.Sprintf(gui.Tr.CommandTargets, len(targets))
+		}
 
 		options[i] = &customCommandOption{
-			customCommand: command,
-			description:   utils.WithShortSha(resolvedCommand),
-			command:       resolvedCommand,
-			runCommand:    true,
-			attach:        command.Attach,
-			name:          command.Name,
+			customCommand:   command,
+			description:     description,
+			command:         targetCommands[0],
+			runCommand:      true,
+			attach:          command.Attach,
+			name:            command.Name,
+			targetNames:     targetNames,
+			targetCommands:  targetCommands,
+			targetArgvs:     targetArgvs,
+			targetEndpoints: targetEndpoints,
 		}
 	}
 	options[len(options)-1] = &customCommandOption{
@@ -50,28 +123,146 @@ func (gui *Gui) createCommandMenu(customCommands []config.CustomCommand, command
 			return option.customCommand.InternalFunction()
 		}
 
-		// if we have a command for attaching, we attach and return the subprocess error
+		// if we have a command for attaching, we attach and return the subprocess
+		// error. We can only attach to one thing at a time so marked items beyond
+		// the first are ignored
 		if option.customCommand.Attach {
-			cmd := gui.OSCommand.ExecutableFromString(option.command)
-			gui.SubProcess = cmd
+			gui.SubProcess = option.executable(gui.OSCommand, 0)
 			return gui.Errors.ErrSubProcess
 		}
 
-		return gui.WithWaitingStatus(waitingStatus, func() error {
-			if err := gui.OSCommand.RunCommand(option.command); err != nil {
-				return gui.createErrorPanel(gui.g, err.Error())
+		if option.customCommand.Stream {
+			titles := option.targetNames
+			if len(titles) == 1 {
+				titles = []string{option.name}
+			}
+			executables := make([]*exec.Cmd, len(option.targetCommands))
+			for i := range executables {
+				executables[i] = option.executable(gui.OSCommand, i)
+			}
+			return gui.streamCommands(titles, executables)
+		}
+
+		// background jobs stream their output to the jobs tab of the project panel
+		// so that we can keep using lazydocker while they run
+		if option.customCommand.Background {
+			for i, command := range option.targetCommands {
+				cmd := option.executable(gui.OSCommand, i)
+				gui.Jobs.NewJob(utils.WithShortSha(command), func(stop chan struct{}, out io.Writer) error {
+					return gui.OSCommand.RunExecutableWithStop(cmd, stop, out)
+				})
 			}
 			return nil
-		})
+		}
+
+		run := func(i int) error {
+			return gui.OSCommand.RunExecutable(option.executable(gui.OSCommand, i))
+		}
+		return gui.runBatch(waitingStatus, len(option.targetCommands), run, nil)
 	}
 
 	return gui.createMenu(title, options, len(options), handleMenuPress)
 }
 
-func (gui *Gui) createCustomCommandMenu(customCommands []config.CustomCommand, commandObject commands.CommandObject) error {
-	return gui.createCommandMenu(customCommands, commandObject, gui.Tr.CustomCommandTitle, gui.Tr.RunningCustomCommandStatus)
+func (gui *Gui) createCustomCommandMenu(customCommands []config.CustomCommand, targets []commandTarget) error {
+	return gui.createCommandMenu(customCommands, targets, gui.Tr.CustomCommandTitle, gui.Tr.RunningCustomCommandStatus)
 }
 
 func (gui *Gui) createBulkCommandMenu(customCommands []config.CustomCommand, commandObject commands.CommandObject) error {
-	return gui.createCommandMenu(customCommands, commandObject, gui.Tr.BulkCommandTitle, gui.Tr.RunningBulkCommandStatus)
+	targets := []commandTarget{{commandObject: commandObject}}
+	return gui.createCommandMenu(customCommands, targets, gui.Tr.BulkCommandTitle, gui.Tr.RunningBulkCommandStatus)
+}
+
+// streamCommands runs the given commands at once, playing their output in the
+// main panel with a tab for each. Like the logs, this runs as a task, so the
+// commands are killed as soon as the main panel moves on to something else.
+func (gui *Gui) streamCommands(titles []string, executables []*exec.Cmd) error {
+	stream := &streamState{
+		Titles:  titles,
+		Outputs: make([]*tasks.OutputBuffer, len(executables)),
+	}
+	for i := range stream.Outputs {
+		stream.Outputs[i] = tasks.NewOutputBuffer(gui.Config.UserConfig.Jobs.MaxOutputLines)
+	}
+	gui.State.Panels.Main.Stream = stream
+
+	mainView := gui.getMainView()
+	mainView.Autoscroll = true
+	mainView.Wrap = gui.Config.UserConfig.Gui.WrapMainPanel
+	gui.renderStream(stream)
+
+	return gui.T.NewTask(func(stop chan struct{}) {
+		done := make(chan struct{})
+		go func() {
+			run := func(i int) error {
+				out := stream.Outputs[i]
+				if err := gui.OSCommand.RunExecutableWithStop(executables[i], stop, out); err != nil {
+					fmt.Fprintln(out, "\n"+utils.ColoredString(err.Error(), color.FgRed))
+				}
+				out.Flush()
+				return nil
+			}
+			_ = utils.ForEachConcurrently(len(executables), gui.Config.UserConfig.Gui.BatchConcurrency, run)
+			close(done)
+		}()
+
+		ticker := time.NewTicker(time.Millisecond * 100)
+		defer ticker.Stop()
+
+		renderedVersion := -1
+		render := func() {
+			version := 0
+			for _, output := range stream.Outputs {
+				version += output.Version()
+			}
+			if version == renderedVersion {
+				return
+			}
+			renderedVersion = version
+			gui.update(func(g *gocui.Gui) error {
+				if gui.State.Panels.Main.Stream == stream {
+					gui.renderStream(stream)
+				}
+				return nil
+			})
+		}
+
+		for {
+			select {
+			case <-stop:
+				// the commands have been told to stop too, but we wait for them
+				// so that we're not leaving any processes behind
+				<-done
+				return
+			case <-done:
+				render()
+				return
+			case <-ticker.C:
+				render()
+			}
+		}
+	})
+}
+
+// renderStream shows the output of the current tab of a streamed command
+func (gui *Gui) renderStream(stream *streamState) {
+	mainView := gui.getMainView()
+	mainView.Tabs = stream.Titles
+	mainView.TabIndex = stream.TabIndex
+	mainView.Clear()
+	fmt.Fprint(mainView, stream.Outputs[stream.TabIndex].String())
+}
+
+// cycleStreamTab switches to the next/previous target's output if we're
+// streaming a command against several targets, returning false otherwise
+func (gui *Gui) cycleStreamTab(delta int) bool {
+	stream := gui.State.Panels.Main.Stream
+	if stream == nil || len(stream.Titles) < 2 {
+		return false
+	}
+
+	count := len(stream.Titles)
+	stream.TabIndex = (stream.TabIndex + delta + count) % count
+	gui.renderStream(stream)
+	return true
 }
@@ -0,0 +1,138 @@
+package gui
+
+import (
+	"fmt"
+	"strings"
+
+	"github.com/jesseduffield/gocui"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// listFilter narrows a list panel down to the rows matching what the user has
+// typed into the filter prompt
+type listFilter struct {
+	Query string
+
+	// title is the view's title before we added the filter to it
+	title string
+	index *utils.SearchIndex
+	// err is set if the query couldn't be parsed
+	err error
+}
+
+func newListFilter() *listFilter {
+	return &listFilter{}
+}
+
+// matches returns the indices of the rows which fuzzy-match the given query,
+// where key identifies the i'th row and row returns what to match it against.
+// The index outlives refreshes of the list, so that we only build rows for
+// what's new or changed
+func (f *listFilter) matches(query string, count int, key func(int) string, row func(int) utils.SearchRow) []int {
+	if f.index == nil {
+		f.index = utils.NewSearchIndex()
+	}
+	return f.index.Filter(query, count, key, row)
+}
+
+func (gui *Gui) getListFilter(viewName string) *listFilter {
+	switch viewName {
+	case "containers":
+		return gui.State.Panels.Containers.Filter
+	case "services":
+		return gui.State.Panels.Services.Filter
+	case "images":
+		return gui.State.Panels.Images.Filter
+	case "volumes":
+		return gui.State.Panels.Volumes.Filter
+	}
+	return nil
+}
+
+// applyListFilter filters the given list view again after its query has
+// changed, selecting the first row that's left
+func (gui *Gui) applyListFilter(viewName string) error {
+	var selectedLine *int
+	var itemCount int
+	switch viewName {
+	case "containers":
+		gui.filterContainers()
+		selectedLine, itemCount = &gui.State.Panels.Containers.SelectedLine, gui.getContainerRowCount()
+	case "services":
+		gui.filterServices()
+		selectedLine, itemCount = &gui.State.Panels.Services.SelectedLine, len(gui.DockerCommand.Services)
+	case "images":
+		gui.filterImages()
+		selectedLine, itemCount = &gui.State.Panels.Images.SelectedLine, len(gui.DockerCommand.Images)
+	case "volumes":
+		gui.filterVolumes()
+		selectedLine, itemCount = &gui.State.Panels.Volumes.SelectedLine, len(gui.DockerCommand.Volumes)
+	default:
+		return nil
+	}
+
+	*selectedLine = 0
+	if itemCount == 0 {
+		*selectedLine = -1
+	}
+
+	v, err := gui.g.View(viewName)
+	if err != nil {
+		return nil
+	}
+	filter := gui.getListFilter(viewName)
+	if filter.title == "" {
+		filter.title = v.Title
+	}
+	v.Title = filter.title
+	if filter.err != nil {
+		v.Title += " " + fmt.Sprintf(gui.Tr.InvalidFilter, filter.err.Error())
+	} else if filter.Query != "" {
+		v.Title += " " + fmt.Sprintf(gui.Tr.Filtered, filter.Query)
+	}
+
+	delete(gui.State.ListWindows, viewName)
+	_ = v.SetOrigin(0, 0)
+	_ = v.SetCursor(0, 0)
+	return gui.renderListWindow(viewName)
+}
+
+// handleOpenListFilter opens a prompt which filters the list as the user types.
+// Enter keeps the filter in place and esc clears it
+func (gui *Gui) handleOpenListFilter(g *gocui.Gui, v *gocui.View) error {
+	viewName := v.Name()
+	filter := gui.getListFilter(viewName)
+	if filter == nil {
+		return nil
+	}
+
+	gui.onNewPopupPanel()
+	promptView, err := gui.prepareConfirmationPanel(v, gui.Tr.FilterPrompt, "", false)
+	if err != nil {
+		return err
+	}
+	promptView.Editable = true
+	promptView.Editor = gocui.EditorFunc(func(promptView *gocui.View, key gocui.Key, ch rune, mod gocui.Modifier) {
+		gocui.DefaultEditor.Edit(promptView, key, ch, mod)
+
+		query := strings.TrimSpace(promptView.Buffer())
+		if query == filter.Query {
+			return
+		}
+		filter.Query = query
+		if err := gui.applyListFilter(viewName); err != nil {
+			gui.Log.Error(err)
+		}
+	})
+	for _, ch := range filter.Query {
+		promptView.EditWrite(ch)
+	}
+
+	return gui.setPromptKeyBindings(g, nil, func(g *gocui.Gui, promptView *gocui.View) error {
+		if filter.Query == "" {
+			return nil
+		}
+		filter.Query = ""
+		return gui.applyListFilter(viewName)
+	})
+}
@@ -2,6 +2,8 @@ package gui
 
 import (
 	"github.com/golang-collections/collections/stack"
+	"reflect"
+	"runtime"
 	"strings"
 	"sync"
 
@@ -16,10 +18,13 @@ import (
 	// "strings"
 
 	"github.com/jesseduffield/gocui"
+	"github.com/jesseduffield/lazydocker/pkg/bench"
 	"github.com/jesseduffield/lazydocker/pkg/commands"
 	"github.com/jesseduffield/lazydocker/pkg/config"
 	"github.com/jesseduffield/lazydocker/pkg/i18n"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
 	"github.com/jesseduffield/lazydocker/pkg/tasks"
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
 	"github.com/sirupsen/logrus"
 )
 
@@ -68,18 +73,44 @@ type Gui struct {
 	statusManager *statusManager
 	waitForIntro  sync.WaitGroup
 	T             *tasks.TaskManager
+	Jobs          *tasks.JobManager
 	ErrorChan     chan error
 	CyclableViews []string
+
+	// Bench records how we're doing while `lazydocker bench` drives us. It's
+	// nil the rest of the time
+	Bench *bench.Recorder
+
+	// Metrics is what we show in the internals tab. It's nil unless the tab is
+	// switched on
+	Metrics *metrics.Metrics
+
+	// Tracer records spans of our refreshes and renders. It's nil unless
+	// lazydocker was started with --spans
+	Tracer *tracing.Tracer
 }
 
 type servicePanelState struct {
 	SelectedLine int
 	ContextIndex int // for specifying if you are looking at logs/stats/config/etc
+	Filter       *listFilter
+	Unfiltered   []*commands.Service
 }
 
 type containerPanelState struct {
 	SelectedLine int
 	ContextIndex int // for specifying if you are looking at logs/stats/config/etc
+	Selection    *listSelection
+	SortBy       string
+	Filter       *listFilter
+	Unfiltered   []*commands.Container
+
+	// Grouped tells us whether we're showing the containers as a tree of
+	// compose projects and services, in which case Rows holds the tree's rows
+	// and Collapsed holds the keys of the groups the user has collapsed
+	Grouped   bool
+	Rows      []*commands.ContainerTreeRow
+	Collapsed map[string]bool
 }
 
 type projectState struct {
@@ -94,16 +125,33 @@ type menuPanelState struct {
 type mainPanelState struct {
 	// ObjectKey tells us what context we are in. For example, if we are looking at the logs of a particular service in the services panel this key might be 'services-<service id>-logs'. The key is made so that if something changes which might require us to re-run the logs command or run a different command, the key will be different, and we'll then know to do whatever is required. Object key probably isn't the best name for this but Context is already used to refer to tabs. Maybe I should just call them tabs.
 	ObjectKey string
+
+	// Stream is the output of a custom command we're streaming into the main
+	// panel, if any. It's cleared as soon as the main panel moves on
+	Stream *streamState
 }
 
 type imagePanelState struct {
 	SelectedLine int
 	ContextIndex int // for specifying if you are looking at logs/stats/config/etc
+	Selection    *listSelection
+	SortBy       string
+	Filter       *listFilter
+	Unfiltered   []*commands.Image
 }
 
 type volumePanelState struct {
 	SelectedLine int
 	ContextIndex int
+	Selection    *listSelection
+	Filter       *listFilter
+	Unfiltered   []*commands.Volume
+
+	// we only refresh volumes when something has changed, so we keep track of
+	// what we last refreshed them for
+	RefreshedSession   int
+	RefreshedEvents    int
+	RefreshedDiskUsage int
 }
 
 type panelStates struct {
@@ -124,6 +172,13 @@ type guiState struct {
 	SubProcessOutput string
 	Stats            map[string]commands.ContainerStats
 
+	// Terminal is the exec/attach session shown over the main panel, if any
+	Terminal *terminalState
+
+	// ListWindows holds, for each list panel, the range of its items that are
+	// currently written to its view
+	ListWindows map[string]*listWindow
+
 	// SessionIndex tells us how many times we've come back from a subprocess.
 	// We increment it each time we switch to a new subprocess
 	// Every time we go to a subprocess we need to close a few goroutines so this index is used for that purpose
@@ -135,10 +190,10 @@ func NewGui(log *logrus.Entry, dockerCommand *commands.DockerCommand, oSCommand
 	initialState := guiState{
 		Platform: *oSCommand.Platform,
 		Panels: &panelStates{
-			Services:   &servicePanelState{SelectedLine: -1, ContextIndex: 0},
-			Containers: &containerPanelState{SelectedLine: -1, ContextIndex: 0},
-			Images:     &imagePanelState{SelectedLine: -1, ContextIndex: 0},
-			Volumes:    &volumePanelState{SelectedLine: -1, ContextIndex: 0},
+			Services:   &servicePanelState{SelectedLine: -1, ContextIndex: 0, Filter: newListFilter()},
+			Containers: &containerPanelState{SelectedLine: -1, ContextIndex: 0, Selection: newListSelection(), Filter: newListFilter(), Collapsed: map[string]bool{}},
+			Images:     &imagePanelState{SelectedLine: -1, ContextIndex: 0, Selection: newListSelection(), Filter: newListFilter()},
+			Volumes:    &volumePanelState{SelectedLine: -1, ContextIndex: 0, Selection: newListSelection(), Filter: newListFilter(), RefreshedSession: -1},
 			Menu:       &menuPanelState{SelectedLine: 0},
 			Main: &mainPanelState{
 				ObjectKey: "",
@@ -147,6 +202,7 @@ func NewGui(log *logrus.Entry, dockerCommand *commands.DockerCommand, oSCommand
 		},
 		SessionIndex:  0,
 		PreviousViews: stack.New(),
+		ListWindows:   map[string]*listWindow{},
 	}
 
 	cyclableViews := []string{"project", "containers", "images", "volumes"}
@@ -164,8 +220,21 @@ func NewGui(log *logrus.Entry, dockerCommand *commands.DockerCommand, oSCommand
 		Tr:            tr,
 		statusManager: &statusManager{},
 		T:             tasks.NewTaskManager(log, tr),
+		Jobs:          tasks.NewJobManager(log, config.UserConfig.Jobs.MaxConcurrent, config.UserConfig.Jobs.MaxOutputLines),
 		ErrorChan:     errorChan,
 		CyclableViews: cyclableViews,
+		Bench:         bench.RecorderFromEnv(),
+		Metrics:       oSCommand.Metrics,
+		Tracer:        oSCommand.Tracer,
+	}
+
+	// a benchmark can't answer questions, so we don't ask any. We leave the
+	// config file alone so that the next normal run still asks
+	if gui.Bench != nil {
+		if config.UserConfig.Reporting == "undetermined" {
+			config.UserConfig.Reporting = "off"
+		}
+		config.UserConfig.ConfirmOnQuit = false
 	}
 
 	gui.GenerateSentinelErrors()
@@ -226,6 +295,7 @@ func (gui *Gui) renderGlobalOptions() error {
 
 func (gui *Gui) goEvery(interval time.Duration, function func() error) {
 	currentSessionIndex := gui.State.SessionIndex
+	function = gui.timed(function)
 	_ = function() // time.Tick doesn't run immediately so we'll do that here // TODO: maybe change
 	go func() {
 		ticker := time.NewTicker(interval)
@@ -239,10 +309,54 @@ func (gui *Gui) goEvery(interval time.Duration, function func() error) {
 	}()
 }
 
+// goEveryRefresh is like goEvery but for functions that talk to the daemon.
+// Rather than ticking at a fixed rate, we wait after each call for however long
+// the docker command says we should given how long that call took, so that a
+// slow daemon isn't asked again before it's had a breather
+func (gui *Gui) goEveryRefresh(interval time.Duration, function func() error) {
+	currentSessionIndex := gui.State.SessionIndex
+	function = gui.timed(function)
+	go func() {
+		for {
+			start := time.Now()
+			_ = function()
+			time.Sleep(gui.DockerCommand.RefreshDelay(interval, time.Since(start)))
+			if gui.State.SessionIndex > currentSessionIndex {
+				return
+			}
+		}
+	}()
+}
+
+// timed wraps a periodic function so that a benchmark, the internals tab or a
+// trace can see how long each call takes. Otherwise it returns the function as
+// is
+func (gui *Gui) timed(function func() error) func() error {
+	if gui.Bench == nil && gui.Metrics == nil && gui.Tracer == nil {
+		return function
+	}
+
+	// e.g. 'github.com/jesseduffield/lazydocker/pkg/gui.(*Gui).refreshProject-fm'
+	name := runtime.FuncForPC(reflect.ValueOf(function).Pointer()).Name()
+	name = strings.TrimSuffix(name[strings.LastIndex(name, ".")+1:], "-fm")
+
+	return func() error {
+		span := gui.Tracer.Start("refresh", name)
+		start := time.Now()
+		err := function()
+		took := time.Since(start)
+		span.End()
+		gui.Bench.Refresh(name, took)
+		gui.Metrics.ObserveRefresh(name, took)
+		return err
+	}
+}
+
 // Run setup the gui with keybindings and start the mainloop
 func (gui *Gui) Run() error {
 	// closing our task manager which in turn closes the current task if there is any, so we aren't leaving processes lying around after closing lazydocker
 	defer gui.T.Close()
+	defer gui.closeTerminal()
 
 	g, err := gocui.NewGui(gocui.OutputNormal, OverlappingEdges)
 	if err != nil {
@@ -272,13 +386,14 @@ func (gui *Gui) Run() error {
 		gui.waitForIntro.Wait()
 		gui.goEvery(time.Millisecond*30, gui.reRenderMain)
 		gui.goEvery(dockerRefreshInterval, gui.refreshProject)
-		gui.goEvery(dockerRefreshInterval, gui.refreshContainersAndServices)
-		gui.goEvery(dockerRefreshInterval, gui.refreshVolumes)
-		gui.goEvery(time.Millisecond*1000, gui.DockerCommand.UpdateContainerDetails)
+		gui.goEveryRefresh(dockerRefreshInterval, gui.refreshContainersAndServices)
+		gui.goEveryRefresh(dockerRefreshInterval, gui.refreshVolumesOnChange)
+		gui.goEveryRefresh(time.Millisecond*1000, gui.DockerCommand.UpdateContainerDetails)
 		gui.goEvery(time.Millisecond*1000, gui.checkForContextChange)
 	}()
 
 	gui.DockerCommand.MonitorContainerStats()
+	gui.DockerCommand.MonitorEvents()
 
 	go func() {
 		for err := range gui.ErrorChan {
@@ -315,7 +430,7 @@ func (gui *Gui) reRenderMain() error {
 		return nil
 	}
 	if mainView.IsTainted() {
-		gui.g.Update(func(g *gocui.Gui) error {
+		gui.update(func(g *gocui.Gui) error {
 			return nil
 		})
 	}
@@ -386,6 +501,7 @@ func (gui *Gui) shouldRefresh(key string) bool {
 	}
 
 	gui.State.Panels.Main.ObjectKey = key
+	gui.State.Panels.Main.Stream = nil
 	return true
 }
 
@@ -2,6 +2,7 @@ package gui
 
 import (
 	"fmt"
+	"io"
 	"strings"
 	"time"
 
@@ -17,11 +18,11 @@ import (
 // list panel functions
 
 func (gui *Gui) getImageContexts() []string {
-	return []string{"config"}
+	return []string{"config", "pulls"}
 }
 
 func (gui *Gui) getImageContextTitles() []string {
-	return []string{gui.Tr.ConfigTitle}
+	return []string{gui.Tr.ConfigTitle, gui.Tr.PullsTitle}
 }
 
 func (gui *Gui) getSelectedImage() (*commands.Image, error) {
@@ -33,6 +34,28 @@ func (gui *Gui) getSelectedImage() (*commands.Image, error) {
 	return gui.DockerCommand.Images[selectedLine], nil
 }
 
+// getImageIDs returns the ID of each image qualified by its endpoint, since the
+// same image pulled onto two daemons has the same ID on both
+func (gui *Gui) getImageIDs() []string {
+	ids := make([]string, len(gui.DockerCommand.Images))
+	for i, image := range gui.DockerCommand.Images {
+		ids[i] = image.UsageKey()
+	}
+	return ids
+}
+
+// getMarkedImages returns the images the user has marked, or the selected
+// image if none are marked
+func (gui *Gui) getMarkedImages() []*commands.Image {
+	panelState := gui.State.Panels.Images
+	indices := panelState.Selection.markedIndices(gui.getImageIDs(), panelState.SelectedLine)
+	images := make([]*commands.Image, len(indices))
+	for i, index := range indices {
+		images[i] = gui.DockerCommand.Images[index]
+	}
+	return images
+}
+
 func (gui *Gui) handleImagesClick(g *gocui.Gui, v *gocui.View) error {
 	itemCount := len(gui.DockerCommand.Images)
 	handleSelect := gui.handleImageSelect
@@ -42,19 +65,26 @@ func (gui *Gui) handleImagesClick(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleImageSelect(g *gocui.Gui, v *gocui.View) error {
+	context := gui.getImageContexts()[gui.State.Panels.Images.ContextIndex]
+
 	Image, err := gui.getSelectedImage()
 	if err != nil {
 		if err != gui.Errors.ErrNoImages {
 			return err
 		}
-		return gui.renderString(g, "main", gui.Tr.NoImages)
-	}
-
-	if err := gui.focusPoint(0, gui.State.Panels.Images.SelectedLine, len(gui.DockerCommand.Images), v); err != nil {
+		// you can still pull an image when you don't have any yet
+		if context != "pulls" {
+			return gui.renderString(g, "main", gui.Tr.NoImages)
+		}
+	} else if err := gui.focusPoint(0, gui.State.Panels.Images.SelectedLine, len(gui.DockerCommand.Images), v); err != nil {
 		return err
 	}
 
-	key := "images-" + Image.ID + "-" + gui.getImageContexts()[gui.State.Panels.Images.ContextIndex]
+	// the pulls tab doesn't depend on which image is selected
+	key := "images-" + Image.ID + "-" + context
+	if context == "pulls" {
+		key = "images-" + context
+	}
 	if !gui.shouldRefresh(key) {
 		return nil
 	}
@@ -63,11 +93,16 @@ func (gui *Gui) handleImageSelect(g *gocui.Gui, v *gocui.View) error {
 	mainView.Tabs = gui.getImageContextTitles()
 	mainView.TabIndex = gui.State.Panels.Images.ContextIndex
 
-	switch gui.getImageContexts()[gui.State.Panels.Images.ContextIndex] {
+	switch context {
 	case "config":
 		if err := gui.renderImageConfig(mainView, Image); err != nil {
 			return err
 		}
+		gui.prefetchImageHistories()
+	case "pulls":
+		if err := gui.renderImagePulls(mainView); err != nil {
+			return err
+		}
 	default:
 		return errors.New("Unknown context for Images panel")
 	}
@@ -83,9 +118,23 @@ func (gui *Gui) renderImageConfig(mainView *gocui.View, image *commands.Image) e
 		output += utils.WithPadding("ID: ", padding) + image.Image.ID + "\n"
 		output += utils.WithPadding("Tags: ", padding) + utils.ColoredString(strings.Join(image.Image.RepoTags, ", "), color.FgGreen) + "\n"
 		output += utils.WithPadding("Size: ", padding) + utils.FormatDecimalBytes(int(image.Image.Size)) + "\n"
+		if names := gui.DockerCommand.UsageIndex.ImageContainerNames(image.UsageKey()); len(names) > 0 {
+			output += utils.WithPadding("Used by: ", padding) + utils.ColoredString(strings.Join(names, ", "), color.FgGreen) + "\n"
+		}
+		if image.LayerUsage != nil {
+			output += utils.WithPadding("Shared: ", padding) + utils.FormatDecimalBytes(int(image.LayerUsage.Shared)) + "\n"
+			output += utils.WithPadding("Unique: ", padding) + utils.FormatDecimalBytes(int(image.LayerUsage.Unique)) + "\n"
+		}
 		output += utils.WithPadding("Created: ", padding) + fmt.Sprintf("%v", time.Unix(image.Image.Created, 0).Format(time.RFC1123)) + "\n"
 
-		history, err := image.RenderHistory()
+		var history string
+		var err error
+		// we only cache the histories of images on the first endpoint
+		if gui.DockerCommand.OnFirstEndpoint(image.Endpoint) {
+			history, err = gui.DockerCommand.ImageHistories.Render(image.ID)
+		} else {
+			history, err = image.RenderHistory()
+		}
 		if err != nil {
 			gui.Log.Error(err)
 		}
@@ -99,6 +148,45 @@ func (gui *Gui) renderImageConfig(mainView *gocui.View, image *commands.Image) e
 	})
 }
 
+// imagePrefetchDistance is how many images either side of the selected one we
+// fetch the history of in advance, so that scrolling through the list doesn't
+// wait on the daemon
+const imagePrefetchDistance = 5
+
+func (gui *Gui) prefetchImageHistories() {
+	selectedLine := gui.State.Panels.Images.SelectedLine
+	images := gui.DockerCommand.Images
+
+	ids := []string{}
+	for i := selectedLine - imagePrefetchDistance; i <= selectedLine+imagePrefetchDistance; i++ {
+		if i >= 0 && i < len(images) && i != selectedLine && gui.DockerCommand.OnFirstEndpoint(images[i].Endpoint) {
+			ids = append(ids, images[i].ID)
+		}
+	}
+	gui.DockerCommand.ImageHistories.Prefetch(ids)
+}
+
+func (gui *Gui) renderImagePulls(mainView *gocui.View) error {
+	mainView.Autoscroll = false
+	mainView.Wrap = false
+
+	lastVersion := -1
+	return gui.T.NewTickerTask(time.Millisecond*100, func(stop chan struct{}) { gui.clearMainView() }, func(stop, notifyStopped chan struct{}) {
+		version := gui.DockerCommand.Pulls.Version()
+		if version == lastVersion {
+			return
+		}
+		lastVersion = version
+
+		width, _ := mainView.Size()
+		content := gui.DockerCommand.Pulls.Render(width)
+		if content == "" {
+			content = gui.Tr.NoPulls
+		}
+		gui.reRenderString(gui.g, "main", content)
+	})
+}
+
 func (gui *Gui) refreshImages() error {
 	ImagesView := gui.getImagesView()
 	if ImagesView == nil {
@@ -116,15 +204,10 @@ func (gui *Gui) refreshImages() error {
 		gui.State.Panels.Images.SelectedLine = len(gui.DockerCommand.Images) - 1
 	}
 
-	gui.g.Update(func(g *gocui.Gui) error {
-
-		ImagesView.Clear()
-		isFocused := gui.g.CurrentView().Name() == "Images"
-		list, err := utils.RenderList(gui.DockerCommand.Images, utils.IsFocused(isFocused))
-		if err != nil {
+	gui.update(func(g *gocui.Gui) error {
+		if err := gui.renderImages(); err != nil {
 			return err
 		}
-		fmt.Fprint(ImagesView, list)
 
 		if ImagesView == g.CurrentView() {
 			return gui.handleImageSelect(g, ImagesView)
@@ -142,11 +225,142 @@ func (gui *Gui) refreshStateImages() error {
 		return err
 	}
 
-	gui.DockerCommand.Images = Images
+	selectedID := gui.selectedImageID()
+	gui.State.Panels.Images.Unfiltered = Images
+	gui.sortImages(selectedID)
+
+	go gui.updateImageLayers(Images)
 
 	return nil
 }
 
+// updateImageLayers works out which layers our images share with each other
+// in the background, re-rendering the images panel if that changes anything.
+// We only have to inspect images we haven't seen before
+func (gui *Gui) updateImageLayers(images []*commands.Image) {
+	ids := []string{}
+	for _, image := range images {
+		if gui.DockerCommand.OnFirstEndpoint(image.Endpoint) {
+			ids = append(ids, image.ID)
+		}
+	}
+
+	if !gui.DockerCommand.Layers.Update(ids) {
+		return
+	}
+
+	gui.update(func(g *gocui.Gui) error {
+		for _, image := range gui.State.Panels.Images.Unfiltered {
+			if !gui.DockerCommand.OnFirstEndpoint(image.Endpoint) {
+				continue
+			}
+			if usage, ok := gui.DockerCommand.Layers.Usage(image.ID); ok {
+				image.LayerUsage = &usage
+			}
+		}
+		gui.sortImages(gui.selectedImageID())
+		return gui.renderImages()
+	})
+}
+
+func (gui *Gui) selectedImageID() string {
+	selectedLine := gui.State.Panels.Images.SelectedLine
+	if selectedLine < 0 || selectedLine >= len(gui.DockerCommand.Images) {
+		return ""
+	}
+	return gui.DockerCommand.Images[selectedLine].ID
+}
+
+// sortImages sorts the images the way the user has asked, keeping the given
+// image selected if it's still around
+func (gui *Gui) sortImages(selectedID string) {
+	commands.SortImages(gui.State.Panels.Images.Unfiltered, gui.State.Panels.Images.SortBy)
+	gui.filterImages()
+	for i, image := range gui.DockerCommand.Images {
+		if image.ID == selectedID {
+			gui.State.Panels.Images.SelectedLine = i
+			return
+		}
+	}
+}
+
+// filterImages narrows the images we display down to those matching the
+// images panel's filter
+func (gui *Gui) filterImages() {
+	panelState := gui.State.Panels.Images
+	all := panelState.Unfiltered
+	if panelState.Filter.Query == "" {
+		gui.DockerCommand.Images = all
+		return
+	}
+
+	matches := panelState.Filter.matches(panelState.Filter.Query, len(all), func(i int) string { return all[i].SearchKey() }, func(i int) utils.SearchRow { return all[i].SearchRow() })
+	images := make([]*commands.Image, len(matches))
+	for i, index := range matches {
+		images[i] = all[index]
+	}
+	gui.DockerCommand.Images = images
+}
+
+type sortOption struct {
+	description string
+	sortBy      string
+	selected    bool
+}
+
+// GetDisplayStrings is a function.
+func (r *sortOption) GetDisplayStrings(isFocused bool) []string {
+	if r.selected {
+		return []string{utils.ColoredString(r.description, color.FgGreen)}
+	}
+	return []string{r.description}
+}
+
+func (gui *Gui) handleImagesSortMenu(g *gocui.Gui, v *gocui.View) error {
+	options := []*sortOption{
+		{description: gui.Tr.SortByNewest, sortBy: commands.ImageSortDefault},
+		{description: gui.Tr.SortByTotalSize, sortBy: commands.ImageSortTotal},
+		{description: gui.Tr.SortBySharedSize, sortBy: commands.ImageSortShared},
+		{description: gui.Tr.SortByUniqueSize, sortBy: commands.ImageSortUnique},
+	}
+	for _, option := range options {
+		option.selected = option.sortBy == gui.State.Panels.Images.SortBy
+	}
+
+	handleMenuPress := func(index int) error {
+		gui.State.Panels.Images.SortBy = options[index].sortBy
+		gui.sortImages(gui.selectedImageID())
+		if err := gui.renderImages(); err != nil {
+			return err
+		}
+		return gui.handleImageSelect(gui.g, gui.getImagesView())
+	}
+
+	return gui.createMenu(gui.Tr.SortTitle, options, len(options), handleMenuPress)
+}
+
+// renderImages writes the images list to its view. It must be called from
+// within the gui's main loop
+func (gui *Gui) renderImages() error {
+	ImagesView := gui.getImagesView()
+	window := gui.updateListWindow(ImagesView, len(gui.DockerCommand.Images))
+	ImagesView.Clear()
+	isFocused := gui.g.CurrentView().Name() == "Images"
+
+	for _, image := range gui.DockerCommand.Images {
+		image.ContainerCount = gui.DockerCommand.UsageIndex.ImageUseCount(image.UsageKey())
+	}
+
+	panelState := gui.State.Panels.Images
+	markedLines := panelState.Selection.renderOption(gui.getImageIDs(), panelState.SelectedLine, window.start)
+	list, err := utils.RenderList(gui.DockerCommand.Images[window.start:window.end], utils.IsFocused(isFocused), markedLines)
+	if err != nil {
+		return err
+	}
+	fmt.Fprint(ImagesView, list)
+	return nil
+}
+
 func (gui *Gui) handleImagesNextLine(g *gocui.Gui, v *gocui.View) error {
 	if gui.popupPanelFocused() || gui.g.CurrentView() != v {
 		return nil
@@ -155,6 +369,12 @@ func (gui *Gui) handleImagesNextLine(g *gocui.Gui, v *gocui.View) error {
 	panelState := gui.State.Panels.Images
 	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Images), false)
 
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderImages(); err != nil {
+			return err
+		}
+	}
+
 	return gui.handleImageSelect(gui.g, v)
 }
 
@@ -166,10 +386,20 @@ func (gui *Gui) handleImagesPrevLine(g *gocui.Gui, v *gocui.View) error {
 	panelState := gui.State.Panels.Images
 	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Images), true)
 
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderImages(); err != nil {
+			return err
+		}
+	}
+
 	return gui.handleImageSelect(gui.g, v)
 }
 
 func (gui *Gui) handleImagesNextContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(1) {
+		return nil
+	}
+
 	contexts := gui.getImageContexts()
 	if gui.State.Panels.Images.ContextIndex >= len(contexts)-1 {
 		gui.State.Panels.Images.ContextIndex = 0
@@ -183,6 +413,10 @@ func (gui *Gui) handleImagesNextContext(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleImagesPrevContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(-1) {
+		return nil
+	}
+
 	contexts := gui.getImageContexts()
 	if gui.State.Panels.Images.ContextIndex <= 0 {
 		gui.State.Panels.Images.ContextIndex = len(contexts) - 1
@@ -195,6 +429,33 @@ func (gui *Gui) handleImagesPrevContext(g *gocui.Gui, v *gocui.View) error {
 	return nil
 }
 
+func (gui *Gui) handleImagesToggleMarked(g *gocui.Gui, v *gocui.View) error {
+	image, err := gui.getSelectedImage()
+	if err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Images
+	panelState.Selection.toggle(image.UsageKey())
+	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Images), false)
+
+	if err := gui.renderImages(); err != nil {
+		return err
+	}
+	return gui.handleImageSelect(gui.g, v)
+}
+
+func (gui *Gui) handleImagesToggleRange(g *gocui.Gui, v *gocui.View) error {
+	if _, err := gui.getSelectedImage(); err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Images
+	panelState.Selection.toggleRange(gui.getImageIDs(), panelState.SelectedLine)
+
+	return gui.renderImages()
+}
+
 type removeImageOption struct {
 	description   string
 	command       string
@@ -208,12 +469,24 @@ func (r *removeImageOption) GetDisplayStrings(isFocused bool) []string {
 }
 
 func (gui *Gui) handleImagesRemoveMenu(g *gocui.Gui, v *gocui.View) error {
-	Image, err := gui.getSelectedImage()
-	if err != nil {
+	images := gui.getMarkedImages()
+	if len(images) == 0 {
 		return nil
 	}
 
-	shortSha := Image.ID[7:17]
+	// the daemon won't remove an image that a container is using, so rather than
+	// letting it fail we tell the user which containers are in the way
+	for _, image := range images {
+		if names := gui.DockerCommand.UsageIndex.ImageContainerNames(image.UsageKey()); len(names) > 0 {
+			return gui.createErrorPanel(gui.g, fmt.Sprintf(gui.Tr.ImageInUseError, image.Name+":"+image.Tag, strings.Join(names, ", ")))
+		}
+	}
+
+	shortShas := make([]string, len(images))
+	for i, image := range images {
+		shortShas[i] = image.ID[7:17]
+	}
+	shortSha := strings.Join(shortShas, " ")
 
 	options := []*removeImageOption{
 		{
@@ -239,18 +512,19 @@ func (gui *Gui) handleImagesRemoveMenu(g *gocui.Gui, v *gocui.View) error {
 			return nil
 		}
 		configOptions := options[index].configOptions
-		if cerr := Image.Remove(configOptions); cerr != nil {
-			return gui.createErrorPanel(gui.g, cerr.Error())
-		}
+		gui.State.Panels.Images.Selection.clear()
 
-		return gui.refreshImages()
+		remove := func(i int) error {
+			return images[i].Remove(configOptions)
+		}
+		return gui.runBatch(gui.Tr.RemovingStatus, len(images), remove, gui.refreshImages)
 	}
 
 	return gui.createMenu("", options, len(options), handleMenuPress)
 }
 
 func (gui *Gui) handlePruneImages() error {
-	return gui.createConfirmationPanel(gui.g, gui.getImagesView(), gui.Tr.Confirm, gui.Tr.ConfirmPruneImages, func(g *gocui.Gui, v *gocui.View) error {
+	return gui.createConfirmationPanel(gui.g, gui.getImagesView(), gui.Tr.Confirm, gui.withReclaimableSpace(gui.Tr.ConfirmPruneImages, (*commands.DiskUsage).ReclaimableImageBytes), func(g *gocui.Gui, v *gocui.View) error {
 		return gui.WithWaitingStatus(gui.Tr.PruningStatus, func() error {
 			err := gui.DockerCommand.PruneImages()
 			if err != nil {
@@ -261,19 +535,47 @@ func (gui *Gui) handlePruneImages() error {
 	}, nil)
 }
 
+func (gui *Gui) handleImagesPull(g *gocui.Gui, v *gocui.View) error {
+	return gui.createPromptPanel(g, v, gui.Tr.PullImagePrompt, func(g *gocui.Gui, promptView *gocui.View) error {
+		ref := gui.trimmedContent(promptView)
+		if ref == "" {
+			return nil
+		}
+
+		gui.Jobs.NewJob("pull "+ref, func(stop chan struct{}, out io.Writer) error {
+			if err := gui.DockerCommand.Pulls.Pull(ref, stop, out); err != nil {
+				return err
+			}
+			return gui.refreshImages()
+		})
+
+		// switching to the pulls tab so that we can see how it's going
+		for i, context := range gui.getImageContexts() {
+			if context == "pulls" {
+				gui.State.Panels.Images.ContextIndex = i
+			}
+		}
+		return gui.handleImageSelect(g, v)
+	})
+}
+
 func (gui *Gui) handleImagesCustomCommand(g *gocui.Gui, v *gocui.View) error {
-	image, err := gui.getSelectedImage()
-	if err != nil {
+	if _, err := gui.getSelectedImage(); err != nil {
 		return nil
 	}
 
-	commandObject := gui.DockerCommand.NewCommandObject(commands.CommandObject{
-		Image: image,
-	})
+	images := gui.getMarkedImages()
+	targets := make([]commandTarget, len(images))
+	for i, image := range images {
+		targets[i] = commandTarget{
+			name:          image.Endpoint.Qualify(image.Name + ":" + image.Tag),
+			commandObject: gui.DockerCommand.NewCommandObject(commands.CommandObject{Image: image}),
+		}
+	}
 
 	customCommands := gui.Config.UserConfig.CustomCommands.Images
 
-	return gui.createCustomCommandMenu(customCommands, commandObject)
+	return gui.createCustomCommandMenu(customCommands, targets)
 }
 
 func (gui *Gui) handleImagesBulkCommand(g *gocui.Gui, v *gocui.View) error {
@@ -0,0 +1,155 @@
+package gui
+
+import (
+	"fmt"
+	"runtime"
+	"strings"
+	"time"
+
+	"github.com/fatih/color"
+	"github.com/jesseduffield/lazydocker/pkg/metrics"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// internalsInterval is how often we refresh the internals tab. Reading the
+// runtime's memory stats briefly stops the world, so we don't do it too often
+const internalsInterval = time.Second
+
+// distributionBars are what we draw each bucket of a histogram with, from
+// empty to the fullest bucket
+var distributionBars = []rune(" ▁▂▃▄▅▆▇█")
+
+// internalsSample is what we need to remember from one refresh of the
+// internals tab to the next, to turn running totals into rates. It's zero
+// before the first refresh
+type internalsSample struct {
+	at     time.Time
+	frames int64
+	numGC  uint32
+}
+
+func (gui *Gui) renderInternals() error {
+	mainView := gui.getMainView()
+	mainView.Autoscroll = false
+	mainView.Wrap = false
+
+	previous := internalsSample{}
+	return gui.T.NewTickerTask(internalsInterval, nil, func(stop, notifyStopped chan struct{}) {
+		var output string
+		output, previous = gui.internalsString(previous)
+		gui.reRenderString(gui.g, "main", output)
+	})
+}
+
+// internalsString shows where lazydocker is spending its time: waiting on the
+// daemon, waiting on commands, refreshing its lists, or drawing
+func (gui *Gui) internalsString(previous internalsSample) (string, internalsSample) {
+	snapshot := gui.Metrics.Snapshot()
+	memStats := runtime.MemStats{}
+	runtime.ReadMemStats(&memStats)
+
+	current := internalsSample{at: time.Now(), frames: snapshot.Frames.Count, numGC: memStats.NumGC}
+
+	table := [][]string{gui.diskUsageHeader(
+		"", gui.Tr.CountColumn, gui.Tr.MeanColumn, "p50", "p90", "p99", gui.Tr.MaxColumn,
+		fmt.Sprintf("%s %s .. %s+", gui.Tr.DistributionColumn, metrics.BucketBound(0), metrics.BucketBound(len(snapshot.Frames.Buckets)-1).Round(100*time.Millisecond)),
+	)}
+	sections := []struct {
+		title      string
+		histograms []metrics.NamedHistogram
+	}{
+		{gui.Tr.DockerAPISection, snapshot.API},
+		{gui.Tr.CommandsSection, snapshot.Commands},
+		{gui.Tr.RefreshesSection, snapshot.Refreshes},
+		{gui.Tr.FramesSection, []metrics.NamedHistogram{{Name: gui.Tr.LayoutRow, HistogramSnapshot: snapshot.Frames}}},
+	}
+	for _, section := range sections {
+		table = append(table, []string{utils.ColoredString(section.title, color.FgYellow), "", "", "", "", "", "", ""})
+		for _, histogram := range section.histograms {
+			table = append(table, histogramRow(histogram))
+		}
+	}
+
+	histograms, err := utils.RenderTable(table)
+	if err != nil {
+		gui.Log.Error(err)
+	}
+
+	// rates need two samples to go off
+	frameRate, pauses := "-", "-"
+	if !previous.at.IsZero() {
+		frameRate = fmt.Sprintf("%.1f/s", float64(current.frames-previous.frames)/current.at.Sub(previous.at).Seconds())
+		pauses = gui.gcPauses(&memStats, previous.numGC)
+	}
+
+	gauges, err := utils.RenderTable([][]string{
+		{gui.Tr.FrameRateRow, frameRate},
+		{gui.Tr.UpdateQueueRow, fmt.Sprint(snapshot.PendingUpdates)},
+		{gui.Tr.StatsStreamsRow, fmt.Sprint(snapshot.StatsStreams)},
+		{gui.Tr.LogProcessesRow, fmt.Sprint(snapshot.LogProcesses)},
+		{gui.Tr.GoroutinesRow, fmt.Sprint(runtime.NumGoroutine())},
+		{gui.Tr.HeapRow, fmt.Sprintf("%s / %s", utils.FormatBinaryBytes(int(memStats.HeapAlloc)), utils.FormatBinaryBytes(int(memStats.HeapSys)))},
+		{gui.Tr.GCPausesRow, pauses},
+	})
+	if err != nil {
+		gui.Log.Error(err)
+	}
+
+	return histograms + "\n\n" + gauges, current
+}
+
+func histogramRow(histogram metrics.NamedHistogram) []string {
+	return []string{
+		"  " + histogram.Name,
+		fmt.Sprint(histogram.Count),
+		utils.FormatMilliseconds(histogram.Mean()),
+		utils.FormatMilliseconds(histogram.Quantile(0.5)),
+		utils.FormatMilliseconds(histogram.Quantile(0.9)),
+		utils.FormatMilliseconds(histogram.Quantile(0.99)),
+		utils.FormatMilliseconds(histogram.Max),
+		distribution(histogram.Buckets[:]),
+	}
+}
+
+// distribution draws a histogram's buckets as a row of bars, scaled so that
+// the fullest bucket is a full bar
+func distribution(buckets []int64) string {
+	fullest := int64(0)
+	for _, count := range buckets {
+		if count > fullest {
+			fullest = count
+		}
+	}
+
+	var builder strings.Builder
+	for _, count := range buckets {
+		bar := 0
+		if count > 0 {
+			// anything at all gets at least the smallest bar, so that a single
+			// slow call still shows up next to thousands of fast ones
+			bar = 1 + int(count*int64(len(distributionBars)-2)/fullest)
+		}
+		builder.WriteRune(distributionBars[bar])
+	}
+	return builder.String()
+}
+
+// gcPauses shows how many collections there have been since we last looked,
+// the longest pause among them, and how long we've been paused for in total
+func (gui *Gui) gcPauses(memStats *runtime.MemStats, previousNumGC uint32) string {
+	recent := memStats.NumGC - previousNumGC
+	// the runtime only remembers the last 256 pauses
+	if recent > uint32(len(memStats.PauseNs)) {
+		recent = uint32(len(memStats.PauseNs))
+	}
+
+	longest := time.Duration(0)
+	for i := uint32(0); i < recent; i++ {
+		pause := time.Duration(memStats.PauseNs[(memStats.NumGC-i+255)%256])
+		if pause > longest {
+			longest = pause
+		}
+	}
+
+	return fmt.Sprintf(gui.Tr.GCPauses, recent, utils.FormatMilliseconds(longest), utils.FormatMilliseconds(time.Duration(memStats.PauseTotalNs)))
+}
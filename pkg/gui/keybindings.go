@@ -53,6 +53,8 @@ func (b *Binding) GetKey() string {
 		return "PgUp"
 	case 65507:
 		return "PgDn"
+	case 17:
+		return "ctrl+q"
 	}
 
 	return fmt.Sprintf("%c", key)
@@ -141,6 +143,13 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 			Handler:     gui.handleOpenConfig,
 			Description: gui.Tr.OpenConfig,
 		},
+		{
+			ViewName:    "project",
+			Key:         'P',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleCaptureProfile,
+			Description: gui.Tr.CaptureProfile,
+		},
 		{
 			ViewName:    "project",
 			Key:         '[',
@@ -168,6 +177,13 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 			Handler:     gui.handleViewAllLogs,
 			Description: gui.Tr.ViewLogs,
 		},
+		{
+			ViewName:    "project",
+			Key:         'z',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleCancelJob,
+			Description: gui.Tr.CancelJob,
+		},
 		{
 			ViewName: "project",
 			Key:      gocui.MouseLeft,
@@ -276,6 +292,27 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 			Handler:     gui.handleContainersOpenInBrowserCommand,
 			Description: gui.Tr.OpenInBrowser,
 		},
+		{
+			ViewName:    "containers",
+			Key:         'o',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleContainersSortMenu,
+			Description: gui.Tr.SortContainers,
+		},
+		{
+			ViewName:    "containers",
+			Key:         'g',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleContainersToggleGrouped,
+			Description: gui.Tr.GroupContainers,
+		},
+		{
+			ViewName:    "containers",
+			Key:         gocui.KeyEnter,
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleContainersEnter,
+			Description: gui.Tr.FocusMainOrToggleGroup,
+		},
 		{
 			ViewName:    "services",
 			Key:         'd',
@@ -374,6 +411,13 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 			Handler:     gui.handleImagesRemoveMenu,
 			Description: gui.Tr.RemoveImage,
 		},
+		{
+			ViewName:    "images",
+			Key:         'p',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleImagesPull,
+			Description: gui.Tr.PullImage,
+		},
 		{
 			ViewName:    "images",
 			Key:         'b',
@@ -381,6 +425,13 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 			Handler:     gui.handleImagesBulkCommand,
 			Description: gui.Tr.ViewBulkCommands,
 		},
+		{
+			ViewName:    "images",
+			Key:         'o',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleImagesSortMenu,
+			Description: gui.Tr.SortImages,
+		},
 		{
 			ViewName:    "volumes",
 			Key:         '[',
@@ -508,7 +559,35 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 		}...)
 	}
 
-	for _, viewName := range []string{"project", "services", "containers", "images", "volumes"} {
+	markableMap := map[string]struct {
+		onToggleMarked func(*gocui.Gui, *gocui.View) error
+		onToggleRange  func(*gocui.Gui, *gocui.View) error
+	}{
+		"containers": {onToggleMarked: gui.handleContainersToggleMarked, onToggleRange: gui.handleContainersToggleRange},
+		"images":     {onToggleMarked: gui.handleImagesToggleMarked, onToggleRange: gui.handleImagesToggleRange},
+		"volumes":    {onToggleMarked: gui.handleVolumesToggleMarked, onToggleRange: gui.handleVolumesToggleRange},
+	}
+
+	for _, viewName := range []string{"containers", "images", "volumes"} {
+		functions := markableMap[viewName]
+		bindings = append(bindings, []*Binding{
+			{ViewName: viewName, Key: gocui.KeySpace, Modifier: gocui.ModNone, Handler: functions.onToggleMarked, Description: gui.Tr.ToggleMarked},
+			{ViewName: viewName, Key: 'v', Modifier: gocui.ModNone, Handler: functions.onToggleRange, Description: gui.Tr.ToggleRangeSelect},
+		}...)
+	}
+
+	for _, viewName := range []string{"services", "containers", "images", "volumes"} {
+		bindings = append(bindings, &Binding{
+			ViewName:    viewName,
+			Key:         '/',
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleOpenListFilter,
+			Description: gui.Tr.FilterList,
+		})
+	}
+
+	// the containers panel has its own enter binding for expanding groups
+	for _, viewName := range []string{"project", "services", "images", "volumes"} {
 		bindings = append(bindings, &Binding{
 			ViewName:    viewName,
 			Key:         gocui.KeyEnter,
@@ -518,6 +597,31 @@ func (gui *Gui) GetInitialKeybindings() []*Binding {
 		})
 	}
 
+	// the terminal view is editable, so gocui skips global bindings on runes
+	// when it's focused, but not the ones on special keys like esc. We shadow
+	// those so that the process in the terminal gets the keypress instead
+	for _, binding := range bindings {
+		if key, ok := binding.Key.(gocui.Key); ok && binding.ViewName == "" {
+			bindings = append(bindings, &Binding{ViewName: "terminal", Key: key, Modifier: binding.Modifier, Handler: gui.terminalPassthrough(key)})
+		}
+	}
+
+	bindings = append(bindings, []*Binding{
+		{
+			ViewName:    "terminal",
+			Key:         gocui.KeyCtrlQ,
+			Modifier:    gocui.ModNone,
+			Handler:     gui.handleTerminalDetach,
+			Description: gui.Tr.DetachTerminal,
+		},
+		{
+			ViewName: "terminal",
+			Key:      gocui.MouseLeft,
+			Modifier: gocui.ModNone,
+			Handler:  gui.handleTerminalClick,
+		},
+	}...)
+
 	return bindings
 }
 
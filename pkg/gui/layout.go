@@ -1,6 +1,8 @@
 package gui
 
 import (
+	"time"
+
 	"github.com/fatih/color"
 	"github.com/jesseduffield/gocui"
 	"github.com/jesseduffield/lazydocker/pkg/utils"
@@ -31,7 +33,7 @@ func (gui *Gui) getFocusLayout() func(g *gocui.Gui) error {
 func (gui *Gui) onFocusChange() error {
 	currentView := gui.g.CurrentView()
 	for _, view := range gui.g.Views() {
-		view.Highlight = view == currentView && view.Name() != "main"
+		view.Highlight = view == currentView && view.Name() != "main" && view.Name() != "terminal"
 	}
 	return nil
 }
@@ -69,6 +71,13 @@ func (gui *Gui) onFocus(v *gocui.View) error {
 
 // layout is called for every screen re-render e.g. when the screen is resized
 func (gui *Gui) layout(g *gocui.Gui) error {
+	gui.Bench.Frame()
+	if gui.Metrics != nil {
+		start := time.Now()
+		defer func() { gui.Metrics.ObserveFrame(time.Since(start)) }()
+	}
+	span := gui.Tracer.Start("render", "layout")
+	defer span.End()
 	g.Highlight = true
 	width, height := g.Size()
 
@@ -176,6 +185,10 @@ func (gui *Gui) layout(g *gocui.Gui) error {
 		v.IgnoreCarriageReturns = true
 	}
 
+	if err := gui.layoutTerminal(g, leftSideWidth+1, 0, width-1, height-2); err != nil {
+		return err
+	}
+
 	if v, err := g.SetView("project", 0, 0, leftSideWidth, vHeights["project"]-1, gocui.BOTTOM|gocui.RIGHT); err != nil {
 		if err.Error() != "unknown view" {
 			return err
@@ -305,7 +318,7 @@ func (gui *Gui) focusPointInView(view *gocui.View) error {
 	}
 
 	listViews := map[string]listViewState{
-		"containers": {selectedLine: gui.State.Panels.Containers.SelectedLine, lineCount: len(gui.DockerCommand.DisplayContainers)},
+		"containers": {selectedLine: gui.State.Panels.Containers.SelectedLine, lineCount: gui.getContainerRowCount()},
 		"images":     {selectedLine: gui.State.Panels.Images.SelectedLine, lineCount: len(gui.DockerCommand.Images)},
 		"volumes":    {selectedLine: gui.State.Panels.Volumes.SelectedLine, lineCount: len(gui.DockerCommand.Volumes)},
 		"services":   {selectedLine: gui.State.Panels.Services.SelectedLine, lineCount: len(gui.DockerCommand.Services)},
@@ -0,0 +1,76 @@
+package gui
+
+import (
+	"github.com/jesseduffield/gocui"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// listOverscan is how many rows either side of the visible ones we render in a
+// list panel, so that moving the cursor around doesn't mean rendering the list
+// again until it's gone a fair way
+const listOverscan = 50
+
+// listWindow is the range of a list panel's items that are actually written to
+// its view: line i of the view's buffer is item start+i. With thousands of
+// containers we'd otherwise be holding every one of them in the view's buffer
+// and re-rendering them all on each refresh
+type listWindow struct {
+	start int
+	end   int
+}
+
+// newListWindow returns the window to render so that the rows from origin to
+// origin+height are covered, plus the overscan either side
+func newListWindow(origin int, height int, itemCount int) *listWindow {
+	end := utils.Min(origin+height+listOverscan, itemCount)
+	start := utils.Min(utils.Max(origin-listOverscan, 0), end)
+	return &listWindow{start: start, end: end}
+}
+
+// covers tells us whether the rows from origin to origin+height have been
+// rendered
+func (w *listWindow) covers(origin int, height int, itemCount int) bool {
+	return origin >= w.start && utils.Min(origin+height, itemCount) <= w.end
+}
+
+// listWindowOffset returns the index of the item on the first line of the
+// view's buffer, which is zero for views that render all of their items
+func (gui *Gui) listWindowOffset(v *gocui.View) int {
+	if window, ok := gui.State.ListWindows[v.Name()]; ok {
+		return window.start
+	}
+	return 0
+}
+
+// updateListWindow works out which of the view's items need rendering, given
+// where the view has scrolled to, and moves the view's origin to match the
+// buffer we're about to write. It must be called just before writing the
+// window's items to the view
+func (gui *Gui) updateListWindow(v *gocui.View, itemCount int) *listWindow {
+	ox, oy := v.Origin()
+	_, height := v.Size()
+
+	origin := gui.listWindowOffset(v) + oy
+	origin = utils.Max(utils.Min(origin, itemCount-height), 0)
+
+	window := newListWindow(origin, height, itemCount)
+	gui.State.ListWindows[v.Name()] = window
+	_ = v.SetOrigin(ox, origin-window.start)
+	return window
+}
+
+// renderListWindow renders the given list view again, which we need to do when
+// its origin has moved outside of the rows we've rendered
+func (gui *Gui) renderListWindow(viewName string) error {
+	switch viewName {
+	case "containers":
+		return gui.renderContainers()
+	case "images":
+		return gui.renderImages()
+	case "volumes":
+		return gui.renderVolumes()
+	case "services":
+		return gui.renderServices()
+	}
+	return nil
+}
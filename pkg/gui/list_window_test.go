@@ -0,0 +1,124 @@
+package gui
+
+import (
+	"testing"
+
+	"github.com/jesseduffield/gocui"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestNewListWindow is a function.
+func TestNewListWindow(t *testing.T) {
+	type scenario struct {
+		testName  string
+		origin    int
+		height    int
+		itemCount int
+		expected  listWindow
+	}
+
+	scenarios := []scenario{
+		{
+			"a short list is rendered whole",
+			0,
+			20,
+			10,
+			listWindow{0, 10},
+		},
+		{
+			"at the top there's nothing to overscan above",
+			0,
+			20,
+			1000,
+			listWindow{0, 20 + listOverscan},
+		},
+		{
+			"in the middle we overscan either side",
+			500,
+			20,
+			1000,
+			listWindow{500 - listOverscan, 520 + listOverscan},
+		},
+		{
+			"at the bottom there's nothing to overscan below",
+			980,
+			20,
+			1000,
+			listWindow{980 - listOverscan, 1000},
+		},
+		{
+			"the list has shrunk below the origin",
+			500,
+			20,
+			100,
+			listWindow{100, 100},
+		},
+		{
+			"the list is empty",
+			0,
+			20,
+			0,
+			listWindow{0, 0},
+		},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.testName, func(t *testing.T) {
+			assert.EqualValues(t, &s.expected, newListWindow(s.origin, s.height, s.itemCount))
+		})
+	}
+}
+
+// TestListWindowCovers is a function.
+func TestListWindowCovers(t *testing.T) {
+	window := newListWindow(500, 20, 1000)
+
+	type scenario struct {
+		testName  string
+		origin    int
+		height    int
+		itemCount int
+		expected  bool
+	}
+
+	scenarios := []scenario{
+		{"where we rendered it for", 500, 20, 1000, true},
+		{"scrolled up to the first rendered row", window.start, 20, 1000, true},
+		{"scrolled up past the first rendered row", window.start - 1, 20, 1000, false},
+		{"scrolled down to the last rendered row", window.end - 20, 20, 1000, true},
+		{"scrolled down past the last rendered row", window.end - 19, 20, 1000, false},
+		{"the list has shrunk to end within the window", window.end - 10, 20, window.end - 5, true},
+		{"the list has shrunk below the window", 90, 20, 100, false},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.testName, func(t *testing.T) {
+			assert.EqualValues(t, s.expected, window.covers(s.origin, s.height, s.itemCount))
+		})
+	}
+}
+
+// TestUpdateListWindowShrunk is a function.
+func TestUpdateListWindowShrunk(t *testing.T) {
+	gui := &Gui{}
+	gui.State.ListWindows = map[string]*listWindow{}
+	v := benchmarkView()
+	_, height := v.Size()
+
+	// we'd scrolled a long way down a long list
+	window := gui.updateListWindow(v, 1000)
+	assert.NoError(t, v.SetOrigin(0, 600-window.start))
+	window = gui.updateListWindow(v, 1000)
+	assert.EqualValues(t, 600, gui.listWindowOffset(v)+viewOriginY(v))
+	assert.True(t, window.covers(600, height, 1000))
+
+	// and then most of it went away, so we show the end of what's left
+	window = gui.updateListWindow(v, 100)
+	assert.EqualValues(t, 100-height, gui.listWindowOffset(v)+viewOriginY(v))
+	assert.True(t, window.covers(100-height, height, 100))
+}
+
+func viewOriginY(v *gocui.View) int {
+	_, y := v.Origin()
+	return y
+}
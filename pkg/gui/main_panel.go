@@ -69,6 +69,13 @@ func (gui *Gui) autoScrollMain(g *gocui.Gui, v *gocui.View) error {
 func (gui *Gui) onMainTabClick(tabIndex int) error {
 	gui.Log.Warn(tabIndex)
 
+	// if we're streaming a custom command, the tabs are its targets
+	if stream := gui.State.Panels.Main.Stream; stream != nil {
+		stream.TabIndex = tabIndex
+		gui.renderStream(stream)
+		return nil
+	}
+
 	viewName := gui.currentViewName()
 
 	mainView := gui.getMainView()
@@ -98,6 +105,11 @@ func (gui *Gui) onMainTabClick(tabIndex int) error {
 }
 
 func (gui *Gui) handleEnterMain(g *gocui.Gui, v *gocui.View) error {
+	// if we've got a terminal open, that's what's covering the main panel
+	if terminalView, err := gui.g.View("terminal"); err == nil {
+		return gui.switchFocus(gui.g, v, terminalView, false)
+	}
+
 	mainView := gui.getMainView()
 	mainView.ParentView = v
 
@@ -103,7 +103,7 @@ func (gui *Gui) createMenu(title string, items interface{}, itemCount int, handl
 		}
 	}
 
-	gui.g.Update(func(g *gocui.Gui) error {
+	gui.update(func(g *gocui.Gui) error {
 		if _, err := gui.g.View("menu"); err == nil {
 			if _, err := g.SetViewOnTop("menu"); err != nil {
 				return err
@@ -5,27 +5,39 @@ import (
 	"fmt"
 	"path"
 	"strings"
+	"time"
 
 	"github.com/fatih/color"
 	"github.com/go-errors/errors"
 	"github.com/jesseduffield/gocui"
 	"github.com/jesseduffield/lazydocker/pkg/commands"
+	"github.com/jesseduffield/lazydocker/pkg/profiling"
+	"github.com/jesseduffield/lazydocker/pkg/tasks"
 	"github.com/jesseduffield/lazydocker/pkg/utils"
 	"github.com/jesseduffield/yaml"
 )
 
 func (gui *Gui) getProjectContexts() []string {
+	contexts := []string{"credits", "jobs", "disk usage", "connections"}
 	if gui.DockerCommand.InDockerComposeProject {
-		return []string{"logs", "config", "credits"}
+		contexts = []string{"logs", "config", "jobs", "disk usage", "connections", "credits"}
 	}
-	return []string{"credits"}
+	// the internals tab is only there if it's been switched on in the config
+	if gui.Metrics != nil {
+		contexts = append(contexts, "internals")
+	}
+	return contexts
 }
 
 func (gui *Gui) getProjectContextTitles() []string {
+	titles := []string{gui.Tr.CreditsTitle, gui.Tr.JobsTitle, gui.Tr.DiskUsageTitle, gui.Tr.ConnectionsTitle}
 	if gui.DockerCommand.InDockerComposeProject {
-		return []string{gui.Tr.LogsTitle, gui.Tr.DockerComposeConfigTitle, gui.Tr.CreditsTitle}
+		titles = []string{gui.Tr.LogsTitle, gui.Tr.DockerComposeConfigTitle, gui.Tr.JobsTitle, gui.Tr.DiskUsageTitle, gui.Tr.ConnectionsTitle, gui.Tr.CreditsTitle}
+	}
+	if gui.Metrics != nil {
+		titles = append(titles, gui.Tr.InternalsTitle)
 	}
-	return []string{gui.Tr.CreditsTitle}
+	return titles
 }
 
 func (gui *Gui) refreshProject() error {
@@ -41,7 +53,27 @@ func (gui *Gui) refreshProject() error {
 		}
 	}
 
-	gui.g.Update(func(*gocui.Gui) error {
+	if activeJobs := gui.Jobs.ActiveCount(); activeJobs > 0 {
+		projectName += utils.ColoredString(fmt.Sprintf(" (%d %s)", activeJobs, gui.Tr.JobsTitle), color.FgYellow)
+	}
+
+	// in remote mode we keep showing the last lists we got while we wait on the
+	// daemon, so we say so if we haven't heard back in a while
+	if gui.DockerCommand.RemoteMode {
+		if staleness := gui.DockerCommand.Staleness(gui.Config.UserConfig.Update.DockerRefreshInterval); staleness > 0 {
+			projectName += utils.ColoredString(" "+fmt.Sprintf(gui.Tr.Stale, staleness.Round(time.Second)), color.FgYellow)
+		}
+	}
+
+	// with several daemons we show whether each of them is reachable and how
+	// quickly it answered our last request
+	if endpoints := gui.DockerCommand.Endpoints; len(endpoints) > 1 {
+		for _, endpoint := range endpoints {
+			projectName += "  " + endpoint.GetDisplayString()
+		}
+	}
+
+	gui.update(func(*gocui.Gui) error {
 		v.Clear()
 		fmt.Fprint(v, projectName)
 		return nil
@@ -91,6 +123,22 @@ func (gui *Gui) handleProjectSelect(g *gocui.Gui, v *gocui.View) error {
 		if err := gui.renderDockerComposeConfig(); err != nil {
 			return err
 		}
+	case "jobs":
+		if err := gui.renderJobs(); err != nil {
+			return err
+		}
+	case "disk usage":
+		if err := gui.renderDiskUsage(); err != nil {
+			return err
+		}
+	case "connections":
+		if err := gui.renderConnections(); err != nil {
+			return err
+		}
+	case "internals":
+		if err := gui.renderInternals(); err != nil {
+			return err
+		}
 	default:
 		return errors.New("Unknown context for status panel")
 	}
@@ -143,6 +191,7 @@ func (gui *Gui) renderAllLogs() error {
 
 		gui.OSCommand.PrepareForChildren(cmd)
 		cmd.Start()
+		logProcessDone := gui.Metrics.StartLogProcess()
 
 		go func() {
 			<-stop
@@ -152,6 +201,7 @@ func (gui *Gui) renderAllLogs() error {
 		}()
 
 		cmd.Wait()
+		logProcessDone()
 	})
 }
 
@@ -166,6 +216,246 @@ func (gui *Gui) renderDockerComposeConfig() error {
 	})
 }
 
+func (gui *Gui) renderJobs() error {
+	mainView := gui.getMainView()
+	mainView.Autoscroll = true
+	mainView.Wrap = gui.Config.UserConfig.Gui.WrapMainPanel
+
+	lastVersion := -1
+	return gui.T.NewTickerTask(time.Millisecond*500, nil, func(stop, notifyStopped chan struct{}) {
+		// we only need to re-render if something has changed, or if a job is
+		// running, in which case its duration will have changed
+		version := gui.Jobs.Version()
+		if version == lastVersion && gui.Jobs.ActiveCount() == 0 {
+			return
+		}
+		lastVersion = version
+
+		gui.reRenderString(gui.g, "main", gui.jobsString())
+	})
+}
+
+// jobsString lists every job we know about, followed by the output of any
+// jobs that are still going, and of the job that finished most recently
+func (gui *Gui) jobsString() string {
+	jobs := gui.Jobs.Jobs()
+	if len(jobs) == 0 {
+		return gui.Tr.NoJobs
+	}
+
+	rows := make([][]string, len(jobs))
+	latestFinished := -1
+	for i, job := range jobs {
+		rows[i] = []string{
+			utils.ColoredString(string(job.Status), jobStatusColor(job.Status)),
+			job.Name,
+			job.Duration().Round(time.Second).String(),
+		}
+		if job.Status != tasks.JobQueued && job.Status != tasks.JobRunning {
+			latestFinished = i
+		}
+	}
+
+	output, err := utils.RenderTable(rows)
+	if err != nil {
+		gui.Log.Error(err)
+	}
+
+	for i, job := range jobs {
+		if job.Status == tasks.JobQueued || (job.Status != tasks.JobRunning && i != latestFinished) {
+			continue
+		}
+		output += "\n\n" + utils.ColoredString(job.Name, color.FgCyan) + "\n" + job.Output()
+		if job.Err != nil && job.Status == tasks.JobFailed {
+			output += "\n" + utils.ColoredString(job.Err.Error(), color.FgRed)
+		}
+	}
+
+	return output
+}
+
+func jobStatusColor(status tasks.JobStatus) color.Attribute {
+	switch status {
+	case tasks.JobRunning:
+		return color.FgGreen
+	case tasks.JobSucceeded:
+		return color.FgBlue
+	case tasks.JobFailed:
+		return color.FgRed
+	default:
+		return color.FgYellow
+	}
+}
+
+func (gui *Gui) renderDiskUsage() error {
+	mainView := gui.getMainView()
+	mainView.Autoscroll = false
+	mainView.Wrap = gui.Config.UserConfig.Gui.WrapMainPanel
+
+	// the disk usage is worked out in the background, so we just re-render
+	// whenever we've got a new one
+	lastVersion := -1
+	return gui.T.NewTickerTask(time.Millisecond*500, nil, func(stop, notifyStopped chan struct{}) {
+		version := gui.DockerCommand.DiskUsage.Version()
+		if version == lastVersion {
+			return
+		}
+		lastVersion = version
+
+		gui.reRenderString(gui.g, "main", gui.diskUsageString())
+	})
+}
+
+// diskUsageString shows the totals for images, containers, volumes and the
+// build cache, followed by a breakdown of each
+func (gui *Gui) diskUsageString() string {
+	usage, err := gui.DockerCommand.DiskUsage.Get()
+	if usage == nil {
+		if err != nil {
+			return utils.ColoredString(err.Error(), color.FgRed)
+		}
+		return gui.Tr.ComputingDiskUsage
+	}
+
+	summary := [][]string{
+		{gui.Tr.ImagesTitle, formatDiskSize(usage.LayersSize), fmt.Sprintf(gui.Tr.Reclaimable, formatDiskSize(usage.ReclaimableImageBytes()))},
+		{gui.Tr.ContainersTitle, formatDiskSize(usage.ContainersSize()), ""},
+		{gui.Tr.VolumesTitle, formatDiskSize(usage.VolumesSize()), fmt.Sprintf(gui.Tr.Reclaimable, formatDiskSize(usage.ReclaimableVolumeBytes()))},
+		{gui.Tr.BuildCacheTitle, formatDiskSize(usage.BuildCacheSize), ""},
+	}
+
+	images := [][]string{gui.diskUsageHeader(gui.Tr.NameColumn, gui.Tr.SizeColumn, gui.Tr.SharedSizeColumn, gui.Tr.UniqueSizeColumn, gui.Tr.ContainersColumn)}
+	for _, image := range usage.Images {
+		images = append(images, []string{image.Name, formatDiskSize(image.Size), formatDiskSize(image.SharedSize), formatDiskSize(image.UniqueSize), fmt.Sprint(image.Containers)})
+	}
+
+	containers := [][]string{gui.diskUsageHeader(gui.Tr.NameColumn, gui.Tr.ImageColumn, gui.Tr.SizeColumn)}
+	for _, container := range usage.Containers {
+		containers = append(containers, []string{container.Name, container.Image, formatDiskSize(container.SizeRw)})
+	}
+
+	volumes := [][]string{gui.diskUsageHeader(gui.Tr.NameColumn, gui.Tr.SizeColumn, gui.Tr.ContainersColumn)}
+	for _, volume := range usage.Volumes {
+		refCount := "-"
+		if volume.RefCount >= 0 {
+			refCount = fmt.Sprint(volume.RefCount)
+		}
+		volumes = append(volumes, []string{volume.Name, formatDiskSize(volume.Size), refCount})
+	}
+
+	sections := []string{}
+	for _, table := range [][][]string{summary, images, containers, volumes} {
+		output, renderErr := utils.RenderTable(table)
+		if renderErr != nil {
+			gui.Log.Error(renderErr)
+		}
+		sections = append(sections, output)
+	}
+
+	// if our last attempt failed we still show the previous result, but we let
+	// the user know it might be out of date
+	if err != nil {
+		sections = append(sections, utils.ColoredString(err.Error(), color.FgRed))
+	}
+
+	return strings.Join(sections, "\n\n")
+}
+
+func (gui *Gui) renderConnections() error {
+	mainView := gui.getMainView()
+	mainView.Autoscroll = false
+	mainView.Wrap = false
+
+	return gui.T.NewTickerTask(time.Second, nil, func(stop, notifyStopped chan struct{}) {
+		gui.reRenderString(gui.g, "main", gui.connectionsString())
+	})
+}
+
+// connectionsString shows how each endpoint's request and stream connection
+// pools are being used, so that we can tell whether requests are being made
+// on fresh sockets or waiting for one
+func (gui *Gui) connectionsString() string {
+	table := [][]string{gui.diskUsageHeader(
+		gui.Tr.EndpointColumn, gui.Tr.PoolColumn, gui.Tr.OpenSocketsColumn, gui.Tr.DialsColumn,
+		gui.Tr.DialErrorsColumn, gui.Tr.RequestsColumn, gui.Tr.ReusedColumn, gui.Tr.ConnectionWaitColumn,
+		gui.Tr.BytesReadColumn, gui.Tr.BytesWrittenColumn,
+	)}
+
+	for _, endpoint := range gui.DockerCommand.Endpoints {
+		name := endpoint.Name
+		if name == "" {
+			name = endpoint.Client.DaemonHost()
+		}
+		requests, streams := endpoint.PoolStats()
+		table = append(table, poolStatsRow(name, gui.Tr.RequestPool, requests), poolStatsRow("", gui.Tr.StreamPool, streams))
+	}
+
+	output, err := utils.RenderTable(table)
+	if err != nil {
+		gui.Log.Error(err)
+	}
+	return output
+}
+
+func poolStatsRow(endpoint string, pool string, stats commands.PoolStats) []string {
+	reused := "-"
+	wait := "-"
+	if stats.Requests > 0 {
+		reused = fmt.Sprintf("%d%%", stats.Reused*100/stats.Requests)
+		wait = (stats.ConnectionWait / time.Duration(stats.Requests)).Round(time.Microsecond).String()
+	}
+	dialErrors := fmt.Sprint(stats.DialErrors)
+	if stats.DialErrors > 0 {
+		dialErrors = utils.ColoredString(dialErrors, color.FgRed)
+	}
+	return []string{
+		endpoint,
+		pool,
+		fmt.Sprint(stats.OpenSockets),
+		fmt.Sprint(stats.Dials),
+		dialErrors,
+		fmt.Sprint(stats.Requests),
+		reused,
+		wait,
+		utils.FormatDecimalBytes(int(stats.BytesRead)),
+		utils.FormatDecimalBytes(int(stats.BytesWritten)),
+	}
+}
+
+func (gui *Gui) diskUsageHeader(columns ...string) []string {
+	header := make([]string, len(columns))
+	for i, column := range columns {
+		header[i] = utils.ColoredString(column, color.FgCyan)
+	}
+	return header
+}
+
+// formatDiskSize formats a size the way `docker system df` does. The daemon
+// gives us -1 for sizes it couldn't work out
+func formatDiskSize(size int64) string {
+	if size < 0 {
+		return "-"
+	}
+	return utils.FormatDecimalBytes(int(size))
+}
+
+// withReclaimableSpace adds how much space a prune would free up to its
+// confirmation message, if we've worked out the disk usage by now
+func (gui *Gui) withReclaimableSpace(message string, reclaimable func(*commands.DiskUsage) int64) string {
+	usage, _ := gui.DockerCommand.DiskUsage.Get()
+	if usage == nil {
+		return message
+	}
+	return message + "\n\n" + fmt.Sprintf(gui.Tr.ReclaimableSpace, formatDiskSize(reclaimable(usage)))
+}
+
+func (gui *Gui) handleCancelJob(g *gocui.Gui, v *gocui.View) error {
+	if !gui.Jobs.CancelLatest() {
+		return gui.createErrorPanel(gui.g, gui.Tr.NoRunningJobs)
+	}
+	return nil
+}
+
 func (gui *Gui) handleOpenConfig(g *gocui.Gui, v *gocui.View) error {
 	return gui.openFile(gui.Config.ConfigFilename())
 }
@@ -174,6 +464,22 @@ func (gui *Gui) handleEditConfig(g *gocui.Gui, v *gocui.View) error {
 	return gui.editFile(gui.Config.ConfigFilename())
 }
 
+// profileCaptureDuration is long enough to catch a few refreshes and a burst of
+// logs, and short enough that someone will wait for it
+const profileCaptureDuration = 10 * time.Second
+
+// handleCaptureProfile records a CPU profile and trace into the config
+// directory, for someone to attach to an issue when lazydocker is misbehaving
+func (gui *Gui) handleCaptureProfile(g *gocui.Gui, v *gocui.View) error {
+	return gui.WithWaitingStatus(gui.Tr.CapturingProfileStatus, func() error {
+		cpuPath, tracePath, err := profiling.Capture(gui.Config.ConfigDir, profileCaptureDuration)
+		if err != nil {
+			return err
+		}
+		return gui.createConfirmationPanel(gui.g, v, gui.Tr.ProfileCapturedTitle, fmt.Sprintf(gui.Tr.ProfileCaptured, cpuPath, tracePath), nil, nil)
+	})
+}
+
 func lazydockerTitle() string {
 	return `
    _                     _            _
@@ -0,0 +1,124 @@
+package gui
+
+import (
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// listSelection keeps track of the items a user has marked in a list panel so
+// that an action can be applied to all of them at once. Items are keyed by
+// their ID rather than their index so that marks survive the list being
+// re-ordered on refresh.
+type listSelection struct {
+	marked map[string]bool
+
+	// rangeStart is the index at which a range selection was started, or -1
+	// if we're not currently selecting a range
+	rangeStart int
+}
+
+func newListSelection() *listSelection {
+	return &listSelection{marked: map[string]bool{}, rangeStart: -1}
+}
+
+func (s *listSelection) isEmpty() bool {
+	return len(s.marked) == 0 && s.rangeStart == -1
+}
+
+func (s *listSelection) clear() {
+	s.marked = map[string]bool{}
+	s.rangeStart = -1
+}
+
+func (s *listSelection) toggle(id string) {
+	if s.marked[id] {
+		delete(s.marked, id)
+	} else {
+		s.marked[id] = true
+	}
+}
+
+// toggleRange starts a range selection at selectedLine, or, if a range is
+// already being selected, marks every item between the start of the range and
+// selectedLine
+func (s *listSelection) toggleRange(ids []string, selectedLine int) {
+	if s.rangeStart == -1 {
+		s.rangeStart = selectedLine
+		return
+	}
+
+	start, end := s.rangeStart, selectedLine
+	if start > end {
+		start, end = end, start
+	}
+	for i := start; i <= end && i < len(ids); i++ {
+		s.marked[ids[i]] = true
+	}
+	s.rangeStart = -1
+}
+
+// isMarked tells us whether the item at the given index is marked, either
+// explicitly or because it lies within the range currently being selected
+func (s *listSelection) isMarked(id string, index int, selectedLine int) bool {
+	if s.marked[id] {
+		return true
+	}
+	if s.rangeStart == -1 {
+		return false
+	}
+	return (s.rangeStart <= index && index <= selectedLine) || (selectedLine <= index && index <= s.rangeStart)
+}
+
+// markedIndices returns the indices of the marked items, or just the selected
+// line if nothing is marked. Items which no longer exist are forgotten.
+func (s *listSelection) markedIndices(ids []string, selectedLine int) []int {
+	indices := []int{}
+	present := map[string]bool{}
+	for i, id := range ids {
+		present[id] = true
+		if s.isMarked(id, i, selectedLine) {
+			indices = append(indices, i)
+		}
+	}
+	for id := range s.marked {
+		if !present[id] {
+			delete(s.marked, id)
+		}
+	}
+
+	if len(indices) == 0 && selectedLine >= 0 && selectedLine < len(ids) {
+		indices = append(indices, selectedLine)
+	}
+	return indices
+}
+
+// renderOption returns the list rendering option which shows our marks, or
+// nothing if no item is marked, so that unmarked lists render as they always have.
+// offset is the index of the first item being rendered
+func (s *listSelection) renderOption(ids []string, selectedLine int, offset int) func(*utils.RenderListConfig) {
+	if s.isEmpty() {
+		return func(*utils.RenderListConfig) {}
+	}
+	return utils.WithMarkedLines(func(i int) bool {
+		return s.isMarked(ids[offset+i], offset+i, selectedLine)
+	})
+}
+
+// runBatch calls f for each of count items concurrently under a single waiting
+// status, then refreshes once all of them are done. Any errors are shown together
+// in a single error panel. refresh may be nil.
+func (gui *Gui) runBatch(status string, count int, f func(int) error, refresh func() error) error {
+	return gui.WithWaitingStatus(status, func() error {
+		err := utils.ForEachConcurrently(count, gui.Config.UserConfig.Gui.BatchConcurrency, f)
+
+		if refresh != nil {
+			if refreshErr := refresh(); refreshErr != nil {
+				return refreshErr
+			}
+		}
+
+		if err != nil {
+			return gui.createErrorPanel(gui.g, err.Error())
+		}
+		return nil
+	})
+}
@@ -0,0 +1,52 @@
+package gui
+
+import (
+	"testing"
+
+	"github.com/jesseduffield/lazydocker/pkg/commands"
+	"github.com/stretchr/testify/assert"
+)
+
+// TestMarksAcrossEndpoints is a function.
+func TestMarksAcrossEndpoints(t *testing.T) {
+	rootless := &commands.Endpoint{Name: "rootless", Prefix: "rootless:"}
+	rootful := &commands.Endpoint{Name: "rootful", Prefix: "rootful:"}
+
+	gui := &Gui{DockerCommand: &commands.DockerCommand{
+		// the same image pulled onto both daemons has the same ID on both
+		Images: []*commands.Image{
+			{ID: "sha256:abc", Endpoint: rootless},
+			{ID: "sha256:abc", Endpoint: rootful},
+		},
+		Volumes: []*commands.Volume{
+			{Name: "pgdata", Endpoint: rootless},
+			{Name: "pgdata", Endpoint: rootful},
+		},
+		DisplayContainers: []*commands.Container{
+			{ID: "123", Endpoint: rootless},
+			{ID: "123", Endpoint: rootful},
+		},
+	}}
+	gui.State.Panels = &panelStates{Containers: &containerPanelState{}}
+
+	type scenario struct {
+		description string
+		ids         []string
+	}
+
+	scenarios := []scenario{
+		{"images", gui.getImageIDs()},
+		{"volumes", gui.getVolumeNames()},
+		{"containers", gui.getContainerIDs()},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.description, func(t *testing.T) {
+			selection := newListSelection()
+			selection.toggle(s.ids[1])
+			// marking the second daemon's row leaves the first's alone
+			assert.EqualValues(t, []int{1}, selection.markedIndices(s.ids, 0))
+			assert.False(t, selection.isMarked(s.ids[0], 0, 0))
+		})
+	}
+}
@@ -256,14 +256,12 @@ func (gui *Gui) handleServiceAttach(g *gocui.Gui, v *gocui.View) error {
 		return gui.createErrorPanel(gui.g, gui.Tr.NoContainers)
 	}
 
-	c, err := service.Attach()
-
+	session, err := service.AttachSession()
 	if err != nil {
 		return gui.createErrorPanel(gui.g, err.Error())
 	}
 
-	gui.SubProcess = c
-	return gui.Errors.ErrSubProcess
+	return gui.openTerminal(fmt.Sprintf("%s: %s", gui.Tr.Attach, service.Name), session)
 }
 
 func (gui *Gui) handleServiceViewLogs(g *gocui.Gui, v *gocui.View) error {
@@ -292,11 +290,6 @@ func (gui *Gui) handleServiceRestartMenu(g *gocui.Gui, v *gocui.View) error {
 		gui.DockerCommand.NewCommandObject(commands.CommandObject{Service: service}),
 	)
 
-	recreateCommand := utils.ApplyTemplate(
-		gui.Config.UserConfig.CommandTemplates.RecreateService,
-		gui.DockerCommand.NewCommandObject(commands.CommandObject{Service: service}),
-	)
-
 	options := []*commandOption{
 		{
 			description: gui.Tr.Restart,
@@ -320,7 +313,10 @@ func (gui *Gui) handleServiceRestartMenu(g *gocui.Gui, v *gocui.View) error {
 			),
 			f: func() error {
 				return gui.WithWaitingStatus(gui.Tr.RestartingStatus, func() error {
-					if err := gui.OSCommand.RunCommand(recreateCommand); err != nil {
+					if err := gui.OSCommand.RunTemplate(
+						gui.Config.UserConfig.CommandTemplates.RecreateService,
+						gui.DockerCommand.NewCommandObject(commands.CommandObject{Service: service}),
+					); err != nil {
 						return gui.createErrorPanel(gui.g, err.Error())
 					}
 					return nil
@@ -400,7 +396,7 @@ L:
 		customCommands = append(customCommands, gui.Config.UserConfig.CustomCommands.Containers...)
 	}
 
-	return gui.createCustomCommandMenu(customCommands, commandObject)
+	return gui.createCustomCommandMenu(customCommands, []commandTarget{{name: service.Name, commandObject: commandObject}})
 }
 
 func (gui *Gui) handleServicesBulkCommand(g *gocui.Gui, v *gocui.View) error {
@@ -409,3 +405,21 @@ func (gui *Gui) handleServicesBulkCommand(g *gocui.Gui, v *gocui.View) error {
 
 	return gui.createBulkCommandMenu(bulkCommands, commandObject)
 }
+
+// filterServices narrows the services we display down to those matching the
+// services panel's filter
+func (gui *Gui) filterServices() {
+	panelState := gui.State.Panels.Services
+	all := panelState.Unfiltered
+	if panelState.Filter.Query == "" {
+		gui.DockerCommand.Services = all
+		return
+	}
+
+	matches := panelState.Filter.matches(panelState.Filter.Query, len(all), func(i int) string { return all[i].SearchKey() }, func(i int) utils.SearchRow { return all[i].SearchRow() })
+	services := make([]*commands.Service, len(matches))
+	for i, index := range matches {
+		services[i] = all[index]
+	}
+	gui.DockerCommand.Services = services
+}
@@ -6,16 +6,25 @@ import (
 	"os"
 	"os/signal"
 	"strings"
+	"time"
 
 	"github.com/fatih/color"
 	"github.com/jesseduffield/gocui"
 	"github.com/jesseduffield/lazydocker/pkg/utils"
 )
 
+// jobShutdownTimeout is how long we wait for background jobs to stop when we're
+// closing. Killing a job's process is quick, but a job pulling through the API
+// has to wait for the daemon to hang up
+const jobShutdownTimeout = 3 * time.Second
+
 // RunWithSubprocesses loops, instantiating a new gocui.Gui with each iteration
 // if the error returned from a run is a ErrSubProcess, it runs the subprocess
 // otherwise it handles the error, possibly by quitting the application
 func (gui *Gui) RunWithSubprocesses() error {
+	// background jobs outlive subprocesses, but not lazydocker itself
+	defer gui.Jobs.CancelAll(jobShutdownTimeout)
+
 	for {
 		if err := gui.Run(); err != nil {
 			if err == gocui.ErrQuit {
@@ -39,7 +48,7 @@ func (gui *Gui) RunWithSubprocesses() error {
 			}
 		}
 	}
-	return nil
+	return gui.Bench.Write()
 }
 
 func (gui *Gui) runCommand() error {
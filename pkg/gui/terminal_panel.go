@@ -0,0 +1,246 @@
+package gui
+
+import (
+	"fmt"
+	"io"
+	"time"
+
+	"github.com/jesseduffield/gocui"
+	"github.com/jesseduffield/lazydocker/pkg/commands"
+	"github.com/jesseduffield/lazydocker/pkg/terminal"
+)
+
+// terminalState is the session being shown in the terminal view, which sits on
+// top of the main panel. We have at most one session open at a time.
+type terminalState struct {
+	Title   string
+	Session *commands.Session
+	Screen  *terminal.Screen
+	done    chan struct{}
+}
+
+// terminalKeySequences are the escape sequences an xterm sends for keys that
+// don't map to a single byte
+var terminalKeySequences = map[gocui.Key]string{
+	gocui.KeyArrowUp:    "\x1b[A",
+	gocui.KeyArrowDown:  "\x1b[B",
+	gocui.KeyArrowRight: "\x1b[C",
+	gocui.KeyArrowLeft:  "\x1b[D",
+	gocui.KeyHome:       "\x1b[H",
+	gocui.KeyEnd:        "\x1b[F",
+	gocui.KeyInsert:     "\x1b[2~",
+	gocui.KeyDelete:     "\x1b[3~",
+	gocui.KeyPgup:       "\x1b[5~",
+	gocui.KeyPgdn:       "\x1b[6~",
+	gocui.KeyF1:         "\x1bOP",
+	gocui.KeyF2:         "\x1bOQ",
+	gocui.KeyF3:         "\x1bOR",
+	gocui.KeyF4:         "\x1bOS",
+	gocui.KeyF5:         "\x1b[15~",
+	gocui.KeyF6:         "\x1b[17~",
+	gocui.KeyF7:         "\x1b[18~",
+	gocui.KeyF8:         "\x1b[19~",
+	gocui.KeyF9:         "\x1b[20~",
+	gocui.KeyF10:        "\x1b[21~",
+	gocui.KeyF11:        "\x1b[23~",
+	gocui.KeyF12:        "\x1b[24~",
+}
+
+// terminalKeyBytes returns what we need to send to the process for a keypress.
+// Control keys (e.g. ctrl+c, enter) are already the byte we need to send.
+func terminalKeyBytes(key gocui.Key, ch rune, mod gocui.Modifier) []byte {
+	var input []byte
+	if ch != 0 {
+		input = []byte(string(ch))
+	} else if sequence, ok := terminalKeySequences[key]; ok {
+		input = []byte(sequence)
+	} else if key < 0x80 {
+		input = []byte{byte(key)}
+	}
+
+	if input != nil && mod == gocui.ModAlt {
+		input = append([]byte{0x1b}, input...)
+	}
+	return input
+}
+
+// openTerminal shows the given session in the terminal view and focuses it.
+// Unlike a subprocess, this doesn't suspend the gui, so everything else keeps
+// updating while you're in there.
+func (gui *Gui) openTerminal(title string, session *commands.Session) error {
+	gui.closeTerminal()
+
+	width, height := gui.getMainView().Size()
+	screen := terminal.NewScreen(width, height)
+	// without a pseudo-terminal nobody turns line feeds into carriage return
+	// line feeds for us
+	screen.SetNewlineMode(!session.Tty)
+	if err := session.Resize(width, height); err != nil {
+		gui.Log.Warn(err)
+	}
+
+	state := &terminalState{
+		Title:   title,
+		Session: session,
+		Screen:  screen,
+		done:    make(chan struct{}),
+	}
+	gui.State.Terminal = state
+
+	go gui.copyTerminalOutput(state)
+	go gui.renderTerminal(state)
+
+	// the view itself gets created in our layout function, which will have run
+	// by the time this does
+	gui.update(func(g *gocui.Gui) error {
+		v, err := g.View("terminal")
+		if err != nil {
+			return nil
+		}
+		return gui.switchFocus(g, g.CurrentView(), v, false)
+	})
+
+	return nil
+}
+
+func (gui *Gui) copyTerminalOutput(state *terminalState) {
+	if _, err := io.Copy(state.Screen, state.Session); err != nil {
+		// we'll get an error here whenever we close the session ourselves
+		gui.Log.Warn(err)
+	}
+	close(state.done)
+
+	gui.update(func(g *gocui.Gui) error {
+		if gui.State.Terminal != state {
+			return nil
+		}
+		return gui.exitTerminal()
+	})
+}
+
+// renderTerminal redraws the terminal view whenever the screen changes, at
+// most once a frame, so that a chatty process can't flood the gui with redraws
+func (gui *Gui) renderTerminal(state *terminalState) {
+	ticker := time.NewTicker(time.Second / 60)
+	defer ticker.Stop()
+
+	for {
+		select {
+		case <-state.done:
+			return
+		case <-ticker.C:
+			if !state.Screen.TakeDirty() {
+				continue
+			}
+			gui.update(func(g *gocui.Gui) error {
+				v, err := g.View("terminal")
+				if err != nil {
+					return nil
+				}
+				v.Clear()
+				fmt.Fprint(v, state.Screen.Render())
+				return nil
+			})
+		}
+	}
+}
+
+// layoutTerminal creates, resizes or removes the terminal view depending on
+// whether we have a session open
+func (gui *Gui) layoutTerminal(g *gocui.Gui, x0, y0, x1, y1 int) error {
+	state := gui.State.Terminal
+	if state == nil {
+		if _, err := g.View("terminal"); err == nil {
+			return g.DeleteView("terminal")
+		}
+		return nil
+	}
+
+	v, err := g.SetView("terminal", x0, y0, x1, y1, gocui.LEFT)
+	if err != nil {
+		if err.Error() != "unknown view" {
+			return err
+		}
+		v.Editable = true
+		v.Editor = gocui.EditorFunc(gui.handleTerminalKey)
+		v.FgColor = gocui.ColorDefault
+	}
+	v.Title = state.Title
+
+	// the screen draws its own cursor
+	if g.CurrentView() == v {
+		g.Cursor = false
+	}
+
+	width, height := v.Size()
+	if currentWidth, currentHeight := state.Screen.Size(); currentWidth != width || currentHeight != height {
+		state.Screen.Resize(width, height)
+		go func() {
+			if err := state.Session.Resize(width, height); err != nil {
+				gui.Log.Warn(err)
+			}
+		}()
+	}
+
+	return nil
+}
+
+func (gui *Gui) handleTerminalKey(v *gocui.View, key gocui.Key, ch rune, mod gocui.Modifier) {
+	gui.sendToTerminal(terminalKeyBytes(key, ch, mod))
+}
+
+func (gui *Gui) sendToTerminal(input []byte) {
+	state := gui.State.Terminal
+	if state == nil || len(input) == 0 {
+		return
+	}
+	if _, err := state.Session.Write(input); err != nil {
+		gui.Log.Warn(err)
+	}
+}
+
+// terminalPassthrough returns a handler which sends the key straight to the
+// terminal. We use this to shadow global keybindings on special keys, which
+// gocui would otherwise run even though the terminal view is editable
+func (gui *Gui) terminalPassthrough(key gocui.Key) func(*gocui.Gui, *gocui.View) error {
+	return func(g *gocui.Gui, v *gocui.View) error {
+		gui.sendToTerminal(terminalKeyBytes(key, 0, gocui.ModNone))
+		return nil
+	}
+}
+
+func (gui *Gui) handleTerminalDetach(g *gocui.Gui, v *gocui.View) error {
+	return gui.exitTerminal()
+}
+
+func (gui *Gui) handleTerminalClick(g *gocui.Gui, v *gocui.View) error {
+	if gui.popupPanelFocused() || g.CurrentView() == v {
+		return nil
+	}
+	return gui.switchFocus(g, g.CurrentView(), v, false)
+}
+
+// exitTerminal closes the session and returns focus to wherever we were before
+// we opened it. The view is removed the next time we lay things out
+func (gui *Gui) exitTerminal() error {
+	gui.closeTerminal()
+
+	v := gui.g.CurrentView()
+	if v == nil || v.Name() != "terminal" {
+		return nil
+	}
+	return gui.returnFocus(gui.g, v)
+}
+
+// closeTerminal closes the session, if there is one
+func (gui *Gui) closeTerminal() {
+	state := gui.State.Terminal
+	if state == nil {
+		return
+	}
+	gui.State.Terminal = nil
+
+	if err := state.Session.Close(); err != nil {
+		gui.Log.Warn(err)
+	}
+}
@@ -96,7 +96,7 @@ func (gui *Gui) newLineFocused(v *gocui.View) error {
 		return gui.handleVolumeSelect(gui.g, v)
 	case "confirmation":
 		return nil
-	case "main":
+	case "main", "terminal":
 		v.Highlight = false
 		return nil
 	default:
@@ -164,12 +164,17 @@ func (gui *Gui) switchFocus(g *gocui.Gui, oldView, newView *gocui.View, returnin
 	return gui.newLineFocused(newView)
 }
 
-// if the cursor down past the last item, move it to the last line
+// if the cursor down past the last item, move it to the last line.
+// For list views that only render a window of their items, selectedY and the
+// origin we work with here are indices into the whole list, and we only render
+// the list again if we've scrolled outside of the window
 func (gui *Gui) focusPoint(selectedX int, selectedY int, lineCount int, v *gocui.View) error {
 	if selectedY < 0 || selectedY > lineCount {
 		return nil
 	}
+	offset := gui.listWindowOffset(v)
 	ox, oy := v.Origin()
+	oy += offset
 	originalOy := oy
 	cx, cy := v.Cursor()
 	originalCy := cy
@@ -192,7 +197,16 @@ func (gui *Gui) focusPoint(selectedX int, selectedY int, lineCount int, v *gocui
 	}
 
 	if originalOy != oy {
-		_ = v.SetOrigin(ox, oy)
+		_ = v.SetOrigin(ox, oy-offset)
+	}
+
+	if window, ok := gui.State.ListWindows[v.Name()]; ok && !window.covers(oy, height, lineCount) {
+		if err := gui.renderListWindow(v.Name()); err != nil {
+			return err
+		}
+		offset = gui.listWindowOffset(v)
+		_, oy = v.Origin()
+		oy += offset
 	}
 
 	cy = selectedY - oy
@@ -208,14 +222,36 @@ func (gui *Gui) cleanString(s string) string {
 }
 
 func (gui *Gui) setViewContent(g *gocui.Gui, v *gocui.View, s string) error {
+	span := gui.Tracer.Start("render", "draw "+v.Name())
+	defer span.End()
+
 	v.Clear()
 	fmt.Fprint(v, gui.cleanString(s))
 	return nil
 }
 
+// update runs f on gocui's main loop like gocui's own Update, counting how many
+// of these are waiting to run for the internals tab, and tracing how long each
+// one waits
+func (gui *Gui) update(f func(*gocui.Gui) error) {
+	if gui.Metrics == nil && gui.Tracer == nil {
+		gui.g.Update(f)
+		return
+	}
+
+	done := gui.Metrics.QueueUpdate()
+	// whatever queued this has usually moved on by the time it runs
+	span := gui.Tracer.StartAsync("render", "wait for main loop")
+	gui.g.Update(func(g *gocui.Gui) error {
+		done()
+		span.End()
+		return f(g)
+	})
+}
+
 // renderString resets the origin of a view and sets its content
 func (gui *Gui) renderString(g *gocui.Gui, viewName, s string) error {
-	g.Update(func(*gocui.Gui) error {
+	gui.update(func(*gocui.Gui) error {
 		v, err := g.View(viewName)
 		if err != nil {
 			return nil // return gracefully if view has been deleted
@@ -233,7 +269,7 @@ func (gui *Gui) renderString(g *gocui.Gui, viewName, s string) error {
 
 // reRenderString sets the view's content, without changing its origin
 func (gui *Gui) reRenderString(g *gocui.Gui, viewName, s string) error {
-	g.Update(func(*gocui.Gui) error {
+	gui.update(func(*gocui.Gui) error {
 		v, err := g.View(viewName)
 		if err != nil {
 			return nil // return gracefully if view has been deleted
@@ -339,6 +375,8 @@ func (gui *Gui) renderPanelOptions() error {
 		return gui.renderMenuOptions()
 	case "confirmation":
 		return gui.renderConfirmationOptions()
+	case "terminal":
+		return gui.renderOptionsMap(map[string]string{"ctrl+q": gui.Tr.DetachTerminal})
 	}
 	return gui.renderGlobalOptions()
 }
@@ -370,7 +408,7 @@ func (gui *Gui) handleClick(v *gocui.View, itemCount int, selectedLine *int, han
 	_, cy := v.Cursor()
 	_, oy := v.Origin()
 
-	newSelectedLine := cy - oy
+	newSelectedLine := gui.listWindowOffset(v) + oy + cy
 
 	if newSelectedLine < 0 {
 		newSelectedLine = 0
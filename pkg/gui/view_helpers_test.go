@@ -0,0 +1,61 @@
+package gui
+
+import (
+	"fmt"
+	"strings"
+	"testing"
+
+	"github.com/fatih/color"
+	"github.com/jesseduffield/gocui"
+	"github.com/jesseduffield/lazydocker/pkg/utils"
+)
+
+// benchmarkView returns a view the size of a main panel. We don't need a
+// terminal to write to one, only to draw it
+func benchmarkView() *gocui.View {
+	v, _ := (&gocui.Gui{}).SetView("main", 0, 0, 160, 50, 0)
+	return v
+}
+
+// benchmarkLogLine is a typical line of coloured log output
+var benchmarkLogLine = utils.ColoredString("2019-07-02T11:21:32Z", color.FgBlue) + " level=info msg=\"handled request\" status=" + utils.ColoredString("200", color.FgGreen) + "\n"
+
+// BenchmarkViewWrite streams log lines into a view, like we do when following
+// a container's logs
+func BenchmarkViewWrite(b *testing.B) {
+	v := benchmarkView()
+	line := []byte(benchmarkLogLine)
+	b.SetBytes(int64(len(line)))
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		if i%10000 == 0 {
+			// keep the buffer from growing for the whole run
+			v.Clear()
+		}
+		if _, err := v.Write(line); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+// BenchmarkSetViewContent replaces a view's content, which we do each time we
+// render a panel or the main view
+func BenchmarkSetViewContent(b *testing.B) {
+	gui := &Gui{}
+
+	for _, size := range []int{10, 100, 1000, 10000} {
+		b.Run(fmt.Sprintf("%d lines", size), func(b *testing.B) {
+			v := benchmarkView()
+			content := strings.Repeat(benchmarkLogLine, size)
+			b.SetBytes(int64(len(content)))
+			b.ReportAllocs()
+
+			for i := 0; i < b.N; i++ {
+				if err := gui.setViewContent(nil, v, content); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
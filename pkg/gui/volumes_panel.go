@@ -2,7 +2,9 @@ package gui
 
 import (
 	"fmt"
+	"strings"
 
+	"github.com/docker/docker/api/types/events"
 	"github.com/fatih/color"
 	"github.com/go-errors/errors"
 	"github.com/jesseduffield/gocui"
@@ -30,6 +32,28 @@ func (gui *Gui) getSelectedVolume() (*commands.Volume, error) {
 	return gui.DockerCommand.Volumes[selectedLine], nil
 }
 
+// getVolumeNames returns the name of each volume qualified by its endpoint, so
+// that a volume doesn't get mixed up with its namesake on another daemon
+func (gui *Gui) getVolumeNames() []string {
+	ids := make([]string, len(gui.DockerCommand.Volumes))
+	for i, volume := range gui.DockerCommand.Volumes {
+		ids[i] = volume.UsageKey()
+	}
+	return ids
+}
+
+// getMarkedVolumes returns the volumes the user has marked, or the selected
+// volume if none are marked
+func (gui *Gui) getMarkedVolumes() []*commands.Volume {
+	panelState := gui.State.Panels.Volumes
+	indices := panelState.Selection.markedIndices(gui.getVolumeNames(), panelState.SelectedLine)
+	volumes := make([]*commands.Volume, len(indices))
+	for i, index := range indices {
+		volumes[i] = gui.DockerCommand.Volumes[index]
+	}
+	return volumes
+}
+
 func (gui *Gui) handleVolumesClick(g *gocui.Gui, v *gocui.View) error {
 	itemCount := len(gui.DockerCommand.Volumes)
 	handleSelect := gui.handleVolumeSelect
@@ -83,6 +107,9 @@ func (gui *Gui) renderVolumeConfig(mainView *gocui.View, volume *commands.Volume
 		output += utils.WithPadding("Driver: ", padding) + volume.Volume.Driver + "\n"
 		output += utils.WithPadding("Scope: ", padding) + volume.Volume.Scope + "\n"
 		output += utils.WithPadding("Mountpoint: ", padding) + volume.Volume.Mountpoint + "\n"
+		if names := gui.DockerCommand.UsageIndex.VolumeContainerNames(volume.UsageKey()); len(names) > 0 {
+			output += utils.WithPadding("Used by: ", padding) + utils.ColoredString(strings.Join(names, ", "), color.FgGreen) + "\n"
+		}
 		output += utils.WithPadding("Labels: ", padding) + utils.FormatMap(padding, volume.Volume.Labels) + "\n"
 		output += utils.WithPadding("Options: ", padding) + utils.FormatMap(padding, volume.Volume.Options) + "\n"
 
@@ -93,27 +120,66 @@ func (gui *Gui) renderVolumeConfig(mainView *gocui.View, volume *commands.Volume
 				output += utils.FormatMapItem(padding, k, v)
 			}
 		} else {
-			output += "n/a"
+			output += "n/a\n"
 		}
 
 		if volume.Volume.UsageData != nil {
 			output += utils.WithPadding("RefCount: ", padding) + fmt.Sprintf("%d", volume.Volume.UsageData.RefCount) + "\n"
 			output += utils.WithPadding("Size: ", padding) + utils.FormatBinaryBytes(int(volume.Volume.UsageData.Size)) + "\n"
+		} else if volume.Size >= 0 {
+			output += utils.WithPadding("Size: ", padding) + utils.FormatBinaryBytes(int(volume.Size)) + "\n"
 		}
 
 		gui.renderString(gui.g, "main", output)
 	})
 }
 
-func (gui *Gui) refreshVolumes() error {
+// refreshVolumesOnChange refreshes the volumes if any of the daemons has told
+// us about a volume event since we last did, and re-renders them if we've
+// worked out the disk usage again in the meantime. Volumes rarely change so
+// there's no point listing them over and over. If a daemon didn't answer, we
+// keep listing until it does rather than waiting on an event it may never send
+func (gui *Gui) refreshVolumesOnChange() error {
+	if gui.getVolumesView() == nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Volumes
+	session := gui.State.SessionIndex
+	eventVersion := gui.DockerCommand.EventVersion(events.VolumeEventType)
+	diskUsageVersion := gui.DockerCommand.DiskUsage.Version()
+
+	if session != panelState.RefreshedSession || eventVersion != panelState.RefreshedEvents {
+		complete, err := gui.refreshVolumes()
+		if err != nil || !complete {
+			return err
+		}
+	} else if diskUsageVersion != panelState.RefreshedDiskUsage {
+		gui.update(func(g *gocui.Gui) error {
+			return gui.renderVolumes()
+		})
+	}
+
+	panelState.RefreshedSession = session
+	panelState.RefreshedEvents = eventVersion
+	panelState.RefreshedDiskUsage = diskUsageVersion
+	return nil
+}
+
+// refreshVolumes lists the volumes again. complete is false if any of the
+// endpoints failed to answer
+func (gui *Gui) refreshVolumes() (complete bool, err error) {
 	volumesView := gui.getVolumesView()
 	if volumesView == nil {
 		// if the volumesView hasn't been instantiated yet we just return
-		return nil
+		return true, nil
 	}
-	if err := gui.DockerCommand.RefreshVolumes(); err != nil {
-		return err
+	complete, err = gui.DockerCommand.RefreshVolumes()
+	if err != nil {
+		return false, err
 	}
+	gui.State.Panels.Volumes.Unfiltered = gui.DockerCommand.Volumes
+	gui.filterVolumes()
 
 	if len(gui.DockerCommand.Volumes) > 0 && gui.State.Panels.Volumes.SelectedLine == -1 {
 		gui.State.Panels.Volumes.SelectedLine = 0
@@ -122,14 +188,10 @@ func (gui *Gui) refreshVolumes() error {
 		gui.State.Panels.Volumes.SelectedLine = len(gui.DockerCommand.Volumes) - 1
 	}
 
-	gui.g.Update(func(g *gocui.Gui) error {
-		volumesView.Clear()
-		isFocused := gui.g.CurrentView().Name() == "volumes"
-		list, err := utils.RenderList(gui.DockerCommand.Volumes, utils.IsFocused(isFocused))
-		if err != nil {
+	gui.update(func(g *gocui.Gui) error {
+		if err := gui.renderVolumes(); err != nil {
 			return err
 		}
-		fmt.Fprint(volumesView, list)
 
 		if volumesView == g.CurrentView() {
 			return gui.handleVolumeSelect(g, volumesView)
@@ -137,6 +199,50 @@ func (gui *Gui) refreshVolumes() error {
 		return nil
 	})
 
+	return complete, nil
+}
+
+// filterVolumes narrows the volumes we display down to those matching the
+// volumes panel's filter
+func (gui *Gui) filterVolumes() {
+	panelState := gui.State.Panels.Volumes
+	all := panelState.Unfiltered
+	if panelState.Filter.Query == "" {
+		gui.DockerCommand.Volumes = all
+		return
+	}
+
+	matches := panelState.Filter.matches(panelState.Filter.Query, len(all), func(i int) string { return all[i].SearchKey() }, func(i int) utils.SearchRow { return all[i].SearchRow() })
+	volumes := make([]*commands.Volume, len(matches))
+	for i, index := range matches {
+		volumes[i] = all[index]
+	}
+	gui.DockerCommand.Volumes = volumes
+}
+
+// renderVolumes writes the volumes list to its view. It must be called from
+// within the gui's main loop
+func (gui *Gui) renderVolumes() error {
+	volumesView := gui.getVolumesView()
+	window := gui.updateListWindow(volumesView, len(gui.DockerCommand.Volumes))
+	volumesView.Clear()
+	isFocused := gui.g.CurrentView().Name() == "volumes"
+
+	usage, _ := gui.DockerCommand.DiskUsage.Get()
+	for _, volume := range gui.DockerCommand.Volumes {
+		volume.ContainerCount = gui.DockerCommand.UsageIndex.VolumeUseCount(volume.UsageKey())
+		if usage != nil && gui.DockerCommand.OnFirstEndpoint(volume.Endpoint) {
+			volume.Size = usage.VolumeSize(volume.Name)
+		}
+	}
+
+	panelState := gui.State.Panels.Volumes
+	markedLines := panelState.Selection.renderOption(gui.getVolumeNames(), panelState.SelectedLine, window.start)
+	list, err := utils.RenderList(gui.DockerCommand.Volumes[window.start:window.end], utils.IsFocused(isFocused), markedLines)
+	if err != nil {
+		return err
+	}
+	fmt.Fprint(volumesView, list)
 	return nil
 }
 
@@ -148,6 +254,12 @@ func (gui *Gui) handleVolumesNextLine(g *gocui.Gui, v *gocui.View) error {
 	panelState := gui.State.Panels.Volumes
 	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Volumes), false)
 
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderVolumes(); err != nil {
+			return err
+		}
+	}
+
 	return gui.handleVolumeSelect(gui.g, v)
 }
 
@@ -159,10 +271,20 @@ func (gui *Gui) handleVolumesPrevLine(g *gocui.Gui, v *gocui.View) error {
 	panelState := gui.State.Panels.Volumes
 	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Volumes), true)
 
+	if !panelState.Selection.isEmpty() {
+		if err := gui.renderVolumes(); err != nil {
+			return err
+		}
+	}
+
 	return gui.handleVolumeSelect(gui.g, v)
 }
 
 func (gui *Gui) handleVolumesNextContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(1) {
+		return nil
+	}
+
 	contexts := gui.getVolumeContexts()
 	if gui.State.Panels.Volumes.ContextIndex >= len(contexts)-1 {
 		gui.State.Panels.Volumes.ContextIndex = 0
@@ -176,6 +298,10 @@ func (gui *Gui) handleVolumesNextContext(g *gocui.Gui, v *gocui.View) error {
 }
 
 func (gui *Gui) handleVolumesPrevContext(g *gocui.Gui, v *gocui.View) error {
+	if gui.cycleStreamTab(-1) {
+		return nil
+	}
+
 	contexts := gui.getVolumeContexts()
 	if gui.State.Panels.Volumes.ContextIndex <= 0 {
 		gui.State.Panels.Volumes.ContextIndex = len(contexts) - 1
@@ -188,6 +314,33 @@ func (gui *Gui) handleVolumesPrevContext(g *gocui.Gui, v *gocui.View) error {
 	return nil
 }
 
+func (gui *Gui) handleVolumesToggleMarked(g *gocui.Gui, v *gocui.View) error {
+	volume, err := gui.getSelectedVolume()
+	if err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Volumes
+	panelState.Selection.toggle(volume.UsageKey())
+	gui.changeSelectedLine(&panelState.SelectedLine, len(gui.DockerCommand.Volumes), false)
+
+	if err := gui.renderVolumes(); err != nil {
+		return err
+	}
+	return gui.handleVolumeSelect(gui.g, v)
+}
+
+func (gui *Gui) handleVolumesToggleRange(g *gocui.Gui, v *gocui.View) error {
+	if _, err := gui.getSelectedVolume(); err != nil {
+		return nil
+	}
+
+	panelState := gui.State.Panels.Volumes
+	panelState.Selection.toggleRange(gui.getVolumeNames(), panelState.SelectedLine)
+
+	return gui.renderVolumes()
+}
+
 type removeVolumeOption struct {
 	description string
 	command     string
@@ -201,21 +354,34 @@ func (r *removeVolumeOption) GetDisplayStrings(isFocused bool) []string {
 }
 
 func (gui *Gui) handleVolumesRemoveMenu(g *gocui.Gui, v *gocui.View) error {
-	volume, err := gui.getSelectedVolume()
-	if err != nil {
+	volumes := gui.getMarkedVolumes()
+	if len(volumes) == 0 {
 		return nil
 	}
 
+	// even a forced remove fails if a container is using the volume
+	for _, volume := range volumes {
+		if names := gui.DockerCommand.UsageIndex.VolumeContainerNames(volume.UsageKey()); len(names) > 0 {
+			return gui.createErrorPanel(gui.g, fmt.Sprintf(gui.Tr.VolumeInUseError, volume.Name, strings.Join(names, ", ")))
+		}
+	}
+
+	names := make([]string, len(volumes))
+	for i, volume := range volumes {
+		names[i] = volume.Name
+	}
+	name := strings.Join(names, " ")
+
 	options := []*removeVolumeOption{
 		{
 			description: gui.Tr.Remove,
-			command:     utils.WithShortSha("docker volume rm " + volume.Name),
+			command:     utils.WithShortSha("docker volume rm " + name),
 			force:       false,
 			runCommand:  true,
 		},
 		{
 			description: gui.Tr.ForceRemove,
-			command:     utils.WithShortSha("docker volume rm --force " + volume.Name),
+			command:     utils.WithShortSha("docker volume rm --force " + name),
 			force:       true,
 			runCommand:  true,
 		},
@@ -229,19 +395,24 @@ func (gui *Gui) handleVolumesRemoveMenu(g *gocui.Gui, v *gocui.View) error {
 		if !options[index].runCommand {
 			return nil
 		}
-		return gui.WithWaitingStatus(gui.Tr.RemovingStatus, func() error {
-			if cerr := volume.Remove(options[index].force); cerr != nil {
-				return gui.createErrorPanel(gui.g, cerr.Error())
-			}
-			return nil
-		})
+		force := options[index].force
+		gui.State.Panels.Volumes.Selection.clear()
+
+		remove := func(i int) error {
+			return volumes[i].Remove(force)
+		}
+		refresh := func() error {
+			_, err := gui.refreshVolumes()
+			return err
+		}
+		return gui.runBatch(gui.Tr.RemovingStatus, len(volumes), remove, refresh)
 	}
 
 	return gui.createMenu("", options, len(options), handleMenuPress)
 }
 
 func (gui *Gui) handlePruneVolumes() error {
-	return gui.createConfirmationPanel(gui.g, gui.getVolumesView(), gui.Tr.Confirm, gui.Tr.ConfirmPruneVolumes, func(g *gocui.Gui, v *gocui.View) error {
+	return gui.createConfirmationPanel(gui.g, gui.getVolumesView(), gui.Tr.Confirm, gui.withReclaimableSpace(gui.Tr.ConfirmPruneVolumes, (*commands.DiskUsage).ReclaimableVolumeBytes), func(g *gocui.Gui, v *gocui.View) error {
 		return gui.WithWaitingStatus(gui.Tr.PruningStatus, func() error {
 			err := gui.DockerCommand.PruneVolumes()
 			if err != nil {
@@ -253,18 +424,22 @@ func (gui *Gui) handlePruneVolumes() error {
 }
 
 func (gui *Gui) handleVolumesCustomCommand(g *gocui.Gui, v *gocui.View) error {
-	volume, err := gui.getSelectedVolume()
-	if err != nil {
+	if _, err := gui.getSelectedVolume(); err != nil {
 		return nil
 	}
 
-	commandObject := gui.DockerCommand.NewCommandObject(commands.CommandObject{
-		Volume: volume,
-	})
+	volumes := gui.getMarkedVolumes()
+	targets := make([]commandTarget, len(volumes))
+	for i, volume := range volumes {
+		targets[i] = commandTarget{
+			name:          volume.Endpoint.Qualify(volume.Name),
+			commandObject: gui.DockerCommand.NewCommandObject(commands.CommandObject{Volume: volume}),
+		}
+	}
 
 	customCommands := gui.Config.UserConfig.CustomCommands.Volumes
 
-	return gui.createCustomCommandMenu(customCommands, commandObject)
+	return gui.createCustomCommandMenu(customCommands, targets)
 }
 
 func (gui *Gui) handleVolumesBulkCommand(g *gocui.Gui, v *gocui.View) error {
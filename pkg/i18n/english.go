@@ -25,6 +25,8 @@ type TranslationSet struct {
 	CannotAttachStoppedContainerError          string
 	CannotAccessDockerSocketError              string
 	CannotKillChildError                       string
+	ImageInUseError                            string
+	VolumeInUseError                           string
 
 	Donate                     string
 	Cancel                     string
@@ -82,8 +84,81 @@ type TranslationSet struct {
 	ViewRestartOptions         string
 	ExecShell                  string
 	RunCustomCommand           string
+	Stale                      string
 	ViewBulkCommands           string
 	OpenInBrowser              string
+	ToggleMarked               string
+	ToggleRangeSelect          string
+	StopMarkedContainers       string
+	CancelJob                  string
+	PullImage                  string
+	PullImagePrompt            string
+	NoPulls                    string
+	NoJobs                     string
+	NoRunningJobs              string
+	DetachTerminal             string
+	CommandTargets             string
+	ComputingDiskUsage         string
+	Reclaimable                string
+	ReclaimableSpace           string
+	NameColumn                 string
+	SizeColumn                 string
+	SharedSizeColumn           string
+	UniqueSizeColumn           string
+	ImageColumn                string
+	ContainersColumn           string
+	EndpointColumn             string
+	PoolColumn                 string
+	OpenSocketsColumn          string
+	DialsColumn                string
+	DialErrorsColumn           string
+	RequestsColumn             string
+	ReusedColumn               string
+	ConnectionWaitColumn       string
+	BytesReadColumn            string
+	BytesWrittenColumn         string
+	RequestPool                string
+	StreamPool                 string
+	SortImages                 string
+	SortByNewest               string
+	SortByTotalSize            string
+	SortBySharedSize           string
+	SortByUniqueSize           string
+	SortContainers             string
+	SortByDaemonOrder          string
+	SortByName                 string
+	SortByCPU                  string
+	SortByMemory               string
+	SortByNetwork              string
+	SortByUptime               string
+	SortByRestarts             string
+	GroupContainers            string
+	FocusMainOrToggleGroup     string
+	FilterList                 string
+	FilterPrompt               string
+	Filtered                   string
+	InvalidFilter              string
+	CaptureProfile             string
+	CapturingProfileStatus     string
+	ProfileCapturedTitle       string
+	ProfileCaptured            string
+	CountColumn                string
+	MeanColumn                 string
+	MaxColumn                  string
+	DistributionColumn         string
+	DockerAPISection           string
+	CommandsSection            string
+	RefreshesSection           string
+	FramesSection              string
+	LayoutRow                  string
+	FrameRateRow               string
+	UpdateQueueRow             string
+	StatsStreamsRow            string
+	LogProcessesRow            string
+	GoroutinesRow              string
+	HeapRow                    string
+	GCPausesRow                string
+	GCPauses                   string
 
 	LogsTitle                string
 	ConfigTitle              string
@@ -91,6 +166,14 @@ type TranslationSet struct {
 	StatsTitle               string
 	CreditsTitle             string
 	ContainerConfigTitle     string
+	JobsTitle                string
+	PullsTitle               string
+	TerminalTitle            string
+	DiskUsageTitle           string
+	ConnectionsTitle         string
+	BuildCacheTitle          string
+	SortTitle                string
+	InternalsTitle           string
 
 	No  string
 	Yes string
@@ -114,6 +197,8 @@ func englishSet() TranslationSet {
 		CannotAttachStoppedContainerError: "You cannot attach to a stopped container, you need to start it first (which you can actually do with the 'r' key) (yes I'm too lazy to do this automatically for you) (pretty cool that I get to communicate one-on-one with you in the form of an error message though)",
 		CannotAccessDockerSocketError:     "Can't access docker socket at: unix:///var/run/docker.sock\nRun lazydocker as root or read https://docs.docker.com/install/linux/linux-postinstall/",
 		CannotKillChildError:              "Waited three seconds for child process to stop. There may be an orphan process that continues to run on your system.",
+		ImageInUseError:                   "Can't remove %s because it is used by these containers: %s. Remove them first",
+		VolumeInUseError:                  "Can't remove %s because it is mounted by these containers: %s. Remove them first",
 
 		Donate:  "Donate",
 		Confirm: "Confirm",
@@ -152,8 +237,16 @@ func englishSet() TranslationSet {
 		ViewRestartOptions:  "view restart options",
 		ExecShell:           "exec shell",
 		RunCustomCommand:    "run predefined custom command",
+		Stale:               "(stale for %s)",
 		ViewBulkCommands:    "view bulk commands",
 		OpenInBrowser:       "open in browser (first port is http)",
+		ToggleMarked:        "mark/unmark",
+		ToggleRangeSelect:   "start/end range selection",
+		CancelJob:           "cancel latest background job",
+		PullImage:           "pull image",
+		PullImagePrompt:     "Image to pull:",
+		DetachTerminal:      "detach (the container keeps running)",
+		CommandTargets:      "(%d targets)",
 
 		AnonymousReportingTitle:  "Help make lazydocker better",
 		AnonymousReportingPrompt: "Would you like to enable anonymous reporting data to help improve lazydocker?",
@@ -176,6 +269,14 @@ func englishSet() TranslationSet {
 		StatsTitle:                "Stats",
 		CreditsTitle:              "About",
 		ContainerConfigTitle:      "Container Config",
+		JobsTitle:                 "Jobs",
+		PullsTitle:                "Pulls",
+		TerminalTitle:             "Terminal",
+		DiskUsageTitle:            "Disk Usage",
+		ConnectionsTitle:          "Connections",
+		BuildCacheTitle:           "Build Cache",
+		SortTitle:                 "Sort By",
+		InternalsTitle:            "Internals",
 
 		NoContainers: "No containers",
 		NoContainer:  "No container",
@@ -192,6 +293,71 @@ func englishSet() TranslationSet {
 		ConfirmPruneVolumes:        "Are you sure you want to prune all unused volumes?",
 		StopService:                "Are you sure you want to stop this service's containers?",
 		StopContainer:              "Are you sure you want to stop this container?",
+		StopMarkedContainers:       "Are you sure you want to stop the %d marked containers?",
+		NoJobs:                     "No background jobs have been run. Custom commands with `background: true` (like the default pull and build bulk commands) will show up here",
+		NoRunningJobs:              "There are no background jobs running",
+		NoPulls:                    "No images are being pulled. Press 'p' to pull one",
+		ComputingDiskUsage:         "Working out disk usage...",
+		Reclaimable:                "(%s reclaimable by pruning)",
+		ReclaimableSpace:           "This will free up about %s.",
+		NameColumn:                 "name",
+		SizeColumn:                 "size",
+		SharedSizeColumn:           "shared",
+		UniqueSizeColumn:           "unique",
+		ImageColumn:                "image",
+		ContainersColumn:           "containers",
+		EndpointColumn:             "endpoint",
+		PoolColumn:                 "pool",
+		OpenSocketsColumn:          "open",
+		DialsColumn:                "dials",
+		DialErrorsColumn:           "dial errors",
+		RequestsColumn:             "requests",
+		ReusedColumn:               "reused",
+		ConnectionWaitColumn:       "avg wait",
+		BytesReadColumn:            "in",
+		BytesWrittenColumn:         "out",
+		RequestPool:                "requests",
+		StreamPool:                 "streams",
+		SortImages:                 "sort images",
+		SortByNewest:               "newest first",
+		SortByTotalSize:            "total size",
+		SortBySharedSize:           "size shared with other images",
+		SortByUniqueSize:           "size unique to the image",
+		SortContainers:             "sort containers",
+		SortByDaemonOrder:          "the order docker lists them in",
+		SortByName:                 "name",
+		SortByCPU:                  "CPU usage",
+		SortByMemory:               "memory usage",
+		SortByNetwork:              "network traffic",
+		SortByUptime:               "uptime",
+		SortByRestarts:             "restart count",
+		GroupContainers:            "group by compose project",
+		FocusMainOrToggleGroup:     "focus main panel, or expand/collapse group",
+		FilterList:                 "filter list",
+		FilterPrompt:               "Filter (esc to clear):",
+		Filtered:                   "(filter: %s)",
+		InvalidFilter:              "(invalid filter: %s)",
+		CaptureProfile:             "profile lazydocker for 10 seconds",
+		CapturingProfileStatus:     "profiling",
+		ProfileCapturedTitle:       "Profile",
+		ProfileCaptured:            "Wrote a CPU profile to\n%s\nand an execution trace to\n%s\n\nAttach both if you're reporting a problem, or look at them with `go tool pprof` and `go tool trace`",
+		CountColumn:                "count",
+		MeanColumn:                 "mean",
+		MaxColumn:                  "max",
+		DistributionColumn:         "distribution",
+		DockerAPISection:           "docker API (time to first byte)",
+		CommandsSection:            "commands",
+		RefreshesSection:           "refreshes",
+		FramesSection:              "frames",
+		LayoutRow:                  "layout",
+		FrameRateRow:               "frames drawn",
+		UpdateQueueRow:             "updates waiting to run",
+		StatsStreamsRow:            "stats streams",
+		LogProcessesRow:            "log processes",
+		GoroutinesRow:              "goroutines",
+		HeapRow:                    "heap in use / reserved",
+		GCPausesRow:                "garbage collections",
+		GCPauses:                   "%d since the last refresh, longest pause %s (%s paused in total)",
 		PressEnterToReturn:         "Press enter to return to lazydocker (this prompt can be disabled in your config by setting `gui.returnImmediately: true`)",
 
 		No:  "no",
@@ -0,0 +1,105 @@
+package metrics
+
+import (
+	"sync"
+	"time"
+)
+
+// smallestBucket is the upper bound of a histogram's first bucket. Each bucket
+// after it is twice as wide as the one before, up to bucketCount buckets with
+// the last one catching anything slower
+const smallestBucket = 100 * time.Microsecond
+
+// bucketCount gives us buckets from under 100µs to over 3s, which covers
+// anything from a cached inspect to a daemon that's struggling
+const bucketCount = 17
+
+// BucketBound returns the upper bound of bucket i. The last bucket has no upper
+// bound, so its lower bound is returned instead
+func BucketBound(i int) time.Duration {
+	if i >= bucketCount-1 {
+		i = bucketCount - 2
+	}
+	return smallestBucket << uint(i)
+}
+
+// Histogram counts durations into buckets, so that we can tell how they're
+// spread without keeping every one of them
+type Histogram struct {
+	mutex   sync.Mutex
+	buckets [bucketCount]int64
+	count   int64
+	total   time.Duration
+	max     time.Duration
+}
+
+// Observe adds a duration to the histogram
+func (h *Histogram) Observe(d time.Duration) {
+	bucket := 0
+	for bucket < bucketCount-1 && d > BucketBound(bucket) {
+		bucket++
+	}
+
+	h.mutex.Lock()
+	defer h.mutex.Unlock()
+
+	h.buckets[bucket]++
+	h.count++
+	h.total += d
+	if d > h.max {
+		h.max = d
+	}
+}
+
+// HistogramSnapshot is a copy of a histogram at some point in time
+type HistogramSnapshot struct {
+	Buckets [bucketCount]int64
+	Count   int64
+	Total   time.Duration
+	Max     time.Duration
+}
+
+// Snapshot returns a copy of the histogram
+func (h *Histogram) Snapshot() HistogramSnapshot {
+	h.mutex.Lock()
+	defer h.mutex.Unlock()
+
+	return HistogramSnapshot{
+		Buckets: h.buckets,
+		Count:   h.count,
+		Total:   h.total,
+		Max:     h.max,
+	}
+}
+
+// Mean returns the average of the durations
+func (s HistogramSnapshot) Mean() time.Duration {
+	if s.Count == 0 {
+		return 0
+	}
+	return s.Total / time.Duration(s.Count)
+}
+
+// Quantile returns the upper bound of the bucket that the q'th quantile (e.g.
+// 0.99) falls in, or the slowest duration if that's lower
+func (s HistogramSnapshot) Quantile(q float64) time.Duration {
+	if s.Count == 0 {
+		return 0
+	}
+
+	rank := int64(q*float64(s.Count) + 0.5)
+	if rank < 1 {
+		rank = 1
+	}
+	seen := int64(0)
+	for i, count := range s.Buckets {
+		seen += count
+		if seen >= rank {
+			if i == bucketCount-1 || BucketBound(i) > s.Max {
+				return s.Max
+			}
+			return BucketBound(i)
+		}
+	}
+	return s.Max
+}
@@ -0,0 +1,178 @@
+package metrics
+
+import (
+	"sort"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Metrics is what lazydocker measures about itself, for the internals tab. It
+// lets us tell whether we're slow because the daemon is slow to answer or
+// because of something we're doing. A nil Metrics measures nothing, so that
+// callers don't have to check whether the tab is switched on
+type Metrics struct {
+	api       histogramSet
+	commands  histogramSet
+	refreshes histogramSet
+	frames    Histogram
+
+	pendingUpdates int64
+	statsStreams   int64
+	logProcesses   int64
+}
+
+// New returns a Metrics to measure into
+func New() *Metrics {
+	return &Metrics{}
+}
+
+// ObserveAPI records how long the daemon took to start answering a request.
+// name is the request with any IDs taken out, e.g. 'GET /containers/{id}/json'
+func (m *Metrics) ObserveAPI(name string, took time.Duration) {
+	if m == nil {
+		return
+	}
+	m.api.observe(name, took)
+}
+
+// ObserveCommand records how long a command we ran took. name is the command
+// template it came from, or the command itself if it didn't come from one
+func (m *Metrics) ObserveCommand(name string, took time.Duration) {
+	if m == nil {
+		return
+	}
+	m.commands.observe(name, took)
+}
+
+// ObserveRefresh records how long one of our periodic refreshes took
+func (m *Metrics) ObserveRefresh(name string, took time.Duration) {
+	if m == nil {
+		return
+	}
+	m.refreshes.observe(name, took)
+}
+
+// ObserveFrame records how long it took us to lay out a frame
+func (m *Metrics) ObserveFrame(took time.Duration) {
+	if m == nil {
+		return
+	}
+	m.frames.Observe(took)
+}
+
+// QueueUpdate records that we've asked gocui to run something on its main loop.
+// The returned function must be called when it runs
+func (m *Metrics) QueueUpdate() func() {
+	if m == nil {
+		return func() {}
+	}
+	return track(&m.pendingUpdates)
+}
+
+// StartStatsStream records that we've opened a stats stream for a container.
+// The returned function must be called when the stream closes
+func (m *Metrics) StartStatsStream() func() {
+	if m == nil {
+		return func() {}
+	}
+	return track(&m.statsStreams)
+}
+
+// StartLogProcess records that we've started a process to follow some logs.
+// The returned function must be called when the process exits
+func (m *Metrics) StartLogProcess() func() {
+	if m == nil {
+		return func() {}
+	}
+	return track(&m.logProcesses)
+}
+
+// track counts one more of something until the returned function is called
+func track(counter *int64) func() {
+	atomic.AddInt64(counter, 1)
+	var once sync.Once
+	return func() {
+		once.Do(func() { atomic.AddInt64(counter, -1) })
+	}
+}
+
+// NamedHistogram is a histogram along with what it's measuring
+type NamedHistogram struct {
+	Name string
+	HistogramSnapshot
+}
+
+// Snapshot is a copy of everything we've measured so far
+type Snapshot struct {
+	API            []NamedHistogram
+	Commands       []NamedHistogram
+	Refreshes      []NamedHistogram
+	Frames         HistogramSnapshot
+	PendingUpdates int64
+	StatsStreams   int64
+	LogProcesses   int64
+}
+
+// Snapshot returns a copy of everything we've measured so far
+func (m *Metrics) Snapshot() Snapshot {
+	if m == nil {
+		return Snapshot{}
+	}
+	return Snapshot{
+		API:            m.api.snapshot(),
+		Commands:       m.commands.snapshot(),
+		Refreshes:      m.refreshes.snapshot(),
+		Frames:         m.frames.Snapshot(),
+		PendingUpdates: atomic.LoadInt64(&m.pendingUpdates),
+		StatsStreams:   atomic.LoadInt64(&m.statsStreams),
+		LogProcesses:   atomic.LoadInt64(&m.logProcesses),
+	}
+}
+
+// maxNames caps how many things a histogramSet measures separately. Commands
+// that didn't come from a template are named after themselves, so e.g.
+// opening a lot of different files could otherwise grow the set forever
+const maxNames = 100
+
+// otherName is where a full histogramSet puts anything it hasn't seen before
+const otherName = "(other)"
+
+// histogramSet is a histogram per name
+type histogramSet struct {
+	mutex      sync.Mutex
+	histograms map[string]*Histogram
+}
+
+func (s *histogramSet) observe(name string, took time.Duration) {
+	s.mutex.Lock()
+	if s.histograms == nil {
+		s.histograms = map[string]*Histogram{}
+	}
+	histogram, ok := s.histograms[name]
+	if !ok {
+		if len(s.histograms) >= maxNames {
+			name = otherName
+			histogram = s.histograms[name]
+		}
+		if histogram == nil {
+			histogram = &Histogram{}
+			s.histograms[name] = histogram
+		}
+	}
+	s.mutex.Unlock()
+
+	histogram.Observe(took)
+}
+
+func (s *histogramSet) snapshot() []NamedHistogram {
+	s.mutex.Lock()
+	result := make([]NamedHistogram, 0, len(s.histograms))
+	for name, histogram := range s.histograms {
+		result = append(result, NamedHistogram{Name: name, HistogramSnapshot: histogram.Snapshot()})
+	}
+	s.mutex.Unlock()
+
+	sort.Slice(result, func(i, j int) bool { return result[i].Name < result[j].Name })
+	return result
+}
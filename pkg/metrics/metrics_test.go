@@ -0,0 +1,67 @@
+package metrics
+
+import (
+	"fmt"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestHistogramQuantile is a function.
+func TestHistogramQuantile(t *testing.T) {
+	type scenario struct {
+		durations []time.Duration
+		expected  []time.Duration
+	}
+
+	scenarios := []scenario{
+		{
+			[]time.Duration{},
+			[]time.Duration{0, 0, 0},
+		},
+		{
+			// quantiles are the top of their bucket, unless nothing was that slow
+			[]time.Duration{50 * time.Microsecond, 150 * time.Microsecond, 150 * time.Microsecond, 2 * time.Millisecond},
+			[]time.Duration{200 * time.Microsecond, 2 * time.Millisecond, 2 * time.Millisecond},
+		},
+		{
+			// anything off the end of the buckets is only known by the slowest
+			[]time.Duration{time.Millisecond, time.Minute},
+			[]time.Duration{1600 * time.Microsecond, time.Minute, time.Minute},
+		},
+	}
+
+	for _, s := range scenarios {
+		histogram := Histogram{}
+		for _, d := range s.durations {
+			histogram.Observe(d)
+		}
+		snapshot := histogram.Snapshot()
+		assert.EqualValues(t, s.expected, []time.Duration{snapshot.Quantile(0.5), snapshot.Quantile(0.9), snapshot.Quantile(1)})
+		assert.EqualValues(t, len(s.durations), snapshot.Count)
+	}
+}
+
+// TestMetrics is a function.
+func TestMetrics(t *testing.T) {
+	var disabled *Metrics
+	disabled.ObserveAPI("GET /_ping", time.Millisecond)
+	disabled.StartLogProcess()()
+	assert.EqualValues(t, Snapshot{}, disabled.Snapshot())
+
+	m := New()
+	for i := 0; i < maxNames+10; i++ {
+		m.ObserveCommand(fmt.Sprintf("open file%d", i), time.Millisecond)
+	}
+	doneStreaming := m.StartStatsStream()
+	m.StartStatsStream()
+	doneStreaming()
+	doneStreaming()
+
+	snapshot := m.Snapshot()
+	assert.Len(t, snapshot.Commands, maxNames+1)
+	assert.EqualValues(t, otherName, snapshot.Commands[0].Name)
+	assert.EqualValues(t, 10, snapshot.Commands[0].Count)
+	assert.EqualValues(t, 1, snapshot.StatsStreams)
+}
@@ -0,0 +1,216 @@
+// Package profiling lets us look inside a lazydocker that's misbehaving on
+// someone's machine without rebuilding it: profiles and traces for the whole
+// run, a pprof endpoint to pull them from while it's running, and on-demand
+// captures to attach to an issue
+package profiling
+
+import (
+	"fmt"
+	"net"
+	"net/http"
+	"net/http/pprof"
+	"os"
+	"path/filepath"
+	"runtime"
+	runtimePprof "runtime/pprof"
+	"runtime/trace"
+	"strings"
+	"time"
+
+	"github.com/jesseduffield/lazydocker/pkg/tracing"
+)
+
+// unixPrefix marks a pprof address as the path of a unix socket
+const unixPrefix = "unix:"
+
+// Options says what to profile for the whole of a run. Empty fields are
+// switched off
+type Options struct {
+	// PprofAddr is where to serve net/http/pprof, either a loopback address like
+	// 'localhost:6060' or a unix socket like 'unix:/tmp/lazydocker.sock'
+	PprofAddr  string
+	CPUProfile string
+	MemProfile string
+	Trace      string
+	// Spans is where to write spans of our refreshes and renders, see the
+	// tracing package
+	Spans string
+}
+
+// Session is what's running for a set of Options, to be stopped when
+// lazydocker exits
+type Session struct {
+	options  Options
+	listener net.Listener
+	cpuFile  *os.File
+	trace    *os.File
+
+	// Tracer records spans if Options.Spans was given, and is nil otherwise
+	Tracer *tracing.Tracer
+}
+
+// Start starts whatever profiling the options ask for. Stop must be called to
+// write the profiles out, even if Start returns an error
+func Start(options Options) (*Session, error) {
+	s := &Session{options: options}
+
+	if options.PprofAddr != "" {
+		listener, err := listen(options.PprofAddr)
+		if err != nil {
+			return s, err
+		}
+		s.listener = listener
+		go func() {
+			_ = http.Serve(listener, handler())
+		}()
+	}
+
+	if options.CPUProfile != "" {
+		file, err := os.Create(options.CPUProfile)
+		if err != nil {
+			return s, err
+		}
+		s.cpuFile = file
+		if err := runtimePprof.StartCPUProfile(file); err != nil {
+			return s, err
+		}
+	}
+
+	if options.Trace != "" {
+		file, err := os.Create(options.Trace)
+		if err != nil {
+			return s, err
+		}
+		s.trace = file
+		if err := trace.Start(file); err != nil {
+			return s, err
+		}
+	}
+
+	if options.Spans != "" {
+		tracer, err := tracing.Open(options.Spans)
+		if err != nil {
+			return s, err
+		}
+		s.Tracer = tracer
+	}
+
+	return s, nil
+}
+
+// Stop finishes the profiles and spans, writes the heap profile if one was
+// asked for, and stops serving pprof
+func (s *Session) Stop() error {
+	if s.listener != nil {
+		s.listener.Close()
+	}
+	if s.cpuFile != nil {
+		runtimePprof.StopCPUProfile()
+		s.cpuFile.Close()
+	}
+	if s.trace != nil {
+		trace.Stop()
+		s.trace.Close()
+	}
+	err := s.Tracer.Close()
+	if s.options.MemProfile != "" {
+		if heapErr := writeHeapProfile(s.options.MemProfile); heapErr != nil {
+			return heapErr
+		}
+	}
+	return err
+}
+
+func writeHeapProfile(path string) error {
+	file, err := os.Create(path)
+	if err != nil {
+		return err
+	}
+	defer file.Close()
+
+	// so that the profile reflects what's live at the end, not what was live at
+	// the last collection
+	runtime.GC()
+	return runtimePprof.WriteHeapProfile(file)
+}
+
+// listen listens on a unix socket or a loopback address. pprof hands out our
+// memory, which can include environment variables and container details, so
+// we don't serve it to the network
+func listen(addr string) (net.Listener, error) {
+	if strings.HasPrefix(addr, unixPrefix) {
+		path := strings.TrimPrefix(addr, unixPrefix)
+		// a socket left behind by a lazydocker that didn't exit cleanly would stop
+		// us listening, but we don't want to remove anything that isn't a socket
+		if info, err := os.Lstat(path); err == nil && info.Mode()&os.ModeSocket != 0 {
+			os.Remove(path)
+		}
+		return net.Listen("unix", path)
+	}
+
+	host, _, err := net.SplitHostPort(addr)
+	if err != nil {
+		return nil, err
+	}
+	if !isLoopback(host) {
+		return nil, fmt.Errorf("pprof address %s isn't a loopback address or a unix socket, e.g. localhost:6060 or unix:/tmp/lazydocker.sock", addr)
+	}
+	return net.Listen("tcp", addr)
+}
+
+func isLoopback(host string) bool {
+	if host == "localhost" {
+		return true
+	}
+	ip := net.ParseIP(host)
+	return ip != nil && ip.IsLoopback()
+}
+
+func handler() http.Handler {
+	mux := http.NewServeMux()
+	mux.HandleFunc("/debug/pprof/", pprof.Index)
+	mux.HandleFunc("/debug/pprof/cmdline", pprof.Cmdline)
+	mux.HandleFunc("/debug/pprof/profile", pprof.Profile)
+	mux.HandleFunc("/debug/pprof/symbol", pprof.Symbol)
+	mux.HandleFunc("/debug/pprof/trace", pprof.Trace)
+	return mux
+}
+
+// Capture records a CPU profile and an execution trace for the given duration
+// into dir, returning the paths it wrote. It fails if either is already being
+// recorded, e.g. because lazydocker was started with --cpuprofile
+func Capture(dir string, duration time.Duration) (string, string, error) {
+	stamp := time.Now().Format("20060102-150405")
+	cpuPath := filepath.Join(dir, fmt.Sprintf("cpu-%s.pprof", stamp))
+	tracePath := filepath.Join(dir, fmt.Sprintf("trace-%s.out", stamp))
+
+	cpuFile, err := os.Create(cpuPath)
+	if err != nil {
+		return "", "", err
+	}
+	defer cpuFile.Close()
+
+	traceFile, err := os.Create(tracePath)
+	if err != nil {
+		return "", "", err
+	}
+	defer traceFile.Close()
+
+	if err := runtimePprof.StartCPUProfile(cpuFile); err != nil {
+		os.Remove(cpuPath)
+		os.Remove(tracePath)
+		return "", "", err
+	}
+	if err := trace.Start(traceFile); err != nil {
+		runtimePprof.StopCPUProfile()
+		os.Remove(cpuPath)
+		os.Remove(tracePath)
+		return "", "", err
+	}
+
+	time.Sleep(duration)
+
+	trace.Stop()
+	runtimePprof.StopCPUProfile()
+	return cpuPath, tracePath, nil
+}
@@ -0,0 +1,75 @@
+package profiling
+
+import (
+	"io/ioutil"
+	"os"
+	"testing"
+	"time"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestListen is a function.
+func TestListen(t *testing.T) {
+	type scenario struct {
+		addr                 string
+		expectedErrorMessage string
+	}
+
+	scenarios := []scenario{
+		{
+			"localhost:0",
+			"",
+		},
+		{
+			"127.0.0.1:0",
+			"",
+		},
+		{
+			"[::1]:0",
+			"",
+		},
+		{
+			":6060",
+			"pprof address :6060 isn't a loopback address or a unix socket, e.g. localhost:6060 or unix:/tmp/lazydocker.sock",
+		},
+		{
+			"0.0.0.0:6060",
+			"pprof address 0.0.0.0:6060 isn't a loopback address or a unix socket, e.g. localhost:6060 or unix:/tmp/lazydocker.sock",
+		},
+		{
+			"localhost",
+			"address localhost: missing port in address",
+		},
+	}
+
+	for _, s := range scenarios {
+		listener, err := listen(s.addr)
+		if s.expectedErrorMessage != "" {
+			assert.EqualError(t, err, s.expectedErrorMessage)
+			continue
+		}
+		if err != nil {
+			// e.g. no IPv6 on this machine
+			t.Logf("couldn't listen on %s: %s", s.addr, err)
+			continue
+		}
+		listener.Close()
+	}
+}
+
+// TestCapture is a function.
+func TestCapture(t *testing.T) {
+	dir, err := ioutil.TempDir("", "lazydocker-profiling")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	cpuPath, tracePath, err := Capture(dir, 10*time.Millisecond)
+	assert.NoError(t, err)
+
+	for _, path := range []string{cpuPath, tracePath} {
+		info, err := os.Stat(path)
+		assert.NoError(t, err)
+		assert.NotZero(t, info.Size())
+	}
+}
@@ -0,0 +1,291 @@
+package tasks
+
+import (
+	"io"
+	"sync"
+	"time"
+
+	"github.com/sirupsen/logrus"
+)
+
+// JobStatus tells us where a job is up to
+type JobStatus string
+
+const (
+	JobQueued    JobStatus = "queued"
+	JobRunning   JobStatus = "running"
+	JobSucceeded JobStatus = "done"
+	JobFailed    JobStatus = "failed"
+	JobCancelled JobStatus = "cancelled"
+)
+
+// JobManager runs long-running operations (pulls, builds, etc) in the
+// background so that they don't need to take over the terminal. Unlike the
+// TaskManager, which only ever has one task running at a time (whatever is
+// being shown in the main panel), the JobManager runs several jobs at once,
+// up to a limit, and queues the rest.
+type JobManager struct {
+	Log            *logrus.Entry
+	maxOutputLines int
+	maxFinished    int
+	slots          chan struct{}
+	mutex          sync.Mutex
+	jobs           []*Job
+	nextID         int
+	version        int
+}
+
+// Job is a single operation run by the JobManager. Its output is kept in a
+// bounded buffer so that a chatty build can't eat all our memory.
+type Job struct {
+	ID         int
+	Name       string
+	Status     JobStatus
+	Err        error
+	QueuedAt   time.Time
+	StartedAt  time.Time
+	FinishedAt time.Time
+
+	manager *JobManager
+	stop    chan struct{}
+	// done is closed once the job has finished, by which point any process it
+	// ran has exited
+	done   chan struct{}
+	output *OutputBuffer
+}
+
+// NewJobManager returns a job manager which runs at most maxConcurrent jobs at
+// once and keeps the last maxOutputLines lines of output from each job
+func NewJobManager(log *logrus.Entry, maxConcurrent int, maxOutputLines int) *JobManager {
+	if maxConcurrent < 1 {
+		maxConcurrent = 1
+	}
+	return &JobManager{
+		Log:            log,
+		maxOutputLines: maxOutputLines,
+		maxFinished:    20,
+		slots:          make(chan struct{}, maxConcurrent),
+	}
+}
+
+// NewJob queues up f to be run in the background. f should write its output to
+// out and return as soon as it can once the stop channel is closed.
+func (m *JobManager) NewJob(name string, f func(stop chan struct{}, out io.Writer) error) *Job {
+	m.mutex.Lock()
+	m.nextID++
+	job := &Job{
+		ID:       m.nextID,
+		Name:     name,
+		Status:   JobQueued,
+		QueuedAt: time.Now(),
+		manager:  m,
+		stop:     make(chan struct{}),
+		done:     make(chan struct{}),
+		output:   NewOutputBuffer(m.maxOutputLines),
+	}
+	m.jobs = append(m.jobs, job)
+	m.forgetOldJobs()
+	m.version++
+	m.mutex.Unlock()
+
+	go func() {
+		select {
+		case m.slots <- struct{}{}:
+		case <-job.stop:
+			m.finish(job, nil)
+			return
+		}
+		defer func() { <-m.slots }()
+
+		m.mutex.Lock()
+		job.Status = JobRunning
+		job.StartedAt = time.Now()
+		m.version++
+		m.mutex.Unlock()
+
+		m.Log.Infof("running job %d: %s", job.ID, job.Name)
+		err := f(job.stop, job)
+		m.finish(job, err)
+	}()
+
+	return job
+}
+
+func (m *JobManager) finish(job *Job, err error) {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	job.output.Flush()
+	job.FinishedAt = time.Now()
+	job.Err = err
+	select {
+	case <-job.stop:
+		job.Status = JobCancelled
+	default:
+		if err != nil {
+			job.Status = JobFailed
+		} else {
+			job.Status = JobSucceeded
+		}
+	}
+	m.version++
+	m.Log.Infof("job %d finished with status %s", job.ID, job.Status)
+	close(job.done)
+}
+
+// forgetOldJobs drops the oldest finished jobs once we have more than we care
+// to display. It must be called with the mutex held.
+func (m *JobManager) forgetOldJobs() {
+	finished := 0
+	for _, job := range m.jobs {
+		if job.isFinished() {
+			finished++
+		}
+	}
+
+	jobs := m.jobs[:0]
+	for _, job := range m.jobs {
+		if job.isFinished() && finished > m.maxFinished {
+			finished--
+			continue
+		}
+		jobs = append(jobs, job)
+	}
+	m.jobs = jobs
+}
+
+// Jobs returns a snapshot of the jobs we know about, oldest first
+func (m *JobManager) Jobs() []Job {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	jobs := make([]Job, len(m.jobs))
+	for i, job := range m.jobs {
+		jobs[i] = Job{
+			ID:         job.ID,
+			Name:       job.Name,
+			Status:     job.Status,
+			Err:        job.Err,
+			QueuedAt:   job.QueuedAt,
+			StartedAt:  job.StartedAt,
+			FinishedAt: job.FinishedAt,
+			output:     job.output,
+		}
+	}
+	return jobs
+}
+
+// Version is bumped every time a job changes status or writes output, so that
+// callers can tell whether they need to re-render anything
+func (m *JobManager) Version() int {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+	return m.version
+}
+
+// ActiveCount returns the number of jobs which are queued or running
+func (m *JobManager) ActiveCount() int {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+
+	count := 0
+	for _, job := range m.jobs {
+		if !job.isFinished() {
+			count++
+		}
+	}
+	return count
+}
+
+// CancelLatest cancels the most recently created job that hasn't finished yet,
+// returning false if there was no such job
+func (m *JobManager) CancelLatest() bool {
+	m.mutex.Lock()
+	var latest *Job
+	for _, job := range m.jobs {
+		if !job.isFinished() {
+			latest = job
+		}
+	}
+	m.mutex.Unlock()
+
+	if latest == nil {
+		return false
+	}
+	latest.Cancel()
+	return true
+}
+
+// CancelAll cancels every job that hasn't finished yet, and waits up to
+// timeout for them to finish. This is called when lazydocker is closing so we
+// don't leave child processes behind. It returns false if any of the jobs were
+// still going when we gave up waiting
+func (m *JobManager) CancelAll(timeout time.Duration) bool {
+	m.mutex.Lock()
+	jobs := append([]*Job{}, m.jobs...)
+	m.mutex.Unlock()
+
+	for _, job := range jobs {
+		job.Cancel()
+	}
+
+	deadline := time.NewTimer(timeout)
+	defer deadline.Stop()
+	for _, job := range jobs {
+		select {
+		case <-job.done:
+		case <-deadline.C:
+			m.Log.Warnf("gave up waiting for job %d (%s) to stop", job.ID, job.Name)
+			return false
+		}
+	}
+	return true
+}
+
+// Cancel asks the job to stop. It is safe to call this more than once
+func (j *Job) Cancel() {
+	j.manager.mutex.Lock()
+	defer j.manager.mutex.Unlock()
+
+	if j.isFinished() {
+		return
+	}
+	select {
+	case <-j.stop:
+	default:
+		close(j.stop)
+	}
+}
+
+func (j *Job) isFinished() bool {
+	return !j.FinishedAt.IsZero()
+}
+
+// Write appends to the job's output
+func (j *Job) Write(p []byte) (int, error) {
+	n, err := j.output.Write(p)
+
+	m := j.manager
+	m.mutex.Lock()
+	m.version++
+	m.mutex.Unlock()
+
+	return n, err
+}
+
+// Output returns the job's output (or as much of it as we've kept)
+func (j *Job) Output() string {
+	return j.output.String()
+}
+
+// Duration returns how long the job has been running for, or how long it ran
+// for if it has finished
+func (j *Job) Duration() time.Duration {
+	if j.StartedAt.IsZero() {
+		return 0
+	}
+	if j.FinishedAt.IsZero() {
+		return time.Since(j.StartedAt)
+	}
+	return j.FinishedAt.Sub(j.StartedAt)
+}
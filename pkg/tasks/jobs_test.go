@@ -0,0 +1,160 @@
+package tasks
+
+import (
+	"errors"
+	"fmt"
+	"io"
+	"io/ioutil"
+	"sync"
+	"testing"
+	"time"
+
+	"github.com/sirupsen/logrus"
+	"github.com/stretchr/testify/assert"
+)
+
+func newDummyJobManager(maxConcurrent int, maxOutputLines int) *JobManager {
+	log := logrus.New()
+	log.Out = ioutil.Discard
+	return NewJobManager(logrus.NewEntry(log), maxConcurrent, maxOutputLines)
+}
+
+func waitForJobs(t *testing.T, m *JobManager) []Job {
+	for i := 0; i < 200; i++ {
+		if m.ActiveCount() == 0 {
+			return m.Jobs()
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	t.Fatal("timed out waiting for jobs to finish")
+	return nil
+}
+
+func waitForStart(t *testing.T, m *JobManager, index int) {
+	for i := 0; i < 200; i++ {
+		if m.Jobs()[index].Status == JobRunning {
+			return
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	t.Fatal("timed out waiting for job to start")
+}
+
+// TestJobManagerRunsJobs is a function.
+func TestJobManagerRunsJobs(t *testing.T) {
+	m := newDummyJobManager(2, 100)
+
+	m.NewJob("ok", func(stop chan struct{}, out io.Writer) error {
+		fmt.Fprint(out, "line one\nline ")
+		fmt.Fprint(out, "two\nunterminated")
+		return nil
+	})
+	m.NewJob("broken", func(stop chan struct{}, out io.Writer) error {
+		return errors.New("oh no")
+	})
+
+	jobs := waitForJobs(t, m)
+	assert.Len(t, jobs, 2)
+	assert.EqualValues(t, JobSucceeded, jobs[0].Status)
+	assert.EqualValues(t, "line one\nline two\nunterminated", jobs[0].Output())
+	assert.EqualValues(t, JobFailed, jobs[1].Status)
+	assert.EqualError(t, jobs[1].Err, "oh no")
+}
+
+// TestJobManagerLimitsConcurrency is a function.
+func TestJobManagerLimitsConcurrency(t *testing.T) {
+	m := newDummyJobManager(2, 100)
+
+	var mutex sync.Mutex
+	running := 0
+	maxRunning := 0
+
+	for i := 0; i < 6; i++ {
+		m.NewJob("job", func(stop chan struct{}, out io.Writer) error {
+			mutex.Lock()
+			running++
+			if running > maxRunning {
+				maxRunning = running
+			}
+			mutex.Unlock()
+
+			time.Sleep(5 * time.Millisecond)
+
+			mutex.Lock()
+			running--
+			mutex.Unlock()
+			return nil
+		})
+	}
+
+	waitForJobs(t, m)
+	assert.EqualValues(t, 2, maxRunning)
+}
+
+// TestJobManagerCancelsJobs is a function.
+func TestJobManagerCancelsJobs(t *testing.T) {
+	m := newDummyJobManager(1, 100)
+
+	blocker := func(stop chan struct{}, out io.Writer) error {
+		<-stop
+		return errors.New("killed")
+	}
+	running := m.NewJob("running", blocker)
+	queued := m.NewJob("queued", blocker)
+
+	assert.True(t, m.CancelLatest())
+	running.Cancel()
+
+	jobs := waitForJobs(t, m)
+	assert.EqualValues(t, JobCancelled, jobs[0].Status)
+	assert.EqualValues(t, JobCancelled, jobs[1].Status)
+	assert.False(t, m.CancelLatest())
+
+	// cancelling a finished job is a no-op
+	queued.Cancel()
+}
+
+// TestJobManagerCancelAllWaits is a function.
+func TestJobManagerCancelAllWaits(t *testing.T) {
+	m := newDummyJobManager(2, 100)
+
+	exited := make(chan struct{})
+	m.NewJob("slow to stop", func(stop chan struct{}, out io.Writer) error {
+		<-stop
+		time.Sleep(50 * time.Millisecond)
+		close(exited)
+		return nil
+	})
+	m.NewJob("queued", func(stop chan struct{}, out io.Writer) error { return nil })
+	waitForStart(t, m, 0)
+
+	assert.True(t, m.CancelAll(time.Second))
+	select {
+	case <-exited:
+	default:
+		t.Error("CancelAll returned before the job had stopped")
+	}
+
+	m.NewJob("stubborn", func(stop chan struct{}, out io.Writer) error {
+		time.Sleep(time.Second)
+		return nil
+	})
+	waitForStart(t, m, 2)
+	assert.False(t, m.CancelAll(50*time.Millisecond))
+}
+
+// TestJobOutputIsBounded is a function.
+func TestJobOutputIsBounded(t *testing.T) {
+	m := newDummyJobManager(1, 3)
+
+	m.NewJob("chatty", func(stop chan struct{}, out io.Writer) error {
+		for i := 0; i < 10; i++ {
+			fmt.Fprintf(out, "%d\n", i)
+		}
+		fmt.Fprint(out, "downloading 10%\rdownloading 50%\rdownloading 100%\n")
+		return nil
+	})
+
+	jobs := waitForJobs(t, m)
+	assert.EqualValues(t, "8\n9\ndownloading 100%", jobs[0].Output())
+}
@@ -0,0 +1,104 @@
+package tasks
+
+import (
+	"bytes"
+	"strings"
+	"sync"
+)
+
+// OutputBuffer holds the output of a command, keeping only the last so-many
+// lines so that a chatty command can't eat all our memory. It is safe to write
+// to it from one goroutine while reading it from another.
+type OutputBuffer struct {
+	mutex    sync.Mutex
+	maxLines int
+	lines    []string
+	partial  bytes.Buffer
+	version  int
+}
+
+// NewOutputBuffer returns a buffer which keeps the last maxLines lines written
+// to it. If maxLines is zero, it keeps everything
+func NewOutputBuffer(maxLines int) *OutputBuffer {
+	return &OutputBuffer{maxLines: maxLines}
+}
+
+// Write appends to the buffer, dropping the oldest lines once we go over the
+// limit
+func (b *OutputBuffer) Write(p []byte) (int, error) {
+	b.mutex.Lock()
+	defer b.mutex.Unlock()
+
+	b.partial.Write(p)
+	for {
+		line, err := b.partial.ReadString('\n')
+		if err != nil {
+			// no newline yet: put the remainder back and wait for more
+			b.partial.Reset()
+			b.partial.WriteString(line)
+			break
+		}
+		b.appendLine(strings.TrimSuffix(line, "\n"))
+	}
+	b.version++
+
+	return len(p), nil
+}
+
+// Flush treats whatever has been written since the last newline as a line of
+// its own. This is called once the command is done
+func (b *OutputBuffer) Flush() {
+	b.mutex.Lock()
+	defer b.mutex.Unlock()
+
+	if b.partial.Len() > 0 {
+		b.appendLine(b.partial.String())
+		b.partial.Reset()
+		b.version++
+	}
+}
+
+func (b *OutputBuffer) appendLine(line string) {
+	b.lines = append(b.lines, lastRedraw(line))
+
+	// we let the buffer grow to twice the limit before trimming it so that we're
+	// not copying the whole thing on every line. We copy rather than reslice so
+	// that the dropped lines can be garbage collected
+	if b.maxLines > 0 && len(b.lines) >= b.maxLines*2 {
+		b.lines = append([]string{}, b.lines[len(b.lines)-b.maxLines:]...)
+	}
+}
+
+// lastRedraw returns whatever was drawn last on a line. Progress bars redraw
+// themselves with carriage returns so we only want the last one
+func lastRedraw(line string) string {
+	line = strings.TrimSuffix(line, "\r")
+	if i := strings.LastIndex(line, "\r"); i != -1 {
+		return line[i+1:]
+	}
+	return line
+}
+
+// String returns the output (or as much of it as we've kept), including any
+// line that's still being written
+func (b *OutputBuffer) String() string {
+	b.mutex.Lock()
+	defer b.mutex.Unlock()
+
+	lines := b.lines
+	if b.maxLines > 0 && len(lines) > b.maxLines {
+		lines = lines[len(lines)-b.maxLines:]
+	}
+	if b.partial.Len() > 0 {
+		lines = append(lines[:len(lines):len(lines)], lastRedraw(b.partial.String()))
+	}
+	return strings.Join(lines, "\n")
+}
+
+// Version is bumped every time something is written, so that callers can tell
+// whether they need to re-render the output
+func (b *OutputBuffer) Version() int {
+	b.mutex.Lock()
+	defer b.mutex.Unlock()
+	return b.version
+}
@@ -0,0 +1,26 @@
+package tasks
+
+import (
+	"fmt"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestOutputBuffer is a function.
+func TestOutputBuffer(t *testing.T) {
+	b := NewOutputBuffer(2)
+	assert.EqualValues(t, "", b.String())
+
+	fmt.Fprint(b, "one\ntwo\nthr")
+	// the line that's still being written is shown but isn't kept yet
+	assert.EqualValues(t, "one\ntwo\nthr", b.String())
+
+	fmt.Fprint(b, "ee\n10%\r50%")
+	assert.EqualValues(t, "two\nthree\n50%", b.String())
+
+	version := b.Version()
+	b.Flush()
+	assert.EqualValues(t, "three\n50%", b.String())
+	assert.True(t, b.Version() > version)
+}
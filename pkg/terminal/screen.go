@@ -0,0 +1,687 @@
+// Package terminal is a small VT100/xterm emulator. It interprets the output
+// of a program running in a pseudo-terminal (e.g. a shell exec'd inside a
+// container) and keeps a grid of cells that we can render into a gocui view.
+// It only supports the subset of escape sequences that shells and common
+// full-screen programs (top, less, vi) actually use, and only the colours
+// that gocui can display.
+package terminal
+
+import (
+	"strconv"
+	"strings"
+	"sync"
+	"unicode/utf8"
+)
+
+// Attr describes how a cell is drawn. Fg and Bg are ANSI colour numbers from 0
+// to 7, or -1 for the terminal default
+type Attr struct {
+	Fg        int
+	Bg        int
+	Bold      bool
+	Underline bool
+	Reverse   bool
+}
+
+var defaultAttr = Attr{Fg: -1, Bg: -1}
+
+// Cell is a single character on the screen
+type Cell struct {
+	Ch   rune
+	Attr Attr
+}
+
+type parserState int
+
+const (
+	stateGround parserState = iota
+	stateEscape
+	stateCharset
+	stateCSI
+	stateOSC
+	stateOSCEscape
+)
+
+// Screen holds the state of the emulated terminal. It implements io.Writer so
+// the output of a program can be copied straight into it. It is safe to write
+// to and render a Screen from different goroutines
+type Screen struct {
+	mutex sync.Mutex
+
+	width  int
+	height int
+	cells  [][]Cell
+
+	cursorX       int
+	cursorY       int
+	cursorVisible bool
+	savedX        int
+	savedY        int
+	// wrapNext is set when we've written to the last column. The cursor stays
+	// put until the next character arrives, which then goes on a new line
+	wrapNext bool
+
+	attr Attr
+	// newlineMode makes line feeds return the cursor to the first column too,
+	// which is what programs that aren't running in a pseudo-terminal expect
+	newlineMode  bool
+	scrollTop    int
+	scrollBottom int
+
+	// mainCells holds the normal screen while a program is using the alternate
+	// screen (e.g. while vi is open)
+	mainCells [][]Cell
+
+	state     parserState
+	csiParams []byte
+	utf8Buf   []byte
+
+	dirty bool
+}
+
+// NewScreen returns a blank screen of the given size
+func NewScreen(width, height int) *Screen {
+	s := &Screen{cursorVisible: true, attr: defaultAttr}
+	s.resize(width, height)
+	return s
+}
+
+// SetNewlineMode sets whether a line feed also acts as a carriage return
+func (s *Screen) SetNewlineMode(enabled bool) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+	s.newlineMode = enabled
+}
+
+// Size returns the width and height of the screen
+func (s *Screen) Size() (int, int) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+	return s.width, s.height
+}
+
+// Resize changes the size of the screen, keeping as much of its content as
+// fits. Lines are dropped from the top if the screen gets shorter so that the
+// cursor stays on screen
+func (s *Screen) Resize(width, height int) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+	s.resize(width, height)
+}
+
+func (s *Screen) resize(width, height int) {
+	if width < 1 {
+		width = 1
+	}
+	if height < 1 {
+		height = 1
+	}
+
+	if overflow := s.cursorY - (height - 1); overflow > 0 {
+		s.cells = s.cells[overflow:]
+		s.cursorY -= overflow
+	}
+
+	cells := make([][]Cell, height)
+	for y := range cells {
+		cells[y] = s.blankLine(width)
+		if y < len(s.cells) {
+			copy(cells[y], s.cells[y])
+		}
+	}
+	s.cells = cells
+	s.mainCells = nil
+	s.width = width
+	s.height = height
+	s.scrollTop = 0
+	s.scrollBottom = height - 1
+	s.cursorX = clamp(s.cursorX, 0, width-1)
+	s.cursorY = clamp(s.cursorY, 0, height-1)
+	s.wrapNext = false
+	s.dirty = true
+}
+
+// Write interprets the given output, updating the screen
+func (s *Screen) Write(p []byte) (int, error) {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	for _, b := range p {
+		s.parse(b)
+	}
+	s.dirty = true
+
+	return len(p), nil
+}
+
+// TakeDirty reports whether the screen has changed since the last call
+func (s *Screen) TakeDirty() bool {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	dirty := s.dirty
+	s.dirty = false
+	return dirty
+}
+
+func (s *Screen) parse(b byte) {
+	switch s.state {
+	case stateGround:
+		if b < 0x20 || b == 0x7f {
+			s.control(b)
+			return
+		}
+		s.utf8Buf = append(s.utf8Buf, b)
+		if !utf8.FullRune(s.utf8Buf) {
+			return
+		}
+		r, _ := utf8.DecodeRune(s.utf8Buf)
+		s.utf8Buf = s.utf8Buf[:0]
+		s.print(r)
+
+	case stateEscape:
+		s.state = stateGround
+		switch b {
+		case '[':
+			s.state = stateCSI
+			s.csiParams = s.csiParams[:0]
+		case ']':
+			s.state = stateOSC
+		case '(', ')', '*', '+', '#':
+			s.state = stateCharset
+		case '7':
+			s.savedX, s.savedY = s.cursorX, s.cursorY
+		case '8':
+			s.moveTo(s.savedX, s.savedY)
+		case 'D':
+			s.lineFeed()
+		case 'E':
+			s.cursorX = 0
+			s.lineFeed()
+		case 'M':
+			s.reverseIndex()
+		case 'c':
+			s.reset()
+		}
+
+	case stateCharset:
+		// we only support the one character set so we skip the designator
+		s.state = stateGround
+
+	case stateCSI:
+		switch {
+		case b >= 0x40 && b <= 0x7e:
+			s.state = stateGround
+			s.dispatchCSI(b)
+		case b == 0x1b:
+			s.state = stateEscape
+		case b < 0x20:
+			s.control(b)
+		default:
+			s.csiParams = append(s.csiParams, b)
+		}
+
+	case stateOSC:
+		// OSC sequences set things like the window title, which we ignore
+		switch b {
+		case 0x07:
+			s.state = stateGround
+		case 0x1b:
+			s.state = stateOSCEscape
+		}
+
+	case stateOSCEscape:
+		s.state = stateGround
+	}
+}
+
+func (s *Screen) control(b byte) {
+	switch b {
+	case '\b':
+		s.wrapNext = false
+		if s.cursorX > 0 {
+			s.cursorX--
+		}
+	case '\t':
+		s.wrapNext = false
+		s.cursorX = clamp((s.cursorX/8+1)*8, 0, s.width-1)
+	case '\n', '\v', '\f':
+		s.wrapNext = false
+		if s.newlineMode {
+			s.cursorX = 0
+		}
+		s.lineFeed()
+	case '\r':
+		s.wrapNext = false
+		s.cursorX = 0
+	case 0x1b:
+		s.state = stateEscape
+	}
+}
+
+func (s *Screen) print(r rune) {
+	if s.wrapNext {
+		s.wrapNext = false
+		s.cursorX = 0
+		s.lineFeed()
+	}
+
+	s.cells[s.cursorY][s.cursorX] = Cell{Ch: r, Attr: s.attr}
+
+	if s.cursorX == s.width-1 {
+		s.wrapNext = true
+	} else {
+		s.cursorX++
+	}
+}
+
+func (s *Screen) lineFeed() {
+	if s.cursorY == s.scrollBottom {
+		s.scrollUp(1)
+	} else if s.cursorY < s.height-1 {
+		s.cursorY++
+	}
+}
+
+func (s *Screen) reverseIndex() {
+	if s.cursorY == s.scrollTop {
+		s.scrollDown(1)
+	} else if s.cursorY > 0 {
+		s.cursorY--
+	}
+}
+
+// scrollUp moves the lines in the scroll region up by n, leaving blank lines
+// at the bottom
+func (s *Screen) scrollUp(n int) {
+	s.deleteLinesAt(s.scrollTop, n)
+}
+
+// scrollDown moves the lines in the scroll region down by n, leaving blank
+// lines at the top
+func (s *Screen) scrollDown(n int) {
+	s.insertLinesAt(s.scrollTop, n)
+}
+
+func (s *Screen) deleteLinesAt(y int, n int) {
+	n = clamp(n, 0, s.scrollBottom-y+1)
+	region := s.cells[y : s.scrollBottom+1]
+	copy(region, region[n:])
+	for i := len(region) - n; i < len(region); i++ {
+		region[i] = s.blankLine(s.width)
+	}
+}
+
+func (s *Screen) insertLinesAt(y int, n int) {
+	n = clamp(n, 0, s.scrollBottom-y+1)
+	region := s.cells[y : s.scrollBottom+1]
+	copy(region[n:], region)
+	for i := 0; i < n; i++ {
+		region[i] = s.blankLine(s.width)
+	}
+}
+
+func (s *Screen) blankLine(width int) []Cell {
+	line := make([]Cell, width)
+	for x := range line {
+		line[x] = s.blankCell()
+	}
+	return line
+}
+
+// blankCell is what's left behind when something is erased. Like xterm, we
+// keep the current background colour
+func (s *Screen) blankCell() Cell {
+	return Cell{Ch: ' ', Attr: Attr{Fg: -1, Bg: s.attr.Bg}}
+}
+
+func (s *Screen) eraseCells(y, from, to int) {
+	from = clamp(from, 0, s.width)
+	to = clamp(to, 0, s.width)
+	for x := from; x < to; x++ {
+		s.cells[y][x] = s.blankCell()
+	}
+}
+
+func (s *Screen) moveTo(x, y int) {
+	s.wrapNext = false
+	s.cursorX = clamp(x, 0, s.width-1)
+	s.cursorY = clamp(y, 0, s.height-1)
+}
+
+func (s *Screen) reset() {
+	s.attr = defaultAttr
+	s.mainCells = nil
+	s.cells = nil
+	s.cursorX, s.cursorY = 0, 0
+	s.cursorVisible = true
+	s.resize(s.width, s.height)
+}
+
+// params parses the numeric parameters of a CSI sequence. Missing parameters
+// are given the default value
+func (s *Screen) params(defaultValue int) (bool, []int) {
+	raw := string(s.csiParams)
+	private := strings.HasPrefix(raw, "?") || strings.HasPrefix(raw, ">")
+	raw = strings.TrimLeft(raw, "?>=")
+
+	params := []int{}
+	for _, field := range strings.Split(raw, ";") {
+		n, err := strconv.Atoi(field)
+		if err != nil {
+			n = defaultValue
+		}
+		params = append(params, n)
+	}
+	return private, params
+}
+
+func (s *Screen) dispatchCSI(final byte) {
+	private, params := s.params(1)
+	n := params[0]
+	if n < 1 {
+		n = 1
+	}
+
+	switch final {
+	case 'A':
+		s.moveTo(s.cursorX, s.cursorY-n)
+	case 'B', 'e':
+		s.moveTo(s.cursorX, s.cursorY+n)
+	case 'C', 'a':
+		s.moveTo(s.cursorX+n, s.cursorY)
+	case 'D':
+		s.moveTo(s.cursorX-n, s.cursorY)
+	case 'E':
+		s.moveTo(0, s.cursorY+n)
+	case 'F':
+		s.moveTo(0, s.cursorY-n)
+	case 'G', '`':
+		s.moveTo(n-1, s.cursorY)
+	case 'd':
+		s.moveTo(s.cursorX, n-1)
+	case 'H', 'f':
+		col := 1
+		if len(params) > 1 {
+			col = params[1]
+		}
+		s.moveTo(col-1, n-1)
+	case 'J':
+		s.eraseDisplay(s.mode())
+	case 'K':
+		s.eraseLine(s.mode())
+	case 'L':
+		if s.cursorY >= s.scrollTop && s.cursorY <= s.scrollBottom {
+			s.insertLinesAt(s.cursorY, n)
+		}
+	case 'M':
+		if s.cursorY >= s.scrollTop && s.cursorY <= s.scrollBottom {
+			s.deleteLinesAt(s.cursorY, n)
+		}
+	case '@':
+		line := s.cells[s.cursorY]
+		n = clamp(n, 0, s.width-s.cursorX)
+		copy(line[s.cursorX+n:], line[s.cursorX:])
+		s.eraseCells(s.cursorY, s.cursorX, s.cursorX+n)
+	case 'P':
+		line := s.cells[s.cursorY]
+		n = clamp(n, 0, s.width-s.cursorX)
+		copy(line[s.cursorX:], line[s.cursorX+n:])
+		s.eraseCells(s.cursorY, s.width-n, s.width)
+	case 'X':
+		s.eraseCells(s.cursorY, s.cursorX, s.cursorX+n)
+	case 'S':
+		s.scrollUp(n)
+	case 'T':
+		s.scrollDown(n)
+	case 'm':
+		_, params := s.params(0)
+		s.setGraphicsRendition(params)
+	case 'r':
+		top, bottom := 1, s.height
+		if len(params) > 0 && params[0] > 0 {
+			top = params[0]
+		}
+		if len(params) > 1 && params[1] > 0 {
+			bottom = params[1]
+		}
+		if top < bottom && bottom <= s.height {
+			s.scrollTop = top - 1
+			s.scrollBottom = bottom - 1
+		}
+		s.moveTo(0, 0)
+	case 's':
+		s.savedX, s.savedY = s.cursorX, s.cursorY
+	case 'u':
+		s.moveTo(s.savedX, s.savedY)
+	case 'h', 'l':
+		if private {
+			s.setPrivateModes(params, final == 'h')
+		} else if params[0] == 20 {
+			s.newlineMode = final == 'h'
+		}
+	}
+}
+
+// mode returns the first parameter of a CSI sequence, which defaults to 0
+// rather than 1 for the erase commands
+func (s *Screen) mode() int {
+	_, params := s.params(0)
+	return params[0]
+}
+
+func (s *Screen) eraseDisplay(mode int) {
+	switch mode {
+	case 0:
+		s.eraseLine(0)
+		for y := s.cursorY + 1; y < s.height; y++ {
+			s.eraseCells(y, 0, s.width)
+		}
+	case 1:
+		s.eraseLine(1)
+		for y := 0; y < s.cursorY; y++ {
+			s.eraseCells(y, 0, s.width)
+		}
+	case 2, 3:
+		for y := 0; y < s.height; y++ {
+			s.eraseCells(y, 0, s.width)
+		}
+	}
+}
+
+func (s *Screen) eraseLine(mode int) {
+	switch mode {
+	case 0:
+		s.eraseCells(s.cursorY, s.cursorX, s.width)
+	case 1:
+		s.eraseCells(s.cursorY, 0, s.cursorX+1)
+	case 2:
+		s.eraseCells(s.cursorY, 0, s.width)
+	}
+}
+
+func (s *Screen) setPrivateModes(params []int, enabled bool) {
+	for _, param := range params {
+		switch param {
+		case 25:
+			s.cursorVisible = enabled
+		case 47, 1047, 1049:
+			s.useAlternateScreen(enabled)
+		}
+	}
+}
+
+func (s *Screen) useAlternateScreen(enabled bool) {
+	if enabled == (s.mainCells != nil) {
+		return
+	}
+
+	if enabled {
+		s.savedX, s.savedY = s.cursorX, s.cursorY
+		s.mainCells = s.cells
+		s.cells = make([][]Cell, s.height)
+		for y := range s.cells {
+			s.cells[y] = s.blankLine(s.width)
+		}
+		return
+	}
+
+	s.cells = s.mainCells
+	s.mainCells = nil
+	s.moveTo(s.savedX, s.savedY)
+}
+
+func (s *Screen) setGraphicsRendition(params []int) {
+	for i := 0; i < len(params); i++ {
+		p := params[i]
+		switch {
+		case p == 0:
+			s.attr = defaultAttr
+		case p == 1:
+			s.attr.Bold = true
+		case p == 4:
+			s.attr.Underline = true
+		case p == 7:
+			s.attr.Reverse = true
+		case p == 22:
+			s.attr.Bold = false
+		case p == 24:
+			s.attr.Underline = false
+		case p == 27:
+			s.attr.Reverse = false
+		case p >= 30 && p <= 37:
+			s.attr.Fg = p - 30
+		case p == 39:
+			s.attr.Fg = -1
+		case p >= 40 && p <= 47:
+			s.attr.Bg = p - 40
+		case p == 49:
+			s.attr.Bg = -1
+		case p >= 90 && p <= 97:
+			// we can only show the eight basic colours, so bright ones are bold
+			s.attr.Fg = p - 90
+			s.attr.Bold = true
+		case p >= 100 && p <= 107:
+			s.attr.Bg = p - 100
+		case p == 38 || p == 48:
+			color, consumed := extendedColor(params[i+1:])
+			i += consumed
+			if p == 38 {
+				s.attr.Fg = color
+			} else {
+				s.attr.Bg = color
+			}
+		}
+	}
+}
+
+// extendedColor approximates a 256-colour (5;n) or truecolour (2;r;g;b)
+// parameter with one of the eight basic colours, returning the colour and the
+// number of parameters consumed
+func extendedColor(params []int) (int, int) {
+	if len(params) >= 2 && params[0] == 5 {
+		n := params[1]
+		switch {
+		case n < 8:
+			return n, 2
+		case n < 16:
+			return n - 8, 2
+		case n < 232:
+			n -= 16
+			return rgbToBasic(n/36*51, n/6%6*51, n%6*51), 2
+		default:
+			return -1, 2
+		}
+	}
+	if len(params) >= 4 && params[0] == 2 {
+		return rgbToBasic(params[1], params[2], params[3]), 4
+	}
+	return -1, len(params)
+}
+
+func rgbToBasic(r, g, b int) int {
+	color := 0
+	if r > 127 {
+		color |= 1
+	}
+	if g > 127 {
+		color |= 2
+	}
+	if b > 127 {
+		color |= 4
+	}
+	return color
+}
+
+// Render returns the contents of the screen as lines of text with ANSI colour
+// codes that gocui understands. The cursor is drawn in reverse video
+func (s *Screen) Render() string {
+	s.mutex.Lock()
+	defer s.mutex.Unlock()
+
+	var builder strings.Builder
+	for y, line := range s.cells {
+		if y > 0 {
+			builder.WriteByte('\n')
+		}
+
+		// we don't want to write trailing whitespace unless the cursor's there
+		end := len(line)
+		for end > 0 && line[end-1].Ch == ' ' && line[end-1].Attr == defaultAttr && !(s.cursorVisible && y == s.cursorY && end-1 == s.cursorX) {
+			end--
+		}
+
+		current := defaultAttr
+		for x := 0; x < end; x++ {
+			cell := line[x]
+			attr := cell.Attr
+			if s.cursorVisible && y == s.cursorY && x == s.cursorX {
+				attr.Reverse = !attr.Reverse
+			}
+			if attr != current {
+				builder.WriteString(sgr(attr))
+				current = attr
+			}
+			if cell.Ch == 0 {
+				builder.WriteRune(' ')
+			} else {
+				builder.WriteRune(cell.Ch)
+			}
+		}
+		if current != defaultAttr {
+			builder.WriteString("\x1b[0m")
+		}
+	}
+
+	return builder.String()
+}
+
+func sgr(attr Attr) string {
+	codes := []string{"0"}
+	if attr.Bold {
+		codes = append(codes, "1")
+	}
+	if attr.Underline {
+		codes = append(codes, "4")
+	}
+	if attr.Reverse {
+		codes = append(codes, "7")
+	}
+	if attr.Fg >= 0 {
+		codes = append(codes, strconv.Itoa(30+attr.Fg))
+	}
+	if attr.Bg >= 0 {
+		codes = append(codes, strconv.Itoa(40+attr.Bg))
+	}
+	return "\x1b[" + strings.Join(codes, ";") + "m"
+}
+
+func clamp(n, min, max int) int {
+	if n < min {
+		return min
+	}
+	if n > max {
+		return max
+	}
+	return n
+}
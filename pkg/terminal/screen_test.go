@@ -0,0 +1,158 @@
+package terminal
+
+import (
+	"strings"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// plainText returns the screen's content without any colours or cursor
+func plainText(s *Screen) string {
+	lines := make([]string, len(s.cells))
+	for y, line := range s.cells {
+		runes := make([]rune, len(line))
+		for x, cell := range line {
+			runes[x] = cell.Ch
+		}
+		lines[y] = strings.TrimRight(string(runes), " ")
+	}
+	return strings.Join(lines, "\n")
+}
+
+// TestScreenWrite is a function.
+func TestScreenWrite(t *testing.T) {
+	type scenario struct {
+		name     string
+		width    int
+		height   int
+		input    []string
+		expected string
+	}
+
+	scenarios := []scenario{
+		{
+			"plain lines",
+			10, 3,
+			[]string{"abc\r\ndef"},
+			"abc\ndef\n",
+		},
+		{
+			"scrolling off the top",
+			10, 2,
+			[]string{"one\r\ntwo\r\nthree"},
+			"two\nthree",
+		},
+		{
+			"wrapping at the last column",
+			3, 3,
+			[]string{"abcdef"},
+			"abc\ndef\n",
+		},
+		{
+			"utf8 split across writes",
+			10, 1,
+			[]string{"caf\xc3", "\xa9"},
+			"café",
+		},
+		{
+			"cursor movement and erasing",
+			10, 3,
+			[]string{"hello\r\nworld", "\x1b[1;2H\x1b[K", "\x1b[2;3H\x1b[1P"},
+			"h\nwold\n",
+		},
+		{
+			"clearing the screen",
+			10, 2,
+			[]string{"junk\r\njunk", "\x1b[H\x1b[2Jclean"},
+			"clean\n",
+		},
+		{
+			"titles and charsets are ignored",
+			10, 1,
+			[]string{"\x1b]0;my title\x07\x1b(Bok\x1b]2;other\x1b\\"},
+			"ok",
+		},
+		{
+			"backspace and tabs",
+			20, 1,
+			[]string{"ab\bc\tx"},
+			"ac      x",
+		},
+		{
+			"scroll region",
+			10, 4,
+			[]string{"top\r\na\r\nb\r\nbottom", "\x1b[2;3r\x1b[3;1H\nc"},
+			"top\nb\nc\nbottom",
+		},
+		{
+			"inserting and deleting lines",
+			10, 3,
+			[]string{"1\r\n2\r\n3", "\x1b[2;1H\x1b[L", "\x1b[1;1H\x1b[M"},
+			"\n2\n",
+		},
+		{
+			"newline mode",
+			10, 2,
+			[]string{"\x1b[20hone\ntwo", "\x1b[20l\nx"},
+			"two\n   x",
+		},
+		{
+			"alternate screen",
+			10, 2,
+			[]string{"shell$ ", "\x1b[?1049h\x1b[Hvi stuff", "\x1b[?1049l"},
+			"shell$\n",
+		},
+	}
+
+	for _, s := range scenarios {
+		t.Run(s.name, func(t *testing.T) {
+			screen := NewScreen(s.width, s.height)
+			for _, input := range s.input {
+				_, err := screen.Write([]byte(input))
+				assert.NoError(t, err)
+			}
+			assert.EqualValues(t, s.expected, plainText(screen))
+		})
+	}
+}
+
+// TestScreenGraphicsRendition is a function.
+func TestScreenGraphicsRendition(t *testing.T) {
+	screen := NewScreen(10, 1)
+	screen.Write([]byte("\x1b[1;31ma\x1b[0;92mb\x1b[38;5;21mc\x1b[48;2;255;255;0md\x1b[0m\x1b[?25l"))
+
+	cells := screen.cells[0]
+	assert.EqualValues(t, Attr{Fg: 1, Bg: -1, Bold: true}, cells[0].Attr)
+	assert.EqualValues(t, Attr{Fg: 2, Bg: -1, Bold: true}, cells[1].Attr)
+	assert.EqualValues(t, Attr{Fg: 4, Bg: -1, Bold: true}, cells[2].Attr)
+	assert.EqualValues(t, Attr{Fg: 4, Bg: 3, Bold: true}, cells[3].Attr)
+
+	assert.EqualValues(t, "\x1b[0;1;31ma\x1b[0;1;32mb\x1b[0;1;34mc\x1b[0;1;34;43md\x1b[0m", screen.Render())
+}
+
+// TestScreenRenderCursor is a function.
+func TestScreenRenderCursor(t *testing.T) {
+	screen := NewScreen(5, 2)
+	screen.Write([]byte("$ "))
+
+	assert.EqualValues(t, "$ \x1b[0;7m \x1b[0m\n", screen.Render())
+	assert.True(t, screen.TakeDirty())
+	assert.False(t, screen.TakeDirty())
+}
+
+// TestScreenResize is a function.
+func TestScreenResize(t *testing.T) {
+	screen := NewScreen(10, 3)
+	screen.Write([]byte("one\r\ntwo\r\nthree"))
+
+	// shrinking keeps the cursor's line on screen
+	screen.Resize(3, 2)
+	assert.EqualValues(t, "two\nthr", plainText(screen))
+
+	screen.Resize(6, 3)
+	width, height := screen.Size()
+	assert.EqualValues(t, 6, width)
+	assert.EqualValues(t, 3, height)
+	assert.EqualValues(t, "two\nthr\n", plainText(screen))
+}
@@ -0,0 +1,202 @@
+// Package tracing records spans of what lazydocker spends its time on, so that
+// a slow refresh can be broken down into time spent waiting on the daemon,
+// decoding, waiting on locks and drawing. Spans are written in Chrome's trace
+// event format, which chrome://tracing and https://ui.perfetto.dev can open
+package tracing
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"os"
+	"runtime"
+	"strconv"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// processID is the pid we give every event. There's only the one process, and
+// its real pid would just be noise
+const processID = 1
+
+// Tracer writes spans to a file. A nil Tracer records nothing, and starting
+// and ending a span with one costs next to nothing, so callers don't need to
+// check whether we're tracing
+type Tracer struct {
+	start time.Time
+
+	mutex  sync.Mutex
+	file   *os.File
+	writer *bufio.Writer
+	err    error
+
+	nextAsyncID uint64
+}
+
+// event is one entry in a trace event file. See
+// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+type event struct {
+	Name      string            `json:"name"`
+	Category  string            `json:"cat,omitempty"`
+	Phase     string            `json:"ph"`
+	Timestamp float64           `json:"ts"`
+	Duration  float64           `json:"dur,omitempty"`
+	ProcessID int               `json:"pid"`
+	ThreadID  uint64            `json:"tid"`
+	ID        uint64            `json:"id,omitempty"`
+	Args      map[string]string `json:"args,omitempty"`
+}
+
+// Open starts a trace in the file at path
+func Open(path string) (*Tracer, error) {
+	file, err := os.Create(path)
+	if err != nil {
+		return nil, err
+	}
+
+	t := &Tracer{start: time.Now(), file: file, writer: bufio.NewWriter(file)}
+	// the trace is a JSON array, which we close in Close. If we never get that
+	// far the viewers are happy to read it without the closing bracket
+	if _, err := t.writer.WriteString("[\n"); err != nil {
+		file.Close()
+		return nil, err
+	}
+	t.write(event{Name: "process_name", Phase: "M", ProcessID: processID, Args: map[string]string{"name": "lazydocker"}}, false)
+	return t, nil
+}
+
+// Span is something we're timing. The zero Span, which a nil Tracer hands
+// out, does nothing when it ends
+type Span struct {
+	tracer    *Tracer
+	category  string
+	name      string
+	start     time.Time
+	goroutine uint64
+	asyncID   uint64
+}
+
+// Start starts a span on the current goroutine. Spans on a goroutine must end
+// in the reverse order they started, like function calls; use StartAsync for
+// anything that outlives what started it
+func (t *Tracer) Start(category string, name string) Span {
+	if t == nil {
+		return Span{}
+	}
+	return Span{tracer: t, category: category, name: name, start: time.Now(), goroutine: goroutineID()}
+}
+
+// StartAsync starts a span that can end anywhere, e.g. on another goroutine
+// after the one that started it has moved on. These are shown apart from the
+// goroutine's other spans
+func (t *Tracer) StartAsync(category string, name string) Span {
+	if t == nil {
+		return Span{}
+	}
+	span := t.Start(category, name)
+	span.asyncID = atomic.AddUint64(&t.nextAsyncID, 1)
+	return span
+}
+
+// End records the span
+func (s Span) End() {
+	if s.tracer == nil {
+		return
+	}
+
+	end := time.Now()
+	t := s.tracer
+	if s.asyncID == 0 {
+		t.write(event{
+			Name:      s.name,
+			Category:  s.category,
+			Phase:     "X",
+			Timestamp: t.microseconds(s.start),
+			Duration:  float64(end.Sub(s.start)) / float64(time.Microsecond),
+			ProcessID: processID,
+			ThreadID:  s.goroutine,
+		}, true)
+		return
+	}
+
+	begin := event{
+		Name:      s.name,
+		Category:  s.category,
+		Phase:     "b",
+		Timestamp: t.microseconds(s.start),
+		ProcessID: processID,
+		ThreadID:  s.goroutine,
+		ID:        s.asyncID,
+	}
+	finish := begin
+	finish.Phase = "e"
+	finish.Timestamp = t.microseconds(end)
+	t.write(begin, true)
+	t.write(finish, true)
+}
+
+func (t *Tracer) microseconds(at time.Time) float64 {
+	return float64(at.Sub(t.start)) / float64(time.Microsecond)
+}
+
+func (t *Tracer) write(e event, separate bool) {
+	data, err := json.Marshal(e)
+
+	t.mutex.Lock()
+	defer t.mutex.Unlock()
+
+	if t.err != nil || t.writer == nil {
+		return
+	}
+	if err != nil {
+		t.err = err
+		return
+	}
+	if separate {
+		t.writer.WriteString(",\n")
+	}
+	_, t.err = t.writer.Write(data)
+}
+
+// Close finishes the trace. Spans that end after this aren't recorded
+func (t *Tracer) Close() error {
+	if t == nil {
+		return nil
+	}
+
+	t.mutex.Lock()
+	defer t.mutex.Unlock()
+
+	if t.writer == nil {
+		return nil
+	}
+	if t.err == nil {
+		_, t.err = t.writer.WriteString("\n]\n")
+	}
+	if t.err == nil {
+		t.err = t.writer.Flush()
+	}
+	t.writer = nil
+
+	if err := t.file.Close(); t.err == nil {
+		t.err = err
+	}
+	return t.err
+}
+
+// goroutineID returns the ID of the current goroutine, which we use as the
+// thread ID of its spans so that they stack up the way its calls do. Go
+// doesn't want us to know it, so we read it off the top of our stack trace:
+// 'goroutine 123 [running]:'. It takes a microsecond or so, which is fine
+// when we're tracing
+func goroutineID() uint64 {
+	buf := make([]byte, 32)
+	buf = buf[:runtime.Stack(buf, false)]
+	buf = bytes.TrimPrefix(buf, []byte("goroutine "))
+	if i := bytes.IndexByte(buf, ' '); i >= 0 {
+		buf = buf[:i]
+	}
+	id, _ := strconv.ParseUint(string(buf), 10, 64)
+	return id
+}
@@ -0,0 +1,77 @@
+package tracing
+
+import (
+	"encoding/json"
+	"io/ioutil"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestTracer is a function.
+func TestTracer(t *testing.T) {
+	dir, err := ioutil.TempDir("", "lazydocker-tracing")
+	assert.NoError(t, err)
+	defer os.RemoveAll(dir)
+
+	path := filepath.Join(dir, "spans.json")
+	tracer, err := Open(path)
+	assert.NoError(t, err)
+
+	outer := tracer.Start("refresh", "containers")
+	inner := tracer.Start("daemon", "waiting on daemon")
+	inner.End()
+	async := tracer.StartAsync("render", "wait for main loop")
+	outer.End()
+	done := make(chan struct{})
+	go func() {
+		async.End()
+		close(done)
+	}()
+	<-done
+
+	assert.NoError(t, tracer.Close())
+	// spans ending after we've closed are dropped
+	tracer.Start("refresh", "late").End()
+
+	data, err := ioutil.ReadFile(path)
+	assert.NoError(t, err)
+	events := []event{}
+	assert.NoError(t, json.Unmarshal(data, &events))
+
+	type scenario struct {
+		name  string
+		phase string
+	}
+	expected := []scenario{
+		{"process_name", "M"},
+		{"waiting on daemon", "X"},
+		{"containers", "X"},
+		{"wait for main loop", "b"},
+		{"wait for main loop", "e"},
+	}
+	actual := make([]scenario, len(events))
+	for i, e := range events {
+		actual[i] = scenario{e.Name, e.Phase}
+	}
+	assert.EqualValues(t, expected, actual)
+
+	// everything started on this goroutine, wherever it ended
+	for _, e := range events[1:] {
+		assert.EqualValues(t, events[1].ThreadID, e.ThreadID)
+		assert.NotZero(t, e.ThreadID)
+	}
+	assert.True(t, events[2].Timestamp <= events[1].Timestamp)
+	assert.True(t, events[2].Duration >= events[1].Duration)
+	assert.EqualValues(t, events[3].ID, events[4].ID)
+}
+
+// TestNilTracer is a function.
+func TestNilTracer(t *testing.T) {
+	var tracer *Tracer
+	tracer.Start("refresh", "containers").End()
+	tracer.StartAsync("render", "wait for main loop").End()
+	assert.NoError(t, tracer.Close())
+}
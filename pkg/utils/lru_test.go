@@ -0,0 +1,33 @@
+package utils
+
+import (
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestLRU is a function.
+func TestLRU(t *testing.T) {
+	cache := NewLRU(2)
+	cache.Add("a", 1)
+	cache.Add("b", 2)
+
+	// using 'a' means 'b' is now the least recently used
+	value, ok := cache.Get("a")
+	assert.True(t, ok)
+	assert.EqualValues(t, 1, value)
+
+	cache.Add("c", 3)
+	assert.False(t, cache.Contains("b"))
+	assert.True(t, cache.Contains("a"))
+	assert.True(t, cache.Contains("c"))
+	assert.EqualValues(t, 2, cache.Len())
+
+	cache.Add("a", 4)
+	value, _ = cache.Get("a")
+	assert.EqualValues(t, 4, value)
+	assert.EqualValues(t, 2, cache.Len())
+
+	_, ok = cache.Get("b")
+	assert.False(t, ok)
+}
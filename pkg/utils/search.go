@@ -0,0 +1,137 @@
+package utils
+
+import (
+	"sort"
+	"strings"
+	"unicode/utf8"
+)
+
+// SearchRow is what we match a row of a list against: fields like its name and
+// image, and its labels. It's lowercased once up front
+type SearchRow struct {
+	fields []string
+	labels []string
+}
+
+// NewSearchRow returns a SearchRow for the given fields and labels. Labels are
+// sorted so that the result doesn't depend on map order
+func NewSearchRow(fields []string, labels map[string]string) SearchRow {
+	row := SearchRow{
+		fields: make([]string, 0, len(fields)),
+		labels: make([]string, 0, len(labels)),
+	}
+	for _, field := range fields {
+		if field != "" {
+			row.fields = append(row.fields, strings.ToLower(field))
+		}
+	}
+	for key, value := range labels {
+		row.labels = append(row.labels, strings.ToLower(key+"="+value))
+	}
+	sort.Strings(row.labels)
+	return row
+}
+
+// matches tells us whether a single term of a query matches the row. Terms
+// are fuzzy-matched within a field, but have to appear in a label as is:
+// compose labels carry long hashes and paths, which a few scattered letters
+// would match in just about every container
+func (r SearchRow) matches(term string) bool {
+	for _, field := range r.fields {
+		if fuzzyContains(field, term) {
+			return true
+		}
+	}
+	for _, label := range r.labels {
+		if strings.Contains(label, term) {
+			return true
+		}
+	}
+	return false
+}
+
+// SearchIndex fuzzy-filters a list of rows by a query. Lists get refreshed
+// many times a second, so it holds on to each row by a key, and only builds a
+// row again when its key changes. It also remembers which query each row last
+// matched or didn't: when a query just extends that one (i.e. the user has
+// typed another character) a row that didn't match can't match now either
+type SearchIndex struct {
+	rows map[string]*indexedRow
+}
+
+type indexedRow struct {
+	row     SearchRow
+	checked bool
+	query   string
+	matched bool
+}
+
+// NewSearchIndex returns an empty SearchIndex
+func NewSearchIndex() *SearchIndex {
+	return &SearchIndex{rows: map[string]*indexedRow{}}
+}
+
+// Filter returns the indices of the rows which match the query, in order. key
+// returns something that identifies the i'th row along with everything we
+// search through in it, and row returns what to search through, which we only
+// ask for if we haven't seen the key before. A row matches if each of the
+// query's space-separated terms appears in one of its fields with its
+// characters in order, though not necessarily next to each other, so 'wbprd'
+// matches 'web-prod', or appears as is in one of its labels. Matching ignores
+// case
+func (x *SearchIndex) Filter(query string, count int, key func(int) string, row func(int) SearchRow) []int {
+	query = strings.ToLower(query)
+	terms := strings.Fields(query)
+
+	// rows that have gone since last time are dropped
+	rows := make(map[string]*indexedRow, count)
+	matches := make([]int, 0, count)
+	for i := 0; i < count; i++ {
+		k := key(i)
+		indexed, ok := x.rows[k]
+		if !ok {
+			indexed = &indexedRow{row: row(i)}
+		}
+		rows[k] = indexed
+
+		switch {
+		case indexed.checked && indexed.query == query:
+		case indexed.checked && !indexed.matched && strings.HasPrefix(query, indexed.query):
+			// it didn't match a shorter version of this query, so it can't match
+			// this one
+			indexed.query = query
+		default:
+			indexed.matched = matchesTerms(indexed.row, terms)
+			indexed.query = query
+			indexed.checked = true
+		}
+		if indexed.matched {
+			matches = append(matches, i)
+		}
+	}
+
+	x.rows = rows
+	return matches
+}
+
+func matchesTerms(row SearchRow, terms []string) bool {
+	for _, term := range terms {
+		if !row.matches(term) {
+			return false
+		}
+	}
+	return true
+}
+
+// fuzzyContains tells us whether each of needle's characters appears in
+// haystack, in order
+func fuzzyContains(haystack string, needle string) bool {
+	for _, r := range needle {
+		i := strings.IndexRune(haystack, r)
+		if i == -1 {
+			return false
+		}
+		haystack = haystack[i+utf8.RuneLen(r):]
+	}
+	return true
+}
@@ -0,0 +1,100 @@
+package utils
+
+import (
+	"fmt"
+	"testing"
+
+	"github.com/stretchr/testify/assert"
+)
+
+// TestSearchIndexFilter is a function.
+func TestSearchIndexFilter(t *testing.T) {
+	type scenario struct {
+		query    string
+		expected []int
+	}
+
+	// compose's own labels, which every container in a project has
+	composeLabels := func(service string) map[string]string {
+		return map[string]string{
+			"com.docker.compose.config-hash":          "9f2c7a4e1b3d5f60718293a4b5c6d7e8f9012a3b4c5d6e7f8091a2b3c4d5e6f7",
+			"com.docker.compose.container-number":     "1",
+			"com.docker.compose.oneoff":               "False",
+			"com.docker.compose.project":              "shop",
+			"com.docker.compose.project.config_files": "/home/dev/src/shop/docker-compose.yml",
+			"com.docker.compose.project.working_dir":  "/home/dev/src/shop",
+			"com.docker.compose.service":              service,
+			"com.docker.compose.version":              "2.20.2",
+		}
+	}
+
+	rows := []SearchRow{
+		NewSearchRow([]string{"web-prod", "nginx:latest"}, nil),
+		NewSearchRow([]string{"Worker-Prod", "myapp:1.2"}, nil),
+		NewSearchRow([]string{"db", "postgres:11"}, nil),
+		NewSearchRow([]string{"web-staging", "nginx:latest"}, nil),
+		NewSearchRow([]string{"shop_api_1", "shop_api", "api"}, composeLabels("api")),
+		NewSearchRow([]string{"shop_cache_1", "redis:7", "cache"}, composeLabels("cache")),
+	}
+	index := NewSearchIndex()
+
+	// each of these runs on the same index, so the ones that extend the
+	// previous query only look through what matched last time
+	scenarios := []scenario{
+		{"", []int{0, 1, 2, 3, 4, 5}},
+		{"w", []int{0, 1, 3, 4, 5}},
+		{"wp", []int{0, 1}},
+		{"wprd", []int{0, 1}},
+		{"wprd ng", []int{0}},
+		{"wprd ngz", []int{}},
+		{"web", []int{0, 3}},
+		{"WEB STAG", []int{3}},
+		{"postgres", []int{2}},
+		// the letters are all somewhere in the api container's labels, but we
+		// don't fuzzy-match across them
+		{"redis", []int{5}},
+		{"service=api", []int{4}},
+		{"shop", []int{4, 5}},
+		{"  ", []int{0, 1, 2, 3, 4, 5}},
+	}
+
+	for _, s := range scenarios {
+		matches := index.Filter(s.query, len(rows), func(i int) string { return fmt.Sprint(i) }, func(i int) SearchRow { return rows[i] })
+		assert.EqualValues(t, s.expected, matches, s.query)
+	}
+}
+
+// TestSearchIndexRefresh is a function.
+func TestSearchIndexRefresh(t *testing.T) {
+	built := []string{}
+	filter := func(index *SearchIndex, query string, names []string) []int {
+		return index.Filter(query, len(names), func(i int) string { return names[i] }, func(i int) SearchRow {
+			built = append(built, names[i])
+			return NewSearchRow([]string{names[i]}, nil)
+		})
+	}
+
+	index := NewSearchIndex()
+	assert.EqualValues(t, []int{0, 2}, filter(index, "web", []string{"web-1", "db", "web-2"}))
+	assert.EqualValues(t, []string{"web-1", "db", "web-2"}, built)
+
+	// a refresh with a new row and a different order only builds the new row
+	assert.EqualValues(t, []int{0, 1, 3}, filter(index, "web", []string{"web-2", "web-3", "db", "web-1"}))
+	assert.EqualValues(t, []string{"web-1", "db", "web-2", "web-3"}, built)
+
+	// extending the query carries on from what matched last time, including the
+	// new row
+	assert.EqualValues(t, []int{1}, filter(index, "web-3", []string{"web-2", "web-3", "db", "web-1"}))
+
+	// rows that have gone are forgotten, so they're built again if they come back
+	assert.EqualValues(t, []int{}, filter(index, "web-3", []string{"db"}))
+	assert.EqualValues(t, []int{0}, filter(index, "web-3", []string{"web-3"}))
+	assert.EqualValues(t, []string{"web-1", "db", "web-2", "web-3", "web-3"}, built)
+}
+
+// TestNewSearchRow is a function.
+func TestNewSearchRow(t *testing.T) {
+	row := NewSearchRow([]string{"Web", "", "nginx"}, map[string]string{"b": "2", "A": "1"})
+	assert.EqualValues(t, SearchRow{fields: []string{"web", "nginx"}, labels: []string{"a=1", "b=2"}}, row)
+	assert.EqualValues(t, SearchRow{fields: []string{}, labels: []string{}}, NewSearchRow(nil, nil))
+}
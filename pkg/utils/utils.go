@@ -9,6 +9,7 @@ import (
 	"regexp"
 	"sort"
 	"strings"
+	"sync"
 	"time"
 
 	"github.com/go-errors/errors"
@@ -97,6 +98,14 @@ func Max(x, y int) int {
 	return y
 }
 
+// Min returns the minimum of two integers
+func Min(x, y int) int {
+	if x < y {
+		return x
+	}
+	return y
+}
+
 type Displayable interface {
 	GetDisplayStrings(bool) []string
 }
@@ -104,6 +113,7 @@ type Displayable interface {
 type RenderListConfig struct {
 	IsFocused bool
 	Header    []string
+	IsMarked  func(int) bool
 }
 
 func IsFocused(isFocused bool) func(c *RenderListConfig) {
@@ -118,6 +128,14 @@ func WithHeader(header []string) func(c *RenderListConfig) {
 	}
 }
 
+// WithMarkedLines adds a leading column to the list which shows a marker
+// against each item for which isMarked returns true
+func WithMarkedLines(isMarked func(int) bool) func(c *RenderListConfig) {
+	return func(c *RenderListConfig) {
+		c.IsMarked = isMarked
+	}
+}
+
 // RenderList takes a slice of items, confirms they implement the Displayable
 // interface, then generates a list of their displaystrings to write to a panel's
 // buffer
@@ -155,8 +173,21 @@ func renderDisplayableList(items []Displayable, config RenderListConfig) (string
 	}
 
 	stringArrays := getDisplayStringArrays(items, config.IsFocused)
+	if config.IsMarked != nil {
+		for i, stringArray := range stringArrays {
+			marker := " "
+			if config.IsMarked(i) {
+				marker = ColoredString("*", color.FgCyan)
+			}
+			stringArrays[i] = append([]string{marker}, stringArray...)
+		}
+	}
 	if len(config.Header) > 0 {
-		stringArrays = append([][]string{config.Header}, stringArrays...)
+		header := config.Header
+		if config.IsMarked != nil {
+			header = append([]string{""}, header...)
+		}
+		stringArrays = append([][]string{header}, stringArrays...)
 	}
 
 	return RenderTable(stringArrays)
@@ -229,6 +260,77 @@ func getDisplayStringArrays(displayables []Displayable, isFocused bool) [][]stri
 	return stringArrays
 }
 
+// ForEachConcurrently calls f once for each index from 0 to count-1, running at
+// most limit calls at a time. It waits for every call to return and then
+// returns their errors joined together, or nil if every call succeeded
+func ForEachConcurrently(count int, limit int, f func(int) error) error {
+	if limit < 1 {
+		limit = 1
+	}
+
+	errs := make([]error, count)
+	semaphore := make(chan struct{}, limit)
+	wg := sync.WaitGroup{}
+	wg.Add(count)
+
+	for i := 0; i < count; i++ {
+		semaphore <- struct{}{}
+		go func(i int) {
+			defer func() {
+				<-semaphore
+				wg.Done()
+			}()
+			errs[i] = f(i)
+		}(i)
+	}
+
+	wg.Wait()
+
+	messages := []string{}
+	for _, err := range errs {
+		if err != nil {
+			messages = append(messages, strings.TrimSpace(err.Error()))
+		}
+	}
+	if len(messages) > 0 {
+		return errors.New(strings.Join(messages, "\n"))
+	}
+	return nil
+}
+
+// IncludesString returns true if the list contains the given string
+func IncludesString(list []string, str string) bool {
+	for _, item := range list {
+		if item == str {
+			return true
+		}
+	}
+	return false
+}
+
+// ProgressBar renders a progress bar like [=====>    ] of the given width
+// (including the brackets), filled in proportion to current/total
+func ProgressBar(current int64, total int64, width int) string {
+	inner := width - 2
+	if inner < 1 {
+		return ""
+	}
+
+	filled := inner
+	if total > 0 && current < total {
+		filled = int(float64(inner) * float64(current) / float64(total))
+	}
+	if filled < 0 {
+		filled = 0
+	}
+
+	bar := strings.Repeat("=", filled)
+	if filled < inner {
+		bar += ">" + strings.Repeat(" ", inner-filled-1)
+	}
+	return "[" + bar + "]"
+}
+
 func FormatBinaryBytes(b int) string {
 	n := float64(b)
 	units := []string{"B", "kiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB"}
@@ -246,6 +348,13 @@ func FormatBinaryBytes(b int) string {
 	return "a lot"
 }
 
+// FormatMilliseconds shows a duration in milliseconds, e.g. '12.3ms'. Using
+// the one unit lines durations up in a table, which pads by bytes rather than
+// by the width of 'µ'
+func FormatMilliseconds(d time.Duration) string {
+	return fmt.Sprintf("%.1fms", float64(d)/float64(time.Millisecond))
+}
+
 func FormatDecimalBytes(b int) string {
 	n := float64(b)
 	units := []string{"B", "kB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB"}
@@ -263,12 +372,34 @@ func FormatDecimalBytes(b int) string {
 	return "a lot"
 }
 
+// ApplyTemplate resolves a go template string against the given object
 func ApplyTemplate(str string, object interface{}) string {
 	var buf bytes.Buffer
-	template.Must(template.New("").Parse(str)).Execute(&buf, object)
+	parsedTemplate(str).Execute(&buf, object)
 	return buf.String()
 }
 
+// templateCache holds our parsed templates. We apply the same templates (e.g.
+// the logs command) every time the user selects something, so we only want to
+// parse each of them once. Executing a parsed template concurrently is safe.
+var templateCache = struct {
+	sync.Mutex
+	templates map[string]*template.Template
+}{templates: map[string]*template.Template{}}
+
+func parsedTemplate(str string) *template.Template {
+	templateCache.Lock()
+	defer templateCache.Unlock()
+
+	if tmpl, ok := templateCache.templates[str]; ok {
+		return tmpl
+	}
+
+	tmpl := template.Must(template.New("").Parse(str))
+	templateCache.templates[str] = tmpl
+	return tmpl
+}
+
 // GetGocuiAttribute gets the gocui color attribute from the string
 func GetGocuiAttribute(key string) gocui.Attribute {
 	colorMap := map[string]gocui.Attribute{
@@ -1,8 +1,12 @@
 package utils
 
 import (
+	"fmt"
+	"sync"
 	"testing"
+	"time"
 
+	"github.com/fatih/color"
 	"github.com/stretchr/testify/assert"
 )
 
@@ -380,3 +384,192 @@ func TestGetPadWidths(t *testing.T) {
 		assert.EqualValues(t, s.expected, getPadWidths(s.stringArrays))
 	}
 }
+
+// TestRenderDisplayableListWithMarkedLines is a function.
+func TestRenderDisplayableListWithMarkedLines(t *testing.T) {
+	items := []Displayable{
+		Displayable(&myDisplayable{[]string{"a"}}),
+		Displayable(&myDisplayable{[]string{"b"}}),
+	}
+	config := RenderListConfig{IsMarked: func(i int) bool { return i == 1 }}
+
+	str, err := renderDisplayableList(items, config)
+	assert.NoError(t, err)
+	assert.EqualValues(t, "  a\n* b", Decolorise(str))
+}
+
+// TestForEachConcurrently is a function.
+func TestForEachConcurrently(t *testing.T) {
+	type scenario struct {
+		count                int
+		limit                int
+		failing              map[int]bool
+		expectedErrorMessage string
+	}
+
+	scenarios := []scenario{
+		{0, 2, map[int]bool{}, ""},
+		{5, 2, map[int]bool{}, ""},
+		{5, 0, map[int]bool{}, ""},
+		{4, 3, map[int]bool{1: true, 3: true}, "failed 1\nfailed 3"},
+	}
+
+	for _, s := range scenarios {
+		var mutex sync.Mutex
+		running := 0
+		maxRunning := 0
+		called := make([]bool, s.count)
+
+		err := ForEachConcurrently(s.count, s.limit, func(i int) error {
+			mutex.Lock()
+			running++
+			if running > maxRunning {
+				maxRunning = running
+			}
+			called[i] = true
+			mutex.Unlock()
+
+			time.Sleep(time.Millisecond)
+
+			mutex.Lock()
+			running--
+			mutex.Unlock()
+
+			if s.failing[i] {
+				return fmt.Errorf("failed %d", i)
+			}
+			return nil
+		})
+
+		for _, wasCalled := range called {
+			assert.True(t, wasCalled)
+		}
+		limit := s.limit
+		if limit < 1 {
+			limit = 1
+		}
+		assert.True(t, maxRunning <= limit)
+		if s.expectedErrorMessage != "" {
+			assert.EqualError(t, err, s.expectedErrorMessage)
+		} else {
+			assert.NoError(t, err)
+		}
+	}
+}
+
+// TestProgressBar is a function.
+func TestProgressBar(t *testing.T) {
+	type scenario struct {
+		current  int64
+		total    int64
+		width    int
+		expected string
+	}
+
+	scenarios := []scenario{
+		{0, 100, 12, "[>         ]"},
+		{50, 100, 12, "[=====>    ]"},
+		{100, 100, 12, "[==========]"},
+		{150, 100, 12, "[==========]"},
+		{5, 0, 5, "[===]"},
+		{1, 2, 2, ""},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, ProgressBar(s.current, s.total, s.width))
+	}
+}
+
+// TestFormatMilliseconds is a function.
+func TestFormatMilliseconds(t *testing.T) {
+	type scenario struct {
+		duration time.Duration
+		expected string
+	}
+
+	scenarios := []scenario{
+		{0, "0.0ms"},
+		{250 * time.Microsecond, "0.2ms"},
+		{12345 * time.Microsecond, "12.3ms"},
+		{2 * time.Second, "2000.0ms"},
+	}
+
+	for _, s := range scenarios {
+		assert.EqualValues(t, s.expected, FormatMilliseconds(s.duration))
+	}
+}
+
+// benchmarkSizes are the list lengths we benchmark against, from a laptop to a
+// busy build host
+var benchmarkSizes = []int{10, 100, 1000, 10000}
+
+// benchmarkRows returns rows shaped like the containers panel's, with a
+// coloured status column
+func benchmarkRows(count int) []*myDisplayable {
+	rows := make([]*myDisplayable, count)
+	for i := range rows {
+		rows[i] = &myDisplayable{[]string{
+			ColoredString("running", color.FgGreen),
+			fmt.Sprintf("project_service-%d_1", i),
+			fmt.Sprintf("%d.%02d%%", i%100, i%7),
+		}}
+	}
+	return rows
+}
+
+// BenchmarkRenderList is a function.
+func BenchmarkRenderList(b *testing.B) {
+	for _, size := range benchmarkSizes {
+		b.Run(fmt.Sprintf("%d rows", size), func(b *testing.B) {
+			rows := benchmarkRows(size)
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := RenderList(rows, IsFocused(true)); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkRenderTable is a function.
+func BenchmarkRenderTable(b *testing.B) {
+	for _, size := range benchmarkSizes {
+		b.Run(fmt.Sprintf("%d rows", size), func(b *testing.B) {
+			rows := benchmarkRows(size)
+			table := make([][]string, len(rows))
+			for i, row := range rows {
+				table[i] = row.strings
+			}
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				if _, err := RenderTable(table); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkDecolorise is a function.
+func BenchmarkDecolorise(b *testing.B) {
+	type scenario struct {
+		name string
+		str  string
+	}
+
+	scenarios := []scenario{
+		{"plain", "project_service-1_1"},
+		{"coloured", ColoredString("running", color.FgGreen)},
+		{"log line", ColoredString("2019-07-02T11:21:32Z", color.FgBlue) + " level=info msg=\"handled request\" " + ColoredString("200", color.FgGreen)},
+	}
+
+	for _, s := range scenarios {
+		b.Run(s.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				Decolorise(s.str)
+			}
+		})
+	}
+}
@@ -33,7 +33,7 @@ func main() {
 
 	for lang := range i18n.GetTranslationSets() {
 		os.Setenv("LC_ALL", lang)
-		mApp, _ := app.NewApp(mConfig)
+		mApp, _ := app.NewApp(mConfig, nil)
 		file, err := os.Create("./docs/keybindings/Keybindings_" + lang + ".md")
 		if err != nil {
 			panic(err)
@@ -81,6 +81,7 @@ func getBindingSections(mApp *app.App) []*bindingSection {
 			"containers": mApp.Tr.ContainersTitle,
 			"images":     mApp.Tr.ImagesTitle,
 			"volumes":    mApp.Tr.VolumesTitle,
+			"terminal":   mApp.Tr.TerminalTitle,
 		}
 
 		bindingSections = addBinding(titleMap[viewName], bindingSections, binding)
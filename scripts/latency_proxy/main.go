@@ -0,0 +1,82 @@
+// This "script" puts a docker socket behind a TCP proxy that delays everything
+// passing through it, so that you can see how lazydocker behaves against a
+// remote daemon without having one.
+//
+// To give the daemon an 80ms round trip:
+//   go run scripts/latency_proxy/main.go -delay 40ms
+//   DOCKER_HOST=tcp://127.0.0.1:2375 lazydocker
+
+package main
+
+import (
+	"flag"
+	"log"
+	"net"
+	"time"
+)
+
+type chunk struct {
+	data []byte
+	at   time.Time
+}
+
+func main() {
+	listen := flag.String("listen", "127.0.0.1:2375", "address to listen on")
+	target := flag.String("target", "/var/run/docker.sock", "docker socket to forward to")
+	delay := flag.Duration("delay", 40*time.Millisecond, "delay in each direction")
+	flag.Parse()
+
+	listener, err := net.Listen("tcp", *listen)
+	if err != nil {
+		log.Fatal(err)
+	}
+	log.Printf("forwarding %s to %s with %s each way", *listen, *target, *delay)
+
+	for {
+		client, err := listener.Accept()
+		if err != nil {
+			log.Fatal(err)
+		}
+		go func() {
+			daemon, err := net.Dial("unix", *target)
+			if err != nil {
+				log.Println(err)
+				client.Close()
+				return
+			}
+			go pipe(daemon, client, *delay)
+			pipe(client, daemon, *delay)
+		}()
+	}
+}
+
+// pipe copies from src to dst, holding on to each chunk until delay has passed
+// since we read it. Chunks read in the meantime queue up behind it, so we add
+// latency without limiting throughput
+func pipe(dst net.Conn, src net.Conn, delay time.Duration) {
+	defer dst.Close()
+
+	chunks := make(chan chunk, 1024)
+	go func() {
+		defer close(chunks)
+		for {
+			buf := make([]byte, 32*1024)
+			n, err := src.Read(buf)
+			if n > 0 {
+				chunks <- chunk{data: buf[:n], at: time.Now()}
+			}
+			// the connection closing is the only way this ends, so there's
+			// nothing to report
+			if err != nil {
+				return
+			}
+		}
+	}()
+
+	for c := range chunks {
+		time.Sleep(time.Until(c.at.Add(delay)))
+		if _, err := dst.Write(c.data); err != nil {
+			return
+		}
+	}
+}
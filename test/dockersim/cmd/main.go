@@ -0,0 +1,53 @@
+// This runs the docker API simulator on a unix socket so that you can point
+// lazydocker (or the docker CLI) at a fleet of fake containers.
+//
+// To see how lazydocker copes with a thousand containers coming and going on
+// a daemon with a 50ms round trip:
+//   go run test/dockersim/cmd/main.go -containers 1000 -churn 500ms -latency 50ms
+//   DOCKER_HOST=unix:///tmp/dockersim.sock lazydocker
+
+package main
+
+import (
+	"flag"
+	"log"
+	"os"
+	"os/signal"
+
+	"github.com/jesseduffield/lazydocker/pkg/dockersim"
+)
+
+func main() {
+	defaults := dockersim.DefaultOptions()
+
+	socket := flag.String("socket", "/tmp/dockersim.sock", "unix socket to serve the API on")
+	containers := flag.Int("containers", defaults.Containers, "number of containers")
+	images := flag.Int("images", defaults.Images, "number of images")
+	volumes := flag.Int("volumes", defaults.Volumes, "number of volumes")
+	churn := flag.Duration("churn", defaults.ChurnInterval, "how often to replace a container (0 for never)")
+	logRate := flag.Int("log-rate", defaults.LogLinesPerSecond, "log lines per second for followed logs")
+	latency := flag.Duration("latency", defaults.Latency, "delay before answering each request")
+	seed := flag.Int64("seed", defaults.Seed, "random seed")
+	flag.Parse()
+
+	sim := dockersim.New(dockersim.Options{
+		Containers:        *containers,
+		Images:            *images,
+		Volumes:           *volumes,
+		ChurnInterval:     *churn,
+		LogLinesPerSecond: *logRate,
+		Latency:           *latency,
+		Seed:              *seed,
+	})
+	if err := sim.Start(*socket); err != nil {
+		log.Fatal(err)
+	}
+	log.Printf("serving %d containers on %s", *containers, sim.Host())
+
+	interrupt := make(chan os.Signal, 1)
+	signal.Notify(interrupt, os.Interrupt)
+	<-interrupt
+
+	sim.Close()
+	os.Remove(*socket)
+}